@@ -0,0 +1,358 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <sirius/arith/affine2.hpp>
+#include <sirius/arith/expression.hpp>
+#include <sirius/arith/math.hpp>
+#include <sirius/arith/matrix.hpp>
+#include <sirius/arith/packed.hpp>
+#include <sirius/arith/point.hpp>
+#include <sirius/arith/quaternion.hpp>
+#include <sirius/arith/quaternion_batch.hpp>
+#include <sirius/arith/rect.hpp>
+#include <sirius/arith/rect_batch.hpp>
+#include <sirius/arith/rect_tree.hpp>
+#include <sirius/arith/vector.hpp>
+#include <sirius/arith/vector_batch.hpp>
+
+#include "bench_harness.hpp"
+
+
+//Benchmarks every arith operator family, in scalar form (one value at a time, over an array of structs) and batch form
+//(the span/SoA kernels), so that the two can be compared directly. Names are <family>/<operation>/<element type><dims>/<form>
+namespace {
+    constexpr std::size_t count = 1 << 12;
+
+    template<typename T>
+    std::string type_tag() {
+        if constexpr(std::is_same_v<T, float>) return "f32";
+        else if constexpr(std::is_same_v<T, double>) return "f64";
+        else return "i32";
+    }
+
+    template<typename T, std::size_t Dims>
+    std::string tag(char const* form) { return "/" + type_tag<T>() + (Dims > 1 ? "x" + std::to_string(Dims) : "") + "/" + form; }
+
+    //Deterministic, non-zero and well within range for every element type
+    template<typename T>
+    T value(std::size_t i, std::size_t salt = 0) {
+        if constexpr(std::is_floating_point_v<T>) return static_cast<T>((i * 7 + salt * 13) % 97) * static_cast<T>(.25) + static_cast<T>(.5);
+        else return static_cast<T>((i * 7 + salt * 13) % 97 + 1);
+    }
+
+    template<typename V>
+    std::vector<V> make_values(std::size_t salt) {
+        std::vector<V> ret(count);
+        for(std::size_t i = 0; i < count; ++i)
+            for(std::size_t c = 0; c < ret[i].size(); ++c)
+                ret[i][c] = value<std::remove_cvref_t<decltype(ret[i][c])>>(i + c, salt);
+        return ret;
+    }
+
+    template<typename T>
+    void done(std::vector<T>& out) {
+        bench::do_not_optimize(out.data());
+        bench::clobber_memory();
+    }
+}
+
+
+namespace {
+    template<std::size_t Dims, typename T>
+    void bench_vector(bench::suite& s) {
+        using V = acma::vector<Dims, T>;
+        const std::vector<V> a = make_values<V>(1), b = make_values<V>(2);
+        std::vector<V> out(count);
+        std::vector<T> scalars(count);
+        const std::string scalar = tag<T, Dims>("scalar");
+        constexpr std::size_t binary_bytes = 3 * sizeof(V), unary_bytes = 2 * sizeof(V);
+
+        s.run("vector/add" + scalar, count, binary_bytes, [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = a[i] + b[i]; done(out); });
+        s.run("vector/sub" + scalar, count, binary_bytes, [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = a[i] - b[i]; done(out); });
+        s.run("vector/mul" + scalar, count, binary_bytes, [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = a[i] * b[i]; done(out); });
+        s.run("vector/div" + scalar, count, binary_bytes, [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = a[i] / b[i]; done(out); });
+        s.run("vector/mul_scalar" + scalar, count, unary_bytes, [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = a[i] * static_cast<T>(3); done(out); });
+        s.run("vector/add_assign" + scalar, count, unary_bytes, [&]{ for(std::size_t i = 0; i < count; ++i) { out[i] = b[i]; out[i] += a[i]; } done(out); });
+        s.run("vector/negate" + scalar, count, unary_bytes, [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = -a[i]; done(out); });
+        s.run("vector/dot" + scalar, count, 2 * sizeof(V) + sizeof(T), [&]{ for(std::size_t i = 0; i < count; ++i) scalars[i] = acma::dot(a[i], b[i]); done(scalars); });
+        //Eager operators materialize a temporary per operator, lazy fuses the whole chain
+        s.run("vector/chain_eager" + scalar, count, binary_bytes, [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = (a[i] * static_cast<T>(2) - b[i]) / a[i] + static_cast<T>(1); done(out); });
+        s.run("vector/chain_lazy" + scalar, count, binary_bytes, [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = (acma::lazy(a[i]) * static_cast<T>(2) - b[i]) / a[i] + static_cast<T>(1); done(out); });
+
+        if constexpr(Dims == 2 || Dims == 3) {
+            if constexpr(Dims == 2) s.run("vector/cross" + scalar, count, 2 * sizeof(V) + sizeof(T), [&]{ for(std::size_t i = 0; i < count; ++i) scalars[i] = acma::cross(a[i], b[i]); done(scalars); });
+            else s.run("vector/cross" + scalar, count, binary_bytes, [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = acma::cross(a[i], b[i]); done(out); });
+        }
+        if constexpr(std::is_floating_point_v<T>) {
+            s.run("vector/normalize_std" + scalar, count, unary_bytes, [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = acma::normalized(a[i], acma::math::sqrt); done(out); });
+            s.run("vector/normalize_fast" + scalar, count, unary_bytes, [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = acma::normalized(a[i], acma::math::fast::sqrt); done(out); });
+        }
+    }
+
+
+    template<std::size_t Dims, typename T>
+    void bench_vector_batch(bench::suite& s) {
+        using V = acma::vector<Dims, T>;
+        const std::vector<V> src = make_values<V>(3);
+        acma::point_batch<Dims, T> batch{std::span<V const>{src}};
+        const std::string form = tag<T, Dims>("batch");
+        constexpr std::size_t bytes = 2 * sizeof(V);
+
+        //Every repeated transform alternates with its inverse (and normalize to an extent of 2 just subtracts 1), so that the values stay
+        //finite however many calls a sample makes
+        std::array<acma::matrix<Dims, Dims, T>, 2> linear{acma::matrix<Dims, Dims, T>::identity(), acma::matrix<Dims, Dims, T>::identity()};
+        std::array<acma::matrix<Dims + 1, Dims + 1, T>, 2> homogeneous{acma::matrix<Dims + 1, Dims + 1, T>::identity(), acma::matrix<Dims + 1, Dims + 1, T>::identity()};
+        linear[0][0][1] = static_cast<T>(.5);
+        linear[1][0][1] = static_cast<T>(-.5);
+        homogeneous[0][0][Dims] = static_cast<T>(2);
+        homogeneous[1][0][Dims] = static_cast<T>(-2);
+        std::array<V, 2> offset, scale_by;
+        acma::size<Dims, T> extent;
+        for(std::size_t c = 0; c < Dims; ++c) {
+            offset[0][c] = static_cast<T>(1);
+            offset[1][c] = static_cast<T>(-1);
+            scale_by[0][c] = static_cast<T>(2);
+            scale_by[1][c] = static_cast<T>(.5);
+            extent[c] = static_cast<T>(2);
+        }
+        std::size_t flip = 0;
+        bench::do_not_optimize(&batch);
+
+        //The same operations one vector at a time over an array of structs, which is what the batches replace
+        std::vector<V> aos = src;
+        const std::string scalar = tag<T, Dims>("scalar");
+        constexpr T two = 2, one = 1;
+        s.run("vector_batch/translate" + scalar, count, bytes, [&]{ const V o = offset[flip ^= 1]; for(V& v : aos) v += o; done(aos); });
+        s.run("vector_batch/scale" + scalar, count, bytes, [&]{ const V k = scale_by[flip ^= 1]; for(V& v : aos) v = v * k; done(aos); });
+        s.run("vector_batch/transform_linear" + scalar, count, bytes, [&]{ const auto& m = linear[flip ^= 1]; for(V& v : aos) { const auto r = m * v; for(std::size_t c = 0; c < Dims; ++c) v[c] = r[c]; } done(aos); });
+        s.run("vector_batch/normalize_extent" + scalar, count, bytes, [&]{ for(V& v : aos) for(std::size_t c = 0; c < Dims; ++c) v[c] = two * (v[c] / extent[c]) - one; done(aos); });
+
+        s.run("vector_batch/translate" + form, count, bytes, [&]{ batch.translate(offset[flip ^= 1]); bench::clobber_memory(); });
+        s.run("vector_batch/scale" + form, count, bytes, [&]{ batch.scale(scale_by[flip ^= 1]); bench::clobber_memory(); });
+        s.run("vector_batch/scale_origin" + form, count, bytes, [&]{ batch.scale(scale_by[flip ^= 1], offset[0]); bench::clobber_memory(); });
+        s.run("vector_batch/transform_linear" + form, count, bytes, [&]{ batch.transform(linear[flip ^= 1]); bench::clobber_memory(); });
+        s.run("vector_batch/transform_affine" + form, count, bytes, [&]{ batch.transform(homogeneous[flip ^= 1]); bench::clobber_memory(); });
+        s.run("vector_batch/normalize_extent" + form, count, bytes, [&]{ batch.normalize(extent); bench::clobber_memory(); });
+        s.run("vector_batch/min" + form, count, sizeof(V), [&]{ bench::do_not_optimize(batch.min()); });
+        if constexpr(Dims == 2) {
+            const std::array<acma::affine2<T>, 2> a2{acma::affine2<T>::translating({1, 2}) * acma::affine2<T>::scaling({2, 1}), (acma::affine2<T>::translating({1, 2}) * acma::affine2<T>::scaling({2, 1})).inverse()};
+            std::vector<acma::point2<T>> aos_points(src.begin(), src.end());
+            s.run("vector_batch/transform_affine2" + scalar, count, bytes, [&]{ const auto& m = a2[flip ^= 1]; for(acma::point2<T>& p : aos_points) p = m * p; done(aos_points); });
+            s.run("vector_batch/transform_affine2" + form, count, bytes, [&]{ batch.transform(a2[flip ^= 1]); bench::clobber_memory(); });
+            s.run("vector_batch/bounds" + form, count, sizeof(V), [&]{ bench::do_not_optimize(batch.bounds()); });
+        }
+    }
+}
+
+
+namespace {
+    template<std::size_t N, typename T>
+    void bench_matrix(bench::suite& s) {
+        using M = acma::matrix<N, N, T>;
+        using column = typename M::column_type;
+        std::vector<M> mats(count), out(count);
+        std::vector<column> cols(count), col_out(count);
+        std::vector<T> dets(count);
+        for(std::size_t i = 0; i < count; ++i) {
+            mats[i] = M::identity();
+            for(std::size_t r = 0; r < N; ++r)
+                for(std::size_t c = 0; c < N; ++c) mats[i][r][c] += value<T>(i + r * N + c) / static_cast<T>(64);
+            for(std::size_t r = 0; r < N; ++r) cols[i][r] = value<T>(i + r);
+        }
+        const std::string scalar = tag<T, N>("scalar");
+
+        s.run("matrix/mul_matrix" + scalar, count, 3 * sizeof(M), [&]{ for(std::size_t i = 0; i + 1 < count; ++i) out[i] = mats[i] * mats[i + 1]; done(out); });
+        s.run("matrix/mul_vector" + scalar, count, sizeof(M) + 2 * sizeof(column), [&]{ for(std::size_t i = 0; i < count; ++i) col_out[i] = mats[i] * cols[i]; done(col_out); });
+        s.run("matrix/transpose" + scalar, count, 2 * sizeof(M), [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = M::transposed(mats[i]); done(out); });
+        s.run("matrix/determinant" + scalar, count, sizeof(M) + sizeof(T), [&]{ for(std::size_t i = 0; i < count; ++i) dets[i] = mats[i].determinant(); done(dets); });
+        s.run("matrix/inverse" + scalar, count, 2 * sizeof(M), [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = mats[i].inverse(); done(out); });
+        if constexpr(N >= 3) s.run("matrix/affine_inverse" + scalar, count, 2 * sizeof(M), [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = mats[i].affine_inverse(); done(out); });
+
+        using V = acma::vector<N, T>;
+        const std::vector<V> src = make_values<V>(4);
+        std::vector<V> dst(count);
+        const std::string batch = tag<T, N>("batch");
+        s.run("matrix/transform_one" + batch, count, 2 * sizeof(V), [&]{ acma::transform<N, T>(std::span<M const>{mats.data(), 1}, src, dst); done(dst); });
+        s.run("matrix/transform_each" + batch, count, sizeof(M) + 2 * sizeof(V), [&]{ acma::transform<N, T>(mats, src, dst); done(dst); });
+    }
+
+
+    template<typename T>
+    void bench_affine2(bench::suite& s) {
+        using A = acma::affine2<T>;
+        std::vector<A> xforms(count), out(count);
+        for(std::size_t i = 0; i < count; ++i)
+            xforms[i] = A::translating({value<T>(i), value<T>(i, 1)}) * A::rotating(value<T>(i) / 16, acma::math::sin, acma::math::cos);
+        const std::vector<acma::point2<T>> pts = make_values<acma::point2<T>>(5);
+        std::vector<acma::point2<T>> pts_out(count);
+        std::vector<acma::rect<T>> rects(count), rects_out(count);
+        for(std::size_t i = 0; i < count; ++i) rects[i] = {pts[i], acma::size2<T>{value<T>(i, 6), value<T>(i, 7)}};
+        const std::string scalar = tag<T, 1>("scalar"), batch = tag<T, 1>("batch");
+
+        s.run("affine2/compose" + scalar, count, 3 * sizeof(A), [&]{ for(std::size_t i = 0; i + 1 < count; ++i) out[i] = xforms[i] * xforms[i + 1]; done(out); });
+        s.run("affine2/inverse" + scalar, count, 2 * sizeof(A), [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = xforms[i].inverse(); done(out); });
+        s.run("affine2/apply_point" + scalar, count, sizeof(A) + 2 * sizeof(acma::point2<T>), [&]{ for(std::size_t i = 0; i < count; ++i) pts_out[i] = xforms[i] * pts[i]; done(pts_out); });
+        s.run("affine2/transform_bounds" + scalar, count, sizeof(A) + 2 * sizeof(acma::rect<T>), [&]{ for(std::size_t i = 0; i < count; ++i) rects_out[i] = acma::transform_bounds(xforms[i], rects[i]); done(rects_out); });
+
+        s.run("affine2/transform" + batch, count, 2 * sizeof(acma::point2<T>), [&]{ acma::transform(xforms[0], std::span<acma::point2<T> const>{pts}, std::span<acma::point2<T>>{pts_out}); done(pts_out); });
+        s.run("affine2/transform_bounds" + batch, count, 2 * sizeof(acma::rect<T>), [&]{ acma::transform_bounds(xforms[0], std::span<acma::rect<T> const>{rects}, std::span<acma::rect<T>>{rects_out}); done(rects_out); });
+        acma::rect_batch<T> rect_soa{std::span<acma::rect<T> const>{rects}};
+        const std::array<A, 2> shift{A::translating({1, 2}), A::translating({-1, -2})};
+        std::size_t flip = 0;
+        bench::do_not_optimize(&rect_soa);
+        s.run("affine2/transform_bounds_soa" + batch, count, 2 * sizeof(acma::rect<T>), [&]{ rect_soa.transform_bounds(shift[flip ^= 1]); bench::clobber_memory(); });
+    }
+
+
+    template<typename T>
+    void bench_quaternion(bench::suite& s) {
+        using Q = acma::quaternion<T>;
+        std::vector<Q> quats(count), out(count);
+        for(std::size_t i = 0; i < count; ++i) quats[i] = acma::normalized(Q{value<T>(i), value<T>(i, 1), value<T>(i, 2), value<T>(i, 3)}, acma::math::sqrt);
+        std::vector<acma::matrix<3, 3, T>> mats(count);
+        const std::string scalar = tag<T, 1>("scalar"), batch = tag<T, 1>("batch");
+
+        s.run("quaternion/mul" + scalar, count, 3 * sizeof(Q), [&]{ for(std::size_t i = 0; i + 1 < count; ++i) out[i] = quats[i] * quats[i + 1]; done(out); });
+        s.run("quaternion/add" + scalar, count, 3 * sizeof(Q), [&]{ for(std::size_t i = 0; i + 1 < count; ++i) out[i] = quats[i] + quats[i + 1]; done(out); });
+        s.run("quaternion/normalize_std" + scalar, count, 2 * sizeof(Q), [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = acma::normalized(quats[i], acma::math::sqrt); done(out); });
+        s.run("quaternion/normalize_fast" + scalar, count, 2 * sizeof(Q), [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = acma::normalized(quats[i], acma::math::fast::sqrt); done(out); });
+        s.run("quaternion/to_matrix3" + scalar, count, sizeof(Q) + sizeof(mats[0]), [&]{ for(std::size_t i = 0; i < count; ++i) mats[i] = acma::to_matrix<3>(quats[i]); done(mats); });
+
+        acma::quaternion_batch<T> a{std::span<Q const>{quats}}, b{std::span<Q const>{quats}}, dst(count);
+        std::vector<T> t(count);
+        for(std::size_t i = 0; i < count; ++i) t[i] = static_cast<T>(i) / count;
+        bench::do_not_optimize(&dst);
+        s.run("quaternion/mul" + batch, count, 3 * sizeof(Q), [&]{ acma::multiply<T>(a, b, dst.view()); bench::clobber_memory(); });
+        s.run("quaternion/normalize" + batch, count, 2 * sizeof(Q), [&]{ acma::normalize<T>(a, dst.view()); bench::clobber_memory(); });
+        s.run("quaternion/nlerp" + batch, count, 3 * sizeof(Q) + sizeof(T), [&]{ acma::nlerp<T>(a, b, std::span<T const>{t}, dst.view()); bench::clobber_memory(); });
+        s.run("quaternion/slerp" + batch, count, 3 * sizeof(Q) + sizeof(T), [&]{ acma::slerp<T>(a, b, std::span<T const>{t}, dst.view()); bench::clobber_memory(); });
+        s.run("quaternion/to_matrix3" + batch, count, sizeof(Q) + sizeof(mats[0]), [&]{ acma::to_matrix<3, T>(dst.view(), std::span<acma::matrix<3, 3, T>>{mats}); done(mats); });
+    }
+}
+
+
+namespace {
+    template<typename T>
+    void bench_rect(bench::suite& s) {
+        std::vector<acma::rect<T>> rects(count);
+        const std::vector<acma::point2<T>> pts = make_values<acma::point2<T>>(8);
+        for(std::size_t i = 0; i < count; ++i) rects[i] = {pts[(i * 31) % count], acma::size2<T>{value<T>(i, 9), value<T>(i, 10)}};
+        std::vector<std::uint8_t> hits(count);
+        std::vector<std::array<acma::point2<T>, 4>> corners(count);
+        const acma::size2<T> screen{static_cast<T>(1920), static_cast<T>(1080)};
+        const std::string scalar = tag<T, 1>("scalar"), batch = tag<T, 1>("batch");
+
+        s.run("rect/contains" + scalar, count, sizeof(acma::rect<T>) + sizeof(acma::point2<T>) + 1, [&]{ for(std::size_t i = 0; i < count; ++i) hits[i] = rects[i].contains(pts[i]); done(hits); });
+        s.run("rect/points_normalized" + scalar, count, sizeof(acma::rect<T>) + sizeof(corners[0]), [&]{ for(std::size_t i = 0; i < count; ++i) corners[i] = rects[i].points(screen); done(corners); });
+
+        acma::rect_batch<T> soa{std::span<acma::rect<T> const>{rects}};
+        acma::point_batch<2, T> soa_corners(4 * count);
+        bench::do_not_optimize(&soa_corners);
+        s.run("rect/points_normalized" + batch, count, sizeof(acma::rect<T>) + sizeof(corners[0]), [&]{ soa.points(screen, soa_corners.view()); bench::clobber_memory(); });
+        s.run("rect/bounds" + batch, count, sizeof(acma::rect<T>), [&]{ bench::do_not_optimize(soa.bounds()); });
+
+        //Hit-testing a point against every rect: linear scan vs the AABB tree
+        acma::rect_tree<T> tree;
+        for(std::size_t i = 0; i < count; ++i) tree.insert(rects[i], i);
+        std::vector<acma::rect_handle> found(count);
+        s.run("rect/hit_test_scan" + scalar, count, 0, [&]{
+            for(std::size_t q = 0; q < 64; ++q) {
+                std::size_t hit = count;
+                for(std::size_t i = 0; i < count; ++i) hit = rects[i].contains(pts[q]) ? i : hit;
+                bench::do_not_optimize(hit);
+            }
+        });
+        s.run("rect/hit_test_tree" + scalar, 64, 0, [&]{ for(std::size_t q = 0; q < 64; ++q) found[q] = tree.find(pts[q]); done(found); });
+    }
+
+
+    template<typename P>
+    void bench_packed(bench::suite& s, char const* name) {
+        using U = typename acma::impl::packed_traits<P>::unpacked_type;
+        std::vector<U> src(count), unpacked(count);
+        for(std::size_t i = 0; i < count; ++i)
+            for(std::size_t c = 0; c < src[i].size(); ++c) src[i][c] = static_cast<float>((i * 7 + c * 3) % 101) / 101.f * 2.f - 1.f;
+        std::vector<P> packed(count);
+        const std::string family = std::string("packed/") + name;
+        constexpr std::size_t bytes = sizeof(U) + sizeof(P);
+
+        s.run(family + "/pack/scalar", count, bytes, [&]{ for(std::size_t i = 0; i < count; ++i) packed[i] = P(src[i]); done(packed); });
+        s.run(family + "/pack/batch", count, bytes, [&]{ acma::pack<P>(src, packed); done(packed); });
+        s.run(family + "/unpack/scalar", count, bytes, [&]{ for(std::size_t i = 0; i < count; ++i) unpacked[i] = packed[i].unpack(); done(unpacked); });
+        s.run(family + "/unpack/batch", count, bytes, [&]{ acma::unpack<P>(packed, unpacked); done(unpacked); });
+    }
+
+
+    template<typename T>
+    void bench_math(bench::suite& s) {
+        std::vector<T> x(count), y(count), out(count);
+        for(std::size_t i = 0; i < count; ++i) {
+            x[i] = (value<T>(i) - static_cast<T>(12)) / 4;
+            y[i] = value<T>(i, 1);
+        }
+        const std::string form = tag<T, 1>("scalar");
+        const auto run_unary = [&](std::string name, auto&& fn) {
+            s.run(name + form, count, 2 * sizeof(T), [&]{
+                T const* in = x.data();
+                T* o = out.data();
+                #pragma omp simd
+                for(std::size_t i = 0; i < count; ++i) o[i] = fn(in[i]);
+                done(out);
+            });
+        };
+
+        run_unary("math/sin_std", [](T v) { return std::sin(v); });
+        run_unary("math/sin_fast", acma::math::fast::sin);
+        run_unary("math/cos_std", [](T v) { return std::cos(v); });
+        run_unary("math/cos_fast", acma::math::fast::cos);
+        run_unary("math/sqrt_std", [](T v) { return std::sqrt(v < 0 ? -v : v); });
+        run_unary("math/sqrt_fast", [](T v) { return acma::math::fast::sqrt(v < 0 ? -v : v); });
+        run_unary("math/rsqrt_std", [](T v) { return acma::math::rsqrt(v < 0 ? -v : v); });
+        run_unary("math/rsqrt_fast", [](T v) { return acma::math::fast::rsqrt(v < 0 ? -v : v); });
+        s.run("math/atan2_std" + form, count, 3 * sizeof(T), [&]{ for(std::size_t i = 0; i < count; ++i) out[i] = std::atan2(y[i], x[i]); done(out); });
+        s.run("math/atan2_fast" + form, count, 3 * sizeof(T), [&]{
+            T const* in_y = y.data();
+            T const* in_x = x.data();
+            T* o = out.data();
+            #pragma omp simd
+            for(std::size_t i = 0; i < count; ++i) o[i] = acma::math::fast::atan2(in_y[i], in_x[i]);
+            done(out);
+        });
+    }
+}
+
+
+int main(int argc, char** argv) {
+    bench::suite s(argc, argv);
+
+    bench_vector<2, float>(s);  bench_vector<3, float>(s);  bench_vector<4, float>(s);
+    bench_vector<2, double>(s); bench_vector<3, double>(s); bench_vector<4, double>(s);
+    bench_vector<2, std::int32_t>(s); bench_vector<3, std::int32_t>(s); bench_vector<4, std::int32_t>(s);
+    bench_vector_batch<2, float>(s);  bench_vector_batch<3, float>(s);
+    bench_vector_batch<2, double>(s); bench_vector_batch<3, double>(s);
+
+    bench_matrix<2, float>(s);  bench_matrix<3, float>(s);  bench_matrix<4, float>(s);
+    bench_matrix<2, double>(s); bench_matrix<3, double>(s); bench_matrix<4, double>(s);
+    bench_affine2<float>(s);
+    bench_affine2<double>(s);
+    bench_quaternion<float>(s);
+    bench_quaternion<double>(s);
+
+    bench_rect<float>(s);
+    bench_rect<double>(s);
+    bench_packed<acma::half4>(s, "half4");
+    bench_packed<acma::unorm8x4>(s, "unorm8x4");
+    bench_packed<acma::snorm16x2>(s, "snorm16x2");
+    bench_packed<acma::a2b10g10r10>(s, "a2b10g10r10");
+    bench_packed<acma::oct_normal16>(s, "oct_normal16");
+    bench_math<float>(s);
+    bench_math<double>(s);
+
+    return s.finish();
+}
@@ -0,0 +1,147 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <msdfgen.h>
+
+#include <sirius/arith/point.hpp>
+#include <sirius/graphics/core/glyph_distance_field.hpp>
+
+#include "bench_harness.hpp"
+
+
+//Benchmarks glyph_distance_field on glyph-like outlines (already in em units and edge-colored, as decode_font passes them).
+//Names are glyph/<outline>/tile<TileLength>, glyph/<outline>/unculled for testing every edge for every pixel, and glyph/<outline>/msdfgen
+//for msdfgen's per-pixel generateMTSDF (without error correction, which glyph_distance_field leaves to msdfgen too)
+namespace {
+    constexpr std::size_t length = 32;
+    constexpr std::array<std::uint8_t, 3> colors = {acma::edge_color::cyan, acma::edge_color::magenta, acma::edge_color::yellow};
+
+    //A circle of quadratic beziers (counter-clockwise for outer contours)
+    void add_circle(acma::glyph_outline& outline, double radius, std::size_t edge_count, bool ccw) {
+        constexpr acma::pt2d center{.5, .5};
+        const double step = 2 * std::numbers::pi / static_cast<double>(edge_count) * (ccw ? 1 : -1);
+        const double control_radius = radius / std::cos(step / 2);
+        outline.add_contour();
+        for(std::size_t i = 0; i < edge_count; ++i) {
+            const double a0 = step * static_cast<double>(i), a1 = a0 + step, mid = (a0 + a1) / 2;
+            outline.add_edge(acma::glyph_edge{
+                .points = {
+                    acma::pt2d{center.x() + radius * std::cos(a0), center.y() + radius * std::sin(a0)},
+                    acma::pt2d{center.x() + control_radius * std::cos(mid), center.y() + control_radius * std::sin(mid)},
+                    acma::pt2d{center.x() + radius * std::cos(a1), center.y() + radius * std::sin(a1)},
+                    acma::pt2d{},
+                },
+                .degree = 2,
+                .color = colors[i * colors.size() / edge_count],
+            });
+        }
+    }
+
+    acma::glyph_outline make_o() {
+        acma::glyph_outline outline;
+        add_circle(outline, .4, 24, true);
+        add_circle(outline, .28, 24, false);
+        return outline;
+    }
+
+    acma::glyph_outline make_e() {
+        constexpr std::array<acma::pt2d, 12> points{{
+            {.15, .1}, {.85, .1}, {.85, .22}, {.3, .22}, {.3, .45}, {.7, .45},
+            {.7, .57}, {.3, .57}, {.3, .78}, {.85, .78}, {.85, .9}, {.15, .9},
+        }};
+        acma::glyph_outline outline;
+        outline.add_contour();
+        for(std::size_t i = 0; i < points.size(); ++i)
+            outline.add_edge(acma::glyph_edge{
+                .points = {points[i], points[(i + 1) % points.size()], acma::pt2d{}, acma::pt2d{}},
+                .degree = 1,
+                .color = colors[i % colors.size()],
+            });
+        return outline;
+    }
+
+    //Two cubic bowls joined by lines, like the strokes of an 'S'
+    acma::glyph_outline make_s() {
+        constexpr std::array<std::array<acma::pt2d, 4>, 4> cubics{{
+            {{{.8, .8}, {.6, 1.}, {.1, .95}, {.2, .6}}},
+            {{{.2, .6}, {.3, .4}, {.9, .5}, {.8, .2}}},
+            {{{.8, .2}, {.6, -.05}, {.1, .05}, {.2, .25}}},
+            {{{.2, .25}, {.4, .1}, {.7, .15}, {.65, .3}}},
+        }};
+        acma::glyph_outline outline;
+        outline.add_contour();
+        for(std::size_t i = 0; i < cubics.size(); ++i)
+            outline.add_edge(acma::glyph_edge{.points = cubics[i], .degree = 3, .color = colors[i % colors.size()]});
+        outline.add_edge(acma::glyph_edge{.points = {acma::pt2d{.65, .3}, acma::pt2d{.8, .8}, acma::pt2d{}, acma::pt2d{}}, .degree = 1, .color = colors[1]});
+        return outline;
+    }
+}
+
+
+namespace {
+    msdfgen::Shape to_shape(acma::glyph_outline const& outline) {
+        msdfgen::Shape shape;
+        for(std::size_t c = 0; c < outline.contour_count(); ++c) {
+            msdfgen::Contour& contour = shape.addContour();
+            for(acma::glyph_edge const& e : outline.contour(c)) {
+                const auto point = [&e](std::size_t i) { return msdfgen::Point2(e.points[i].x(), e.points[i].y()); };
+                const msdfgen::EdgeColor color = static_cast<msdfgen::EdgeColor>(e.color);
+                switch(e.degree) {
+                case 1:  contour.addEdge(msdfgen::EdgeHolder(point(0), point(1), color)); break;
+                case 2:  contour.addEdge(msdfgen::EdgeHolder(point(0), point(1), point(2), color)); break;
+                default: contour.addEdge(msdfgen::EdgeHolder(point(0), point(1), point(2), point(3), color)); break;
+                }
+            }
+        }
+        shape.inverseYAxis = true;
+        return shape;
+    }
+}
+
+
+namespace {
+    template<std::size_t TileLength, bool Cull = true>
+    void bench_glyph(bench::suite& s, std::string const& name, acma::glyph_outline const& outline) {
+        using field_type = acma::glyph_distance_field<length, TileLength, Cull>;
+        static field_type field;
+        static std::array<float, field_type::size> distances;
+        s.run("glyph/" + name + (Cull ? "/tile" + std::to_string(TileLength) : "/unculled"), 1, 0, [&]{
+            field.evaluate(outline, length, acma::pt2d{}, distances);
+            bench::do_not_optimize(distances.data());
+            bench::clobber_memory();
+        });
+    }
+
+    void bench_outline(bench::suite& s, std::string const& name, acma::glyph_outline const& outline) {
+        bench_glyph<4>(s, name, outline);
+        bench_glyph<8>(s, name, outline);
+        bench_glyph<length>(s, name, outline);
+        bench_glyph<4, false>(s, name, outline);
+
+        const msdfgen::Shape shape = to_shape(outline);
+        const msdfgen::MSDFGeneratorConfig config(true, msdfgen::ErrorCorrectionConfig(msdfgen::ErrorCorrectionConfig::DISABLED));
+        msdfgen::Bitmap<float, 4> bitmap(length, length);
+        s.run("glyph/" + name + "/msdfgen", 1, 0, [&]{
+            msdfgen::generateMTSDF(bitmap, shape, msdfgen::Projection(length, msdfgen::Vector2(0, 0)), msdfgen::Range(1), config);
+            bench::do_not_optimize(static_cast<float*>(bitmap));
+            bench::clobber_memory();
+        });
+    }
+}
+
+
+int main(int argc, char** argv) {
+    bench::suite s(argc, argv);
+
+    bench_outline(s, "o", make_o());
+    bench_outline(s, "e", make_e());
+    bench_outline(s, "s", make_s());
+
+    return s.finish();
+}
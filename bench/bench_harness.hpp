@@ -0,0 +1,269 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+//Minimal benchmark harness shared by the bench_ executables.
+//Each benchmark is a callable that performs `ops` operations. It is run for a few warmup samples (which are also used to pick how many
+//calls make up one sample, so that every sample takes at least min_sample_ns), then timed over `repetitions` samples.
+//
+//Command line options:
+//  --filter=<substring>   only run benchmarks whose name contains the substring
+//  --warmup=<n>           warmup samples (default 3)
+//  --reps=<n>             timed samples (default 25)
+//  --json=<path>          write the results as JSON ("-" for stdout)
+//  --baseline=<path>      compare against a previous --json output, and exit with 1 if any benchmark regressed
+//  --threshold=<percent>  how much slower (in median ns/op) than the baseline counts as a regression (default 10)
+//
+//The JSON records the machine it was measured on (CPU, compiler and the flags that change codegen). A baseline from a different
+//machine is still compared, but only as a warning: its timings say nothing about regressions here
+namespace bench {
+    //Keeps the compiler from optimizing away the benchmarked work
+    template<typename T>
+    void do_not_optimize(T const& value) { asm volatile("" : : "r,m"(value) : "memory"); }
+    inline void clobber_memory() { asm volatile("" : : : "memory"); }
+
+
+    struct result {
+        std::string name;
+        double median_ns;
+        double p10_ns;
+        double p90_ns;
+        double p99_ns;
+        double min_ns;
+        double gb_per_s;
+    };
+
+    //What a set of timings is only comparable under
+    struct machine {
+        std::string cpu;
+        std::string compiler;
+        std::string flags;
+
+        static machine current() noexcept;
+        bool operator==(machine const&) const noexcept = default;
+    };
+
+    struct options {
+        std::string_view filter;
+        std::size_t warmup = 3;
+        std::size_t repetitions = 25;
+        char const* json_path = nullptr;
+        char const* baseline_path = nullptr;
+        double threshold_percent = 10;
+        double min_sample_ns = 200'000;
+    };
+
+
+    class suite {
+    public:
+        suite(int argc, char** argv) noexcept;
+
+    public:
+        //bytes_per_op is the memory read and written by one operation (0 if it isn't meaningful), and is only used for GB/s
+        template<typename F>
+        void run(std::string name, std::size_t ops, std::size_t bytes_per_op, F&& f) noexcept;
+
+        //Prints the results, writes the JSON and compares against the baseline. Returns the exit code
+        int finish() noexcept;
+
+    private:
+        static double percentile(std::vector<double> const& sorted, double p) noexcept;
+        void write_json(std::FILE* out) const noexcept;
+        int compare_baseline() const noexcept;
+
+    private:
+        options opts;
+        machine host = machine::current();
+        std::vector<result> results;
+    };
+}
+
+
+namespace bench {
+    inline machine machine::current() noexcept {
+        machine ret{"unknown", "unknown", ""};
+        if(std::FILE* cpuinfo = std::fopen("/proc/cpuinfo", "r")) {
+            char line[256];
+            while(std::fgets(line, sizeof(line), cpuinfo)) {
+                //e.g. "model name\t: Intel(R) Xeon(R) Processor\n"
+                const std::string_view l = line;
+                const std::size_t colon = l.find(": ");
+                if(!l.starts_with("model name") || colon == std::string_view::npos) continue;
+                ret.cpu = l.substr(colon + 2, l.find('\n') - colon - 2);
+                break;
+            }
+            std::fclose(cpuinfo);
+        }
+
+#if defined(__clang__)
+        ret.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+        ret.compiler = "gcc " __VERSION__;
+#endif
+
+        //Only the flags that change the generated code are visible to the preprocessor, which are also the ones that matter here
+#if defined(__OPTIMIZE__)
+        ret.flags += "optimized";
+#else
+        ret.flags += "unoptimized";
+#endif
+#if defined(__FAST_MATH__)
+        ret.flags += " fast-math";
+#endif
+#if defined(__AVX512F__)
+        ret.flags += " avx512f";
+#elif defined(__AVX2__)
+        ret.flags += " avx2";
+#elif defined(__AVX__)
+        ret.flags += " avx";
+#elif defined(__SSE4_2__)
+        ret.flags += " sse4.2";
+#elif defined(__ARM_NEON)
+        ret.flags += " neon";
+#endif
+#if defined(__FMA__)
+        ret.flags += " fma";
+#endif
+        return ret;
+    }
+
+
+    inline suite::suite(int argc, char** argv) noexcept {
+        for(int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            const auto value = [&](std::string_view key) noexcept -> char const* {
+                return arg.starts_with(key) ? argv[i] + key.size() : nullptr;
+            };
+            if(char const* v = value("--filter="))         opts.filter = v;
+            else if(char const* v = value("--warmup="))    opts.warmup = std::strtoull(v, nullptr, 10);
+            else if(char const* v = value("--reps="))      opts.repetitions = std::max<std::size_t>(std::strtoull(v, nullptr, 10), 1);
+            else if(char const* v = value("--json="))      opts.json_path = v;
+            else if(char const* v = value("--baseline="))  opts.baseline_path = v;
+            else if(char const* v = value("--threshold=")) opts.threshold_percent = std::strtod(v, nullptr);
+            else std::fprintf(stderr, "unknown option: %s\n", argv[i]);
+        }
+    }
+
+
+    template<typename F>
+    void suite::run(std::string name, std::size_t ops, std::size_t bytes_per_op, F&& f) noexcept {
+        if(!opts.filter.empty() && name.find(opts.filter) == std::string::npos) return;
+
+        using clock = std::chrono::steady_clock;
+        const auto time_ns = [&](std::size_t calls) noexcept {
+            const auto start = clock::now();
+            for(std::size_t c = 0; c < calls; ++c) f();
+            return std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        };
+
+        double warmup_ns = time_ns(1);
+        for(std::size_t w = 1; w < opts.warmup; ++w) warmup_ns = std::min(warmup_ns, time_ns(1));
+        const std::size_t calls = std::max<std::size_t>(1, static_cast<std::size_t>(opts.min_sample_ns / std::max(warmup_ns, 1.)));
+
+        std::vector<double> samples(opts.repetitions);
+        for(double& s : samples) s = time_ns(calls) / static_cast<double>(calls * ops);
+        std::sort(samples.begin(), samples.end());
+
+        result r{std::move(name), percentile(samples, .5), percentile(samples, .1), percentile(samples, .9), percentile(samples, .99), samples.front(), 0};
+        r.gb_per_s = static_cast<double>(bytes_per_op) / r.median_ns;
+        std::printf("%-52s %10.3f ns/op  [p10 %9.3f  p90 %9.3f  p99 %9.3f]", r.name.c_str(), r.median_ns, r.p10_ns, r.p90_ns, r.p99_ns);
+        if(bytes_per_op != 0) std::printf("  %7.2f GB/s", r.gb_per_s);
+        std::printf("\n");
+        results.push_back(std::move(r));
+    }
+
+
+    inline int suite::finish() noexcept {
+        if(opts.json_path) {
+            const bool to_stdout = std::strcmp(opts.json_path, "-") == 0;
+            std::FILE* out = to_stdout ? stdout : std::fopen(opts.json_path, "w");
+            if(!out) {
+                std::fprintf(stderr, "could not open %s\n", opts.json_path);
+                return 2;
+            }
+            write_json(out);
+            if(!to_stdout) std::fclose(out);
+        }
+        return opts.baseline_path ? compare_baseline() : 0;
+    }
+
+
+    inline double suite::percentile(std::vector<double> const& sorted, double p) noexcept {
+        //Linear interpolation between the closest ranks
+        const double rank = p * static_cast<double>(sorted.size() - 1);
+        const std::size_t lo = static_cast<std::size_t>(rank);
+        const std::size_t hi = std::min(lo + 1, sorted.size() - 1);
+        return sorted[lo] + (sorted[hi] - sorted[lo]) * (rank - static_cast<double>(lo));
+    }
+
+    //One benchmark per line, so that compare_baseline (and diff) can read it without a JSON parser
+    inline void suite::write_json(std::FILE* out) const noexcept {
+        std::fprintf(out, "{\"cpu\": \"%s\", \"compiler\": \"%s\", \"flags\": \"%s\",\n", host.cpu.c_str(), host.compiler.c_str(), host.flags.c_str());
+        std::fprintf(out, " \"repetitions\": %zu, \"benchmarks\": [\n", opts.repetitions);
+        for(std::size_t i = 0; i < results.size(); ++i) {
+            result const& r = results[i];
+            std::fprintf(out, "  {\"name\": \"%s\", \"median_ns\": %.6g, \"p10_ns\": %.6g, \"p90_ns\": %.6g, \"p99_ns\": %.6g, \"min_ns\": %.6g, \"gb_per_s\": %.6g}%s\n",
+                r.name.c_str(), r.median_ns, r.p10_ns, r.p90_ns, r.p99_ns, r.min_ns, r.gb_per_s, i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(out, "]}\n");
+    }
+
+    inline int suite::compare_baseline() const noexcept {
+        std::FILE* in = std::fopen(opts.baseline_path, "r");
+        if(!in) {
+            std::fprintf(stderr, "could not open baseline %s\n", opts.baseline_path);
+            return 2;
+        }
+        std::string contents;
+        char buffer[4096];
+        for(std::size_t n; (n = std::fread(buffer, 1, sizeof(buffer), in)) > 0;) contents.append(buffer, n);
+        std::fclose(in);
+
+        const auto baseline_median = [&](std::string_view name) noexcept -> double {
+            const std::string key = "\"name\": \"" + std::string(name) + "\"";
+            const std::size_t pos = contents.find(key);
+            if(pos == std::string::npos) return 0;
+            const std::size_t median = contents.find("\"median_ns\": ", pos);
+            if(median == std::string::npos) return 0;
+            return std::strtod(contents.c_str() + median + std::strlen("\"median_ns\": "), nullptr);
+        };
+
+        const auto baseline_string = [&](std::string_view key) noexcept -> std::string {
+            const std::string quoted_key = "\"" + std::string(key) + "\": \"";
+            const std::size_t pos = contents.find(quoted_key);
+            if(pos == std::string::npos) return "unknown";
+            const std::size_t begin = pos + quoted_key.size();
+            return contents.substr(begin, contents.find('"', begin) - begin);
+        };
+        const machine baseline_host{baseline_string("cpu"), baseline_string("compiler"), baseline_string("flags")};
+        const bool same_machine = baseline_host == host;
+        if(!same_machine) {
+            std::printf("\nwarning: %s was measured on a different machine, so regressions are reported but not failed\n", opts.baseline_path);
+            std::printf("  baseline: %s, %s, %s\n", baseline_host.cpu.c_str(), baseline_host.compiler.c_str(), baseline_host.flags.c_str());
+            std::printf("  this run: %s, %s, %s\n", host.cpu.c_str(), host.compiler.c_str(), host.flags.c_str());
+        }
+
+        std::size_t regressions = 0, compared = 0;
+        std::printf("\ncomparison against %s (threshold %.1f%%):\n", opts.baseline_path, opts.threshold_percent);
+        for(result const& r : results) {
+            const double base = baseline_median(r.name);
+            if(base <= 0) continue;
+            ++compared;
+            const double change = (r.median_ns / base - 1) * 100;
+            const bool regressed = change > opts.threshold_percent;
+            regressions += regressed;
+            if(regressed || change < -opts.threshold_percent)
+                std::printf("  %-52s %10.3f -> %10.3f ns/op (%+6.1f%%)%s\n", r.name.c_str(), base, r.median_ns, change, regressed ? "  REGRESSION" : "");
+        }
+        std::printf("%zu of %zu benchmarks regressed\n", regressions, compared);
+        return regressions == 0 || !same_machine ? 0 : 1;
+    }
+}
@@ -0,0 +1,305 @@
+#include <algorithm>
+#include <chrono>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sirius/input/binding_map.hpp>
+#include <sirius/input/category.hpp>
+#include <sirius/input/code.hpp>
+#include <sirius/input/combination.hpp>
+#include <sirius/input/combination_state.hpp>
+#include <sirius/input/event_fns_map.hpp>
+#include <sirius/input/event_queue.hpp>
+#include <sirius/input/event_set.hpp>
+#include <sirius/input/latency_stats.hpp>
+
+#include "bench_harness.hpp"
+
+
+namespace {
+    //The hash binding_map used when it was a std::unordered_map
+    struct bitset_hash {
+        std::size_t operator()(acma::input::combination const& c) const noexcept {
+            return std::hash<acma::input::combination_bitset>{}(std::bit_cast<acma::input::combination_bitset>(c));
+        }
+    };
+    using unordered_binding_map = std::unordered_map<acma::input::combination, acma::input::event_set, bitset_hash>;
+
+    constexpr std::size_t lookups = 1 << 12;
+
+    //Random bindings of 0 to 3 modifiers and a main input, like an application's key map
+    std::vector<acma::input::combination> make_combinations(std::size_t count, std::mt19937& rng) noexcept {
+        std::vector<acma::input::combination> ret;
+        while(ret.size() < count) {
+            acma::input::combination c{{}, static_cast<acma::input::code_t>(acma::input::key_code::kb_a + rng() % 100)};
+            for(std::size_t m = rng() % 4; m > 0; --m) c.set(acma::input::key_code::kb_left_ctrl + rng() % 8);
+            if(std::find(ret.begin(), ret.end(), c) == ret.end()) ret.push_back(c);
+        }
+        return ret;
+    }
+
+
+    template<typename Map>
+    void bench_lookup(bench::suite& s, std::string const& name, Map const& map, std::vector<acma::input::combination> const& keys) {
+        std::size_t found = 0;
+        s.run(name, lookups, 0, [&]{
+            for(std::size_t i = 0; i < lookups; ++i) found += map.find(keys[i]) != map.end();
+            bench::do_not_optimize(found);
+        });
+    }
+
+    //process_input's fallback chain: the exact combination, then any modifiers, then any main input, then any input at all
+    template<typename Map>
+    void bench_process_chain(bench::suite& s, std::string const& name, Map const& map, std::vector<acma::input::combination> const& keys) {
+        using namespace acma::input;
+        std::size_t found = 0;
+        s.run(name, lookups, 0, [&]{
+            for(std::size_t i = 0; i < lookups; ++i) {
+                combination combo = keys[i];
+                auto it = map.find(combo);
+                if(it == map.end()) it = map.find(combination{{generic_code::any}, combo.main_input()});
+                if(it == map.end()) {
+                    combo.main_input() = generic_code::any;
+                    it = map.find(combo);
+                }
+                if(it == map.end()) it = map.find(combination{{generic_code::any}, generic_code::any});
+                found += it != map.end();
+            }
+            bench::do_not_optimize(found);
+        });
+    }
+
+
+    void bench_binding_map(bench::suite& s, std::size_t binding_count) {
+        std::mt19937 rng(binding_count);
+        const std::vector<acma::input::combination> bound = make_combinations(binding_count, rng);
+        const std::vector<acma::input::combination> unbound = [&]{
+            std::vector<acma::input::combination> candidates = make_combinations(binding_count + lookups, rng), ret;
+            for(acma::input::combination const& c : candidates)
+                if(std::find(bound.begin(), bound.end(), c) == bound.end()) ret.push_back(c);
+            return ret;
+        }();
+
+        std::vector<acma::input::combination> hits(lookups), misses(lookups), mixed(lookups);
+        for(std::size_t i = 0; i < lookups; ++i) {
+            hits[i] = bound[rng() % bound.size()];
+            misses[i] = unbound[rng() % unbound.size()];
+            mixed[i] = rng() % 4 == 0 ? hits[i] : misses[i];
+        }
+
+        unordered_binding_map unordered;
+        acma::input::binding_map flat, frozen;
+        for(std::size_t i = 0; i < bound.size(); ++i) {
+            unordered[bound[i]].event_ids[0] = static_cast<acma::input::event_id_t>(i);
+            flat[bound[i]].event_ids[0] = static_cast<acma::input::event_id_t>(i);
+            frozen[bound[i]].event_ids[0] = static_cast<acma::input::event_id_t>(i);
+        }
+        frozen.freeze();
+
+        for(std::size_t i = 0; i < bound.size(); ++i) {
+            if(flat.find(bound[i])->second.event_ids[0] != static_cast<acma::input::event_id_t>(i) || frozen.find(bound[i])->second.event_ids[0] != static_cast<acma::input::event_id_t>(i)) {
+                std::fprintf(stderr, "binding_map lookup mismatch\n");
+                std::abort();
+            }
+        }
+
+        const std::string n = "/" + std::to_string(binding_count);
+        bench_lookup(s, "binding_map/hit/unordered_map" + n, unordered, hits);
+        bench_lookup(s, "binding_map/hit/flat" + n, flat, hits);
+        bench_lookup(s, "binding_map/hit/frozen" + n, frozen, hits);
+        bench_lookup(s, "binding_map/miss/unordered_map" + n, unordered, misses);
+        bench_lookup(s, "binding_map/miss/flat" + n, flat, misses);
+        bench_lookup(s, "binding_map/miss/frozen" + n, frozen, misses);
+        bench_process_chain(s, "binding_map/process_input/unordered_map" + n, unordered, mixed);
+        bench_process_chain(s, "binding_map/process_input/flat" + n, flat, mixed);
+        bench_process_chain(s, "binding_map/process_input/frozen" + n, frozen, mixed);
+    }
+}
+
+
+namespace {
+    void process_stub(void*, acma::input::code_t, bool, acma::input::mouse_aux_t) noexcept {}
+
+    //Producer-side cost of one mouse move. The old callbacks built two std::function tasks (the bound optional<pt2d> doesn't fit in the
+    //small buffer, so each one allocates) before the thread pool's own enqueue, which isn't counted here
+    void bench_event_queue(bench::suite& s) {
+        constexpr std::size_t events = 1024;
+        std::vector<std::function<void()>> tasks;
+        tasks.reserve(2 * events);
+        s.run("event_queue/mouse_move/bound_tasks", events, 0, [&]{
+            for(std::size_t i = 0; i < events; ++i) {
+                tasks.emplace_back(std::bind(process_stub, nullptr, acma::input::mouse_code::move, true, acma::input::mouse_aux_t{acma::pt2d{static_cast<double>(i), 0}}));
+                tasks.emplace_back(std::bind(process_stub, nullptr, acma::input::mouse_code::move, false, acma::input::mouse_aux_t{acma::pt2d{static_cast<double>(i), 0}}));
+            }
+            bench::do_not_optimize(tasks.data());
+            tasks.clear();
+        });
+
+        //The drain runs on the same thread here (after the batch), so this is push + request_drain, plus the pop
+        const std::unique_ptr<acma::input::event_queue> queue = std::make_unique<acma::input::event_queue>();
+        std::size_t drained = 0, drains = 0;
+        s.run("event_queue/mouse_move/ring_buffer", events, sizeof(acma::input::event_record), [&]{
+            for(std::size_t i = 0; i < events; ++i) {
+                queue->push({acma::pt2d{static_cast<double>(i), 0}, 0, acma::input::mouse_code::move, acma::input::input_action::press_release, true});
+                drains += queue->request_drain();
+            }
+            queue->drain([&](std::span<acma::input::event_record const> batch) noexcept { drained += batch.size(); });
+            bench::do_not_optimize(drained);
+        });
+        bench::do_not_optimize(drains);
+    }
+}
+
+
+namespace {
+    //process_input's read-modify-write of the held inputs (uncontended), and the snapshot a render thread would take
+    void bench_combination_state(bench::suite& s) {
+        using namespace acma::input;
+        constexpr std::size_t updates = 1024;
+
+        combination guarded{};
+        std::mutex mutex;
+        s.run("combination_state/update/mutex", updates, 0, [&]{
+            for(std::size_t i = 0; i < updates; ++i) {
+                std::unique_lock<std::mutex> lock(mutex);
+                guarded.main_input() = static_cast<code_t>(key_code::kb_a + i % 26);
+                guarded.set(guarded.main_input(), i & 1);
+            }
+            bench::do_not_optimize(&guarded);
+        });
+        s.run("combination_state/snapshot/mutex", updates, sizeof(combination), [&]{
+            for(std::size_t i = 0; i < updates; ++i) {
+                std::unique_lock<std::mutex> lock(mutex);
+                combination c = guarded;
+                bench::do_not_optimize(&c);
+            }
+        });
+
+        combination_state state;
+        s.run("combination_state/update/seqlock", updates, 0, [&]{
+            for(std::size_t i = 0; i < updates; ++i) {
+                combination c = state.last_stored();
+                c.main_input() = static_cast<code_t>(key_code::kb_a + i % 26);
+                c.set(c.main_input(), i & 1);
+                state.store(c);
+            }
+            bench::do_not_optimize(&state);
+        });
+        s.run("combination_state/snapshot/seqlock", updates, sizeof(combination), [&]{
+            for(std::size_t i = 0; i < updates; ++i) {
+                combination c = state.load();
+                bench::do_not_optimize(&c);
+            }
+        });
+    }
+}
+
+
+namespace {
+    std::size_t dispatched = 0;
+    void count_event(void*, acma::input::combination, bool, acma::input::categorized_event_t, acma::input::mouse_aux_t, void*) { ++dispatched; }
+
+    //process_input's dispatch of one bound event_set to every active category
+    template<typename Find>
+    void bench_dispatch_loop(bench::suite& s, std::string const& name, acma::input::event_set const& events, Find&& find) {
+        using namespace acma::input;
+        s.run(name, lookups, 0, [&]{
+            for(std::size_t i = 0; i < lookups; ++i) {
+                category_flags_t category_flags = events.applicable_categories;
+                while(category_flags.any()) {
+                    const category_id_t category_id = max_category_id - std::countl_zero(category_flags.to_ullong());
+                    find(categorized_event_t{events.event_ids[category_id], category_id});
+                    category_flags.reset(category_id);
+                }
+            }
+            bench::do_not_optimize(dispatched);
+        });
+    }
+
+    void bench_event_dispatch(bench::suite& s, std::size_t category_count) {
+        using namespace acma::input;
+        std::unordered_map<categorized_event_t, std::function<generic_event_function>> unordered;
+        event_fns_map plain, captureless, stateful;
+        std::size_t stateful_count = 0;
+        event_set events{};
+        for(category_id_t c = 0; c < category_count; ++c) {
+            events.applicable_categories.set(c * (num_categories / category_count));
+            for(event_id_t id = 0; id < 64; ++id) {
+                const categorized_event_t e{id, c * static_cast<category_id_t>(num_categories / category_count)};
+                events.event_ids[e.category_id] = 17;
+                unordered.try_emplace(e, count_event);
+                plain.try_emplace(e, count_event);
+                captureless.try_emplace(e, [](void*, combination, bool, categorized_event_t, mouse_aux_t, void*) { ++dispatched; });
+                stateful.try_emplace(e, [&stateful_count](void*, combination, bool, categorized_event_t, mouse_aux_t, void*) { ++stateful_count; });
+            }
+        }
+
+        const std::string n = "/" + std::to_string(category_count);
+        bench_dispatch_loop(s, "event_dispatch/unordered_map" + n, events, [&](categorized_event_t e) {
+            auto it = unordered.find(e);
+            if(it != unordered.end()) std::invoke(it->second, nullptr, combination{}, true, e, std::nullopt, nullptr);
+        });
+        //Calls the same function pointer as unordered_map. Its by-value combination and mouse_aux_t are copied to the stack on every
+        //call, which the lambdas' invokers (like std::function's) avoid by taking them by reference
+        bench_dispatch_loop(s, "event_dispatch/dense_fn_ptr" + n, events, [&](categorized_event_t e) {
+            if(event_function_ref fn = plain.find(e)) fn(nullptr, combination{}, true, e, std::nullopt, nullptr);
+        });
+        bench_dispatch_loop(s, "event_dispatch/dense_captureless" + n, events, [&](categorized_event_t e) {
+            if(event_function_ref fn = captureless.find(e)) fn(nullptr, combination{}, true, e, std::nullopt, nullptr);
+        });
+        bench_dispatch_loop(s, "event_dispatch/dense_stateful" + n, events, [&](categorized_event_t e) {
+            if(event_function_ref fn = stateful.find(e)) fn(nullptr, combination{}, true, e, std::nullopt, nullptr);
+        });
+        bench::do_not_optimize(stateful_count);
+    }
+}
+
+
+namespace {
+    //What SIRIUS_INPUT_LATENCY_STATS adds per measurement
+    void bench_latency_stats(bench::suite& s) {
+        constexpr std::size_t samples = 1024;
+        const std::unique_ptr<acma::input::latency_histogram> histogram = std::make_unique<acma::input::latency_histogram>();
+        s.run("latency_stats/record", samples, 0, [&]{
+            for(std::size_t i = 0; i < samples; ++i) histogram->record(std::chrono::nanoseconds{static_cast<std::int64_t>(i * 37)});
+            bench::clobber_memory();
+        });
+        s.run("latency_stats/timer_and_record", samples, 0, [&]{
+            for(std::size_t i = 0; i < samples; ++i) {
+                const acma::input::impl::latency_timer timer;
+                timer.stop(*histogram);
+            }
+            bench::clobber_memory();
+        });
+        s.run("latency_stats/summary", 1, 0, [&]{
+            acma::input::latency_summary summary = histogram->summary();
+            bench::do_not_optimize(&summary);
+        });
+    }
+}
+
+
+int main(int argc, char** argv) {
+    bench::suite s(argc, argv);
+
+    bench_binding_map(s, 16);
+    bench_binding_map(s, 256);
+    bench_binding_map(s, 4096);
+    bench_event_queue(s);
+    bench_combination_state(s);
+    bench_event_dispatch(s, 1);
+    bench_event_dispatch(s, 4);
+    bench_event_dispatch(s, 16);
+    bench_latency_stats(s);
+
+    return s.finish();
+}
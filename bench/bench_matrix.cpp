@@ -0,0 +1,98 @@
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <sirius/arith/matrix.hpp>
+#include <sirius/arith/vector.hpp>
+
+#include "bench_harness.hpp"
+
+
+//Compares the SIMD matrix kernels against the generic loops they replaced. Names are matrix/<operation>/mat<N>/<form>
+namespace {
+    constexpr std::size_t count = 1 << 10;
+
+    //The generic triple loop that matrix::operator* used before the SIMD kernels
+    template<std::size_t M, std::size_t N, std::size_t P, typename T>
+    acma::matrix<M, P, T> generic_mult(acma::matrix<M, N, T> const& lhs, acma::matrix<N, P, T> const& rhs) {
+        acma::matrix<M, P, T> ret;
+        for(std::size_t i = 0; i < M; ++i)
+            for(std::size_t j = 0; j < P; ++j) {
+                T acc = lhs[i][N - 1] * rhs[N - 1][j];
+                for(std::size_t k = N - 1; k-- > 0;) acc = lhs[i][k] * rhs[k][j] + acc;
+                ret[i][j] = acc;
+            }
+        return ret;
+    }
+
+    //Diagonally dominant (so invertible and well-conditioned), with the last row of an affine transformation so that both inverses
+    //apply. Products, inverses and repeated inversions all stay well within range
+    template<std::size_t N>
+    std::vector<acma::matrix<N, N, float>> make_matrices() {
+        std::vector<acma::matrix<N, N, float>> ret(count);
+        for(std::size_t i = 0; i < count; ++i)
+            for(std::size_t r = 0; r < N; ++r)
+                for(std::size_t c = 0; c < N; ++c) {
+                    if(r == N - 1) ret[i][r][c] = c == N - 1 ? 1.f : 0.f;
+                    else ret[i][r][c] = r == c ? 2.f + static_cast<float>(i % 5) * .25f : static_cast<float>((i + r * N + c) % 7) * .05f;
+                }
+        return ret;
+    }
+
+    template<typename T>
+    void done(std::vector<T>& out) {
+        bench::do_not_optimize(out.data());
+        bench::clobber_memory();
+    }
+
+
+    template<std::size_t N>
+    void bench_mult(bench::suite& s) {
+        const std::vector<acma::matrix<N, N, float>> mats = make_matrices<N>();
+        std::vector<acma::matrix<N, N, float>> out(mats.size());
+        const std::string name = "matrix/multiply/mat" + std::to_string(N);
+        constexpr std::size_t bytes = 3 * sizeof(mats[0]);
+
+        s.run(name + "/generic", count - 1, bytes, [&]{ for(std::size_t i = 0; i + 1 < count; ++i) out[i] = generic_mult(mats[i], mats[i + 1]); done(out); });
+        s.run(name + "/simd", count - 1, bytes, [&]{ for(std::size_t i = 0; i + 1 < count; ++i) out[i] = mats[i] * mats[i + 1]; done(out); });
+    }
+
+    void bench_transform(bench::suite& s) {
+        const std::vector<acma::mat4<float>> mats = make_matrices<4>();
+        std::vector<acma::vec4<float>> src(count), dst(count);
+        for(std::size_t i = 0; i < count; ++i) src[i] = {static_cast<float>(i), 1.f, 2.f, 1.f};
+        constexpr std::size_t bytes = 2 * sizeof(src[0]);
+
+        s.run("matrix/transform_shared/mat4/loop", count, bytes, [&]{
+            for(std::size_t i = 0; i < count; ++i) static_cast<acma::mat4<float>::column_type&>(dst[i]) = mats[0] * src[i];
+            done(dst);
+        });
+        s.run("matrix/transform_shared/mat4/batch", count, bytes, [&]{ acma::transform<4, float>(std::span{mats.data(), 1}, src, dst); done(dst); });
+        s.run("matrix/transform_each/mat4/loop", count, bytes + sizeof(mats[0]), [&]{
+            for(std::size_t i = 0; i < count; ++i) static_cast<acma::mat4<float>::column_type&>(dst[i]) = mats[i] * src[i];
+            done(dst);
+        });
+        s.run("matrix/transform_each/mat4/batch", count, bytes + sizeof(mats[0]), [&]{ acma::transform<4, float>(mats, src, dst); done(dst); });
+    }
+
+    void bench_inverse(bench::suite& s) {
+        std::vector<acma::mat4<float>> mats = make_matrices<4>();
+        constexpr std::size_t bytes = 2 * sizeof(mats[0]);
+
+        //Inverting in place alternates between the matrices and their inverses, which are just as well-conditioned
+        s.run("matrix/inverse/mat4/general", count, bytes, [&]{ for(acma::mat4<float>& m : mats) m = m.inverse(); done(mats); });
+        s.run("matrix/inverse/mat4/affine", count, bytes, [&]{ for(acma::mat4<float>& m : mats) m = m.affine_inverse(); done(mats); });
+    }
+}
+
+
+int main(int argc, char** argv) {
+    bench::suite s(argc, argv);
+    bench_mult<3>(s);
+    bench_mult<4>(s);
+    bench_transform(s);
+    bench_inverse(s);
+    return s.finish();
+}
@@ -0,0 +1,147 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sirius/core/window.hpp>
+#include <sirius/input/category.hpp>
+#include <sirius/input/code.hpp>
+#include <sirius/input/coalescing.hpp>
+#include <sirius/input/combination.hpp>
+#include <sirius/input/event_queue.hpp>
+#include <sirius/input/recording.hpp>
+
+#include "bench_harness.hpp"
+
+
+namespace {
+    using namespace acma::input;
+
+    //A synthetic session: a 1000Hz mouse (with 8000Hz bursts), typing with and without modifiers, clicks and scrolls
+    std::vector<event_record> make_session(std::size_t count, std::mt19937& rng) noexcept {
+        std::vector<event_record> ret;
+        ret.reserve(count);
+        std::uint32_t time_us = 0;
+        acma::pt2d cursor{400, 300};
+        const auto add = [&](code_t code, std::uint8_t action, std::optional<acma::pt2d> aux = std::nullopt) noexcept {
+            ret.push_back(event_record{aux.value_or(acma::pt2d{}), time_us, code, action, aux.has_value()});
+        };
+
+        while(ret.size() < count) {
+            switch(rng() % 16) {
+            case 0: {
+                const code_t modifier = rng() % 2 ? key_code::kb_left_ctrl : key_code::kb_left_shift;
+                const code_t key = static_cast<code_t>(key_code::kb_a + rng() % 26);
+                add(modifier, input_action::press);
+                time_us += 30000;
+                add(key, input_action::press);
+                time_us += 60000;
+                add(key, input_action::release);
+                add(modifier, input_action::release);
+                break;
+            }
+            case 1: case 2: {
+                const code_t key = static_cast<code_t>(key_code::kb_a + rng() % 26);
+                add(key, input_action::press);
+                time_us += 50000 + rng() % 50000;
+                add(key, input_action::release);
+                break;
+            }
+            case 3:
+                add(mouse_code::button_1, input_action::press);
+                time_us += 80000;
+                add(mouse_code::button_1, input_action::release);
+                break;
+            case 4:
+                for(std::size_t i = 0; i < 8; ++i, time_us += 8000) add(mouse_code::scroll, input_action::press_release, acma::pt2d{0, -1});
+                break;
+            default: {
+                const std::uint32_t period_us = rng() % 4 == 0 ? 125 : 1000;
+                for(std::size_t i = 0; i < 64; ++i, time_us += period_us) {
+                    cursor += acma::pt2d{static_cast<double>(rng() % 7) - 3, static_cast<double>(rng() % 7) - 3};
+                    add(mouse_code::move, input_action::press_release, cursor);
+                }
+                break;
+            }
+            }
+            time_us += rng() % 20000;
+        }
+        return ret;
+    }
+
+
+    void bind(acma::window& w, combination c, event_id_t id, std::size_t& invoked) noexcept {
+        event_set& set = w.input_active_bindings()[c];
+        set.applicable_categories.set(category::system);
+        set.event_ids[category::system] = id;
+        w.input_event_functions().try_emplace(categorized_event_t{id, category::system}, [&invoked](void*, combination, bool, categorized_event_t, mouse_aux_t, void*) {
+            ++invoked;
+        });
+    }
+}
+
+
+int main(int argc, char** argv) {
+    bench::suite s(argc, argv);
+
+    //Replays a recording saved with window::record_input instead, if set
+    std::vector<event_record> session;
+    if(char const* path = std::getenv("BENCH_INPUT_RECORDING")) {
+        acma::result<std::vector<event_record>> loaded = load_recording(path);
+        if(!loaded.has_value()) {
+            std::fprintf(stderr, "could not load input recording %s\n", path);
+            return EXIT_FAILURE;
+        }
+        session = *std::move(loaded);
+    }
+    else {
+        std::mt19937 rng(42);
+        session = make_session(1 << 16, rng);
+    }
+
+    const std::vector<std::byte> encoded = encode_recording(session);
+    std::vector<event_record> decoded;
+    s.run("replay/encode", session.size(), sizeof(event_record), [&]{
+        std::vector<std::byte> bytes = encode_recording(session);
+        bench::do_not_optimize(bytes.data());
+    });
+    s.run("replay/decode", session.size(), sizeof(event_record), [&]{
+        decoded = *decode_recording(encoded);
+        bench::do_not_optimize(decoded.data());
+    });
+    if(decoded.size() != session.size()) {
+        std::fprintf(stderr, "recording round trip mismatch\n");
+        return EXIT_FAILURE;
+    }
+
+
+    //A headless window: no GLFW window, surface or swap chain behind it
+    acma::window w;
+    std::size_t invoked = 0;
+    bind(w, combination{{generic_code::any}, generic_code::any}, 0, invoked);
+    for(code_t key = key_code::kb_a; key <= key_code::kb_z; ++key) {
+        bind(w, combination{{key_code::kb_left_ctrl}, key}, 1, invoked);
+        bind(w, combination{{key_code::kb_left_shift}, key}, 2, invoked);
+    }
+    bind(w, combination{{}, mouse_code::move}, 3, invoked);
+    bind(w, combination{{key_code::kb_left_shift}, mouse_code::move}, 4, invoked);
+    bind(w, combination{{}, mouse_code::scroll}, 5, invoked);
+
+    //ns/op is per recorded event, so coalescing shows up as fewer event functions invoked per event
+    const auto replay = [&](std::string const& name, coalesce_mode mode) {
+        w.input_coalescing() = coalesce_policy{.mode = mode};
+        invoked = 0;
+        s.run(name, session.size(), sizeof(event_record), [&]{ w.replay_input(session); });
+        bench::do_not_optimize(invoked);
+    };
+    replay("replay/full/coalesce_off", coalesce_mode::off);
+    replay("replay/full/coalesce_per_interval", coalesce_mode::per_interval);
+
+    return s.finish();
+}
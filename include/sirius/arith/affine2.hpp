@@ -0,0 +1,78 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+#include "sirius/arith/matrix.hpp"
+#include "sirius/arith/point.hpp"
+#include "sirius/arith/rect.hpp"
+#include "sirius/arith/vector.hpp"
+
+
+namespace acma {
+    //2D affine transformation, i.e. a 3x3 matrix whose last row is implicitly [0 0 1].
+    //Stored column-major as 3 columns of 2 (indexed [column][row]), which is the layout of a GLSL mat3x2 in a std430/scalar block,
+    //so it can be written to a buffer segment as-is (and applied in a shader with `m * vec3(p, 1)`)
+    template<typename T>
+    struct affine2 : public std::array<std::array<T, 2>, 3> {
+        constexpr static std::size_t rows = 2;
+        constexpr static std::size_t columns = 3;
+        using column_type = std::array<T, 2>;
+        using flattened_type = std::array<T, rows * columns>;
+
+    public:
+        constexpr flattened_type flatten() const noexcept { return std::bit_cast<flattened_type>(*this); }
+        constexpr explicit operator flattened_type() const noexcept { return flatten(); }
+
+        //The last row of a 3x3 matrix is dropped (i.e. it is assumed to be [0 0 1])
+        template<std::size_t M>
+        constexpr static affine2 from_matrix(matrix<M, 3, T> const& m) noexcept requires (M == 2 || M == 3);
+        template<std::size_t M>
+        constexpr explicit operator matrix<M, 3, T>() const noexcept requires (M == 2 || M == 3);
+
+    public:
+        consteval static affine2 identity() noexcept;
+
+        constexpr static affine2 scaling(std::array<T, 2> scale_vec) noexcept;
+        template<typename A, typename FS, typename FC> requires std::is_arithmetic_v<std::remove_cvref_t<A>>
+        constexpr static affine2 rotating(A&& angle, FS&& sin_fn, FC&& cos_fn) noexcept;
+        constexpr static affine2 translating(std::array<T, 2> translate_vec) noexcept;
+
+        //lhs * rhs, i.e. rhs is applied first
+        constexpr static affine2 composed(affine2 const& lhs, affine2 const& rhs) noexcept;
+
+    public:
+        constexpr T determinant() const noexcept { return (*this)[0][0] * (*this)[1][1] - (*this)[1][0] * (*this)[0][1]; }
+        //The result is not finite if the transformation is singular (i.e. determinant() == 0)
+        constexpr affine2 inverse() const noexcept;
+
+        //Applies only the linear part (i.e. for directions and sizes)
+        constexpr vector<2, T> apply_linear(vector<2, T> v) const noexcept;
+
+    public:
+        friend constexpr affine2 operator*(affine2 const& lhs, affine2 const& rhs) noexcept { return composed(lhs, rhs); }
+        friend constexpr point2<T> operator*(affine2 const& lhs, point2<T> rhs) noexcept {
+            return {lhs[0][0] * rhs[0] + lhs[1][0] * rhs[1] + lhs[2][0], lhs[0][1] * rhs[0] + lhs[1][1] * rhs[1] + lhs[2][1]};
+        }
+    };
+
+    template<typename T> using aff2 = affine2<T>;
+    using vk_affine2 = affine2<float>;
+}
+
+
+namespace acma {
+    //Batched application. Like the span transform_bounds below, this stops at the end of the shorter span, leaving the rest of dst untouched
+    template<typename T>
+    constexpr void transform(affine2<T> const& m, std::span<point2<T> const> src, std::span<point2<T>> dst) noexcept;
+
+    //Smallest axis-aligned rect containing each transformed rect
+    template<typename T>
+    constexpr rect<T> transform_bounds(affine2<T> const& m, rect<T> const& r) noexcept;
+    template<typename T>
+    constexpr void transform_bounds(affine2<T> const& m, std::span<rect<T> const> src, std::span<rect<T>> dst) noexcept;
+}
+
+
+#include "sirius/arith/affine2.inl"
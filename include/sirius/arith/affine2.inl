@@ -0,0 +1,139 @@
+#pragma once
+#include "sirius/arith/affine2.hpp"
+#include <algorithm>
+#include <utility>
+
+
+namespace acma {
+    template<typename T>
+    template<std::size_t M>
+    constexpr affine2<T> affine2<T>::from_matrix(matrix<M, 3, T> const& m) noexcept requires (M == 2 || M == 3) {
+        return {{{
+            {{m[0][0], m[1][0]}},
+            {{m[0][1], m[1][1]}},
+            {{m[0][2], m[1][2]}},
+        }}};
+    }
+
+    template<typename T>
+    template<std::size_t M>
+    constexpr affine2<T>::operator matrix<M, 3, T>() const noexcept requires (M == 2 || M == 3) {
+        matrix<M, 3, T> ret{};
+        for(std::size_t i = 0; i < 2; ++i)
+            for(std::size_t j = 0; j < 3; ++j)
+                ret[i][j] = (*this)[j][i];
+        if constexpr(M == 3) ret[2][2] = 1;
+        return ret;
+    }
+}
+
+
+namespace acma {
+    template<typename T>
+    consteval affine2<T> affine2<T>::identity() noexcept {
+        return {{{{{1, 0}}, {{0, 1}}, {{0, 0}}}}};
+    }
+
+    template<typename T>
+    constexpr affine2<T> affine2<T>::scaling(std::array<T, 2> scale_vec) noexcept {
+        return {{{{{scale_vec[0], 0}}, {{0, scale_vec[1]}}, {{0, 0}}}}};
+    }
+
+    template<typename T>
+    template<typename A, typename FS, typename FC> requires std::is_arithmetic_v<std::remove_cvref_t<A>>
+    constexpr affine2<T> affine2<T>::rotating(A&& angle, FS&& sin_fn, FC&& cos_fn) noexcept {
+        //Same convention as matrix<2, 2, T>::rotating
+        T s = static_cast<T>(std::forward<FS>(sin_fn)(std::forward<A>(angle)));
+        T c = static_cast<T>(std::forward<FC>(cos_fn)(std::forward<A>(angle)));
+        return {{{{{c, s}}, {{-s, c}}, {{0, 0}}}}};
+    }
+
+    template<typename T>
+    constexpr affine2<T> affine2<T>::translating(std::array<T, 2> translate_vec) noexcept {
+        return {{{{{1, 0}}, {{0, 1}}, {{translate_vec[0], translate_vec[1]}}}}};
+    }
+
+
+    template<typename T>
+    constexpr affine2<T> affine2<T>::composed(affine2 const& lhs, affine2 const& rhs) noexcept {
+        affine2 ret;
+        for(std::size_t j = 0; j < 3; ++j)
+            for(std::size_t i = 0; i < 2; ++i)
+                ret[j][i] = lhs[0][i] * rhs[j][0] + lhs[1][i] * rhs[j][1];
+        ret[2][0] += lhs[2][0];
+        ret[2][1] += lhs[2][1];
+        return ret;
+    }
+
+
+    template<typename T>
+    constexpr affine2<T> affine2<T>::inverse() const noexcept {
+        //[L t]^-1 = [L^-1  -L^-1 t]
+        auto const& m = *this;
+        const T inv_det = static_cast<T>(1) / determinant();
+        const T a =  m[1][1] * inv_det, c = -m[1][0] * inv_det;
+        const T b = -m[0][1] * inv_det, d =  m[0][0] * inv_det;
+        return {{{
+            {{a, b}},
+            {{c, d}},
+            {{-(a * m[2][0] + c * m[2][1]), -(b * m[2][0] + d * m[2][1])}},
+        }}};
+    }
+
+    template<typename T>
+    constexpr vector<2, T> affine2<T>::apply_linear(vector<2, T> v) const noexcept {
+        return {(*this)[0][0] * v[0] + (*this)[1][0] * v[1], (*this)[0][1] * v[0] + (*this)[1][1] * v[1]};
+    }
+}
+
+
+namespace acma {
+    template<typename T>
+    constexpr void transform(affine2<T> const& m, std::span<point2<T> const> src, std::span<point2<T>> dst) noexcept {
+        static_assert(sizeof(point2<T>) == 2 * sizeof(T));
+        const T m00 = m[0][0], m01 = m[0][1], m10 = m[1][0], m11 = m[1][1], tx = m[2][0], ty = m[2][1];
+        //Cast rather than going through the first point, which doesn't exist when a span is empty
+        T const* s = reinterpret_cast<T const*>(src.data());
+        T* d = reinterpret_cast<T*>(dst.data());
+        const std::size_t count = std::min(src.size(), dst.size());
+        #pragma omp simd
+        for(std::size_t i = 0; i < count; ++i) {
+            const T x = s[2 * i + 0], y = s[2 * i + 1];
+            d[2 * i + 0] = m00 * x + m10 * y + tx;
+            d[2 * i + 1] = m01 * x + m11 * y + ty;
+        }
+    }
+
+
+    template<typename T>
+    constexpr rect<T> transform_bounds(affine2<T> const& m, rect<T> const& r) noexcept {
+        //Transform the center, then project the half extents onto each axis with the absolute linear part
+        constexpr auto abs = [](T t) noexcept { return t < 0 ? -t : t; };
+        const T hx = r.size[0] / 2, hy = r.size[1] / 2;
+        const T cx = r.pos[0] + hx, cy = r.pos[1] + hy;
+        const T ex = abs(m[0][0]) * hx + abs(m[1][0]) * hy, ey = abs(m[0][1]) * hx + abs(m[1][1]) * hy;
+        const T x = m[0][0] * cx + m[1][0] * cy + m[2][0], y = m[0][1] * cx + m[1][1] * cy + m[2][1];
+        return {x - ex, y - ey, 2 * ex, 2 * ey};
+    }
+
+    template<typename T>
+    constexpr void transform_bounds(affine2<T> const& m, std::span<rect<T> const> src, std::span<rect<T>> dst) noexcept {
+        static_assert(sizeof(rect<T>) == 4 * sizeof(T));
+        constexpr auto abs = [](T t) noexcept { return t < 0 ? -t : t; };
+        const T m00 = m[0][0], m01 = m[0][1], m10 = m[1][0], m11 = m[1][1], tx = m[2][0], ty = m[2][1];
+        const T a00 = abs(m00), a01 = abs(m01), a10 = abs(m10), a11 = abs(m11);
+        T const* s = reinterpret_cast<T const*>(src.data());
+        T* d = reinterpret_cast<T*>(dst.data());
+        const std::size_t count = std::min(src.size(), dst.size());
+        #pragma omp simd
+        for(std::size_t i = 0; i < count; ++i) {
+            const T hx = s[4 * i + 2] / 2, hy = s[4 * i + 3] / 2;
+            const T cx = s[4 * i + 0] + hx, cy = s[4 * i + 1] + hy;
+            const T ex = a00 * hx + a10 * hy, ey = a01 * hx + a11 * hy;
+            d[4 * i + 0] = m00 * cx + m10 * cy + tx - ex;
+            d[4 * i + 1] = m01 * cx + m11 * cy + ty - ey;
+            d[4 * i + 2] = 2 * ex;
+            d[4 * i + 3] = 2 * ey;
+        }
+    }
+}
@@ -0,0 +1,214 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "sirius/arith/vector.hpp"
+#include "sirius/arith/matrix.hpp"
+#include "sirius/traits/vector_traits.hpp"
+
+
+namespace acma::impl {
+    template<typename T>
+    struct is_matrix_specialization : std::false_type {};
+    template<std::size_t M, std::size_t N, typename T>
+    struct is_matrix_specialization<matrix<M, N, T>> : std::true_type {};
+
+
+    //Every operand is viewed as a flat, row-major sequence of lanes. Scalars broadcast to every lane
+    template<typename V>
+    struct expression_shape {
+        constexpr static std::size_t rows = 0, columns = 0;
+        using value_type = V;
+    };
+
+    template<std::size_t Dims, typename T, vec_data_type HoldsData, std::uint8_t TransformFlags>
+    struct expression_shape<vector<Dims, T, HoldsData, TransformFlags>> {
+        constexpr static std::size_t rows = Dims, columns = 1;
+        using value_type = T;
+        template<typename U> using rebind = vector<Dims, U, HoldsData, TransformFlags>;
+    };
+
+    template<std::size_t M, std::size_t N, typename T>
+    struct expression_shape<matrix<M, N, T>> {
+        constexpr static std::size_t rows = M, columns = N;
+        using value_type = T;
+        template<typename U> using rebind = matrix<M, N, U>;
+    };
+
+    template<typename E> requires lazy_expression<E>
+    struct expression_shape<E> : expression_shape<typename E::result_type> {};
+
+    template<typename V>
+    using expression_shape_t = expression_shape<std::remove_cvref_t<V>>;
+
+
+    template<typename V>
+    concept expression_scalar = std::is_arithmetic_v<std::remove_cvref_t<V>>;
+    template<typename V>
+    concept expression_vector = is_vector_specialization<typename expression_shape_t<V>::template rebind<int>>::value;
+    template<typename V>
+    concept expression_matrix = is_matrix_specialization<typename expression_shape_t<V>::template rebind<int>>::value;
+    template<typename V>
+    concept expression_operand = expression_scalar<V> || expression_vector<V> || expression_matrix<V>;
+
+
+    template<typename V>
+    constexpr decltype(auto) expression_lane(V const& v, std::size_t i) noexcept {
+        if constexpr(std::is_arithmetic_v<V>) return v;
+        else if constexpr(lazy_expression<V> || is_vector_specialization<V>::value) return v[i];
+        else return v[i / V::columns][i % V::columns];
+    }
+
+    template<typename V>
+    constexpr decltype(auto) expression_lane(V& v, std::size_t i) noexcept requires (!std::is_const_v<V>) {
+        if constexpr(is_vector_specialization<V>::value) return v[i];
+        else return v[i / V::columns][i % V::columns];
+    }
+
+
+    //Lvalue operands are held by reference; temporaries are moved into the expression so that it never dangles
+    template<typename V>
+    using expression_storage_t = std::conditional_t<std::is_lvalue_reference_v<V> && !lazy_expression<V>, std::remove_reference_t<V> const&, std::remove_cvref_t<V>>;
+
+    //Same as above, but nested expressions are evaluated into their result
+    template<typename V>
+    struct evaluated_storage { using type = expression_storage_t<V>; };
+    template<typename V> requires lazy_expression<V>
+    struct evaluated_storage<V> { using type = typename std::remove_cvref_t<V>::result_type; };
+
+    template<typename V>
+    using evaluated_storage_t = typename evaluated_storage<V>::type;
+}
+
+
+namespace acma::impl {
+    //The result of an elementwise operation follows the same rules as the eager operators:
+    //the non-scalar operand (preferring the left hand side) decides the kind of vector or matrix
+    template<typename Op, typename L, typename R>
+    struct elementwise_expression_result {
+        using shape = std::conditional_t<expression_scalar<L>, expression_shape_t<R>, expression_shape_t<L>>;
+        using value_type = decltype(std::declval<Op>()(std::declval<typename expression_shape_t<L>::value_type>(), std::declval<typename expression_shape_t<R>::value_type>()));
+        using type = typename shape::template rebind<value_type>;
+    };
+
+    template<typename Op, typename L, typename R>
+    concept elementwise_expression_compatible = expression_operand<L> && expression_operand<R> && !(expression_scalar<L> && expression_scalar<R>) && (
+        expression_scalar<L> || expression_scalar<R> ||
+        (expression_shape_t<L>::rows == expression_shape_t<R>::rows && expression_shape_t<L>::columns == expression_shape_t<R>::columns)
+    ) && !(expression_matrix<L> && expression_matrix<R> && std::is_same_v<Op, std::multiplies<>>);
+
+    //matrix * matrix and (square) matrix * column vector
+    template<typename L, typename R>
+    struct product_expression_result {
+        using value_type = decltype(std::declval<typename expression_shape_t<L>::value_type>() * std::declval<typename expression_shape_t<R>::value_type>());
+        using type = std::conditional_t<expression_vector<R>,
+            typename expression_shape_t<R>::template rebind<value_type>,
+            matrix<expression_shape_t<L>::rows, expression_shape_t<R>::columns, value_type>
+        >;
+    };
+
+    template<typename L, typename R>
+    concept product_expression_compatible = expression_matrix<L> && expression_shape_t<L>::columns == expression_shape_t<R>::rows && (
+        expression_matrix<R> || (expression_vector<R> && expression_shape_t<L>::rows == expression_shape_t<L>::columns)
+    );
+}
+
+
+namespace acma {
+    //Lazily evaluated arithmetic on vectors and matrices.
+    //Nothing is computed until the expression is converted to (or assigned into) a concrete vector or matrix,
+    //at which point the entire chain is evaluated lane by lane in a single loop without any intermediate temporaries.
+    template<typename Result, typename Derived>
+    struct expression : impl::expression_base {
+        using result_type = Result;
+        using value_type = typename impl::expression_shape<Result>::value_type;
+        constexpr static std::size_t lanes = impl::expression_shape<Result>::rows * impl::expression_shape<Result>::columns;
+
+    public:
+        constexpr result_type eval() const noexcept {
+            result_type ret;
+            for(std::size_t i = 0; i < lanes; ++i) impl::expression_lane(ret, i) = static_cast<Derived const&>(*this)[i];
+            return ret;
+        }
+        constexpr operator result_type() const noexcept { return eval(); }
+    };
+
+
+    template<typename V>
+    struct terminal_expression : expression<std::remove_cvref_t<V>, terminal_expression<V>> {
+        constexpr explicit terminal_expression(V&& v) noexcept : value(std::forward<V>(v)) {}
+        constexpr decltype(auto) operator[](std::size_t i) const noexcept { return impl::expression_lane(value, i); }
+
+        impl::expression_storage_t<V> value;
+    };
+
+    template<typename Op, typename L, typename R>
+    struct elementwise_expression : expression<typename impl::elementwise_expression_result<Op, L, R>::type, elementwise_expression<Op, L, R>> {
+        constexpr elementwise_expression(L&& l, R&& r) noexcept : lhs(std::forward<L>(l)), rhs(std::forward<R>(r)) {}
+        constexpr auto operator[](std::size_t i) const noexcept { return Op{}(impl::expression_lane(lhs, i), impl::expression_lane(rhs, i)); }
+
+        impl::expression_storage_t<L> lhs;
+        impl::expression_storage_t<R> rhs;
+    };
+
+    //Each lane of a product reads an entire row and column, so its operands are evaluated once up front instead of being recomputed for every lane
+    template<typename L, typename R>
+    struct product_expression : expression<typename impl::product_expression_result<L, R>::type, product_expression<L, R>> {
+    private:
+        constexpr static std::size_t inner   = impl::expression_shape_t<L>::columns;
+        constexpr static std::size_t columns = impl::expression_shape_t<R>::columns;
+
+    public:
+        constexpr product_expression(L&& l, R&& r) noexcept : lhs(std::forward<L>(l)), rhs(std::forward<R>(r)) {}
+        constexpr auto operator[](std::size_t i) const noexcept {
+            const std::size_t row = i / columns, column = i % columns;
+            auto ret = impl::expression_lane(lhs, row * inner) * impl::expression_lane(rhs, column);
+            for(std::size_t k = 1; k < inner; ++k)
+                ret += impl::expression_lane(lhs, row * inner + k) * impl::expression_lane(rhs, k * columns + column);
+            return ret;
+        }
+
+        impl::evaluated_storage_t<L> lhs;
+        impl::evaluated_storage_t<R> rhs;
+    };
+
+    template<typename E>
+    struct negated_expression : expression<typename std::remove_cvref_t<E>::result_type, negated_expression<E>> {
+        constexpr explicit negated_expression(E&& e) noexcept : operand(std::forward<E>(e)) {}
+        constexpr auto operator[](std::size_t i) const noexcept { return -operand[i]; }
+
+        impl::expression_storage_t<E> operand;
+    };
+}
+
+namespace acma {
+    //Starts a lazily evaluated expression (e.g. `vector4f v = lazy(a) * 2.f + b;`)
+    template<typename V> requires (impl::expression_vector<V> || impl::expression_matrix<V>) && (!impl::lazy_expression<V>)
+    constexpr terminal_expression<V> lazy(V&& v) noexcept { return terminal_expression<V>(std::forward<V>(v)); }
+
+    template<typename V>
+    constexpr auto eval(V&& v) noexcept {
+        if constexpr(impl::lazy_expression<V>) return v.eval();
+        else return std::remove_cvref_t<V>(std::forward<V>(v));
+    }
+}
+
+namespace acma {
+    template<typename L, typename R> requires (impl::lazy_expression<L> || impl::lazy_expression<R>) && impl::elementwise_expression_compatible<std::plus<>, L, R>
+    constexpr elementwise_expression<std::plus<>, L, R> operator+(L&& lhs, R&& rhs) noexcept { return {std::forward<L>(lhs), std::forward<R>(rhs)}; }
+    template<typename L, typename R> requires (impl::lazy_expression<L> || impl::lazy_expression<R>) && impl::elementwise_expression_compatible<std::minus<>, L, R>
+    constexpr elementwise_expression<std::minus<>, L, R> operator-(L&& lhs, R&& rhs) noexcept { return {std::forward<L>(lhs), std::forward<R>(rhs)}; }
+    template<typename L, typename R> requires (impl::lazy_expression<L> || impl::lazy_expression<R>) && impl::elementwise_expression_compatible<std::multiplies<>, L, R>
+    constexpr elementwise_expression<std::multiplies<>, L, R> operator*(L&& lhs, R&& rhs) noexcept { return {std::forward<L>(lhs), std::forward<R>(rhs)}; }
+    template<typename L, typename R> requires (impl::lazy_expression<L> || impl::lazy_expression<R>) && impl::elementwise_expression_compatible<std::divides<>, L, R>
+    constexpr elementwise_expression<std::divides<>, L, R> operator/(L&& lhs, R&& rhs) noexcept { return {std::forward<L>(lhs), std::forward<R>(rhs)}; }
+
+    template<typename L, typename R> requires (impl::lazy_expression<L> || impl::lazy_expression<R>) && impl::product_expression_compatible<L, R>
+    constexpr product_expression<L, R> operator*(L&& lhs, R&& rhs) noexcept { return {std::forward<L>(lhs), std::forward<R>(rhs)}; }
+
+    template<typename E> requires impl::lazy_expression<E>
+    constexpr negated_expression<E> operator-(E&& e) noexcept { return negated_expression<E>(std::forward<E>(e)); }
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace acma::impl {
+    //Integer arguments are computed (and returned) as double, like the <cmath> overloads
+    template<typename T>
+    using math_float_t = std::conditional_t<std::is_integral_v<T>, double, T>;
+
+    //Double precision implementations used for constant evaluation
+    constexpr double constexpr_sin(double x) noexcept;
+    constexpr double constexpr_cos(double x) noexcept;
+    constexpr double constexpr_atan2(double y, double x) noexcept;
+    constexpr double constexpr_sqrt(double x) noexcept;
+
+    //Single precision, branchless implementations used by the fast tier
+    constexpr float fast_sin(float x) noexcept;
+    constexpr float fast_cos(float x) noexcept;
+    constexpr float fast_atan2(float y, float x) noexcept;
+    constexpr float fast_rsqrt(float x) noexcept;
+    constexpr float fast_sqrt(float x) noexcept;
+}
+
+
+namespace acma::impl {
+    struct sin_fn {
+        template<typename T> requires std::is_arithmetic_v<T>
+        constexpr math_float_t<T> operator()(T x) const noexcept {
+            using F = math_float_t<T>;
+            if consteval { return static_cast<F>(constexpr_sin(static_cast<double>(x))); }
+            else { return std::sin(static_cast<F>(x)); }
+        }
+    };
+
+    struct cos_fn {
+        template<typename T> requires std::is_arithmetic_v<T>
+        constexpr math_float_t<T> operator()(T x) const noexcept {
+            using F = math_float_t<T>;
+            if consteval { return static_cast<F>(constexpr_cos(static_cast<double>(x))); }
+            else { return std::cos(static_cast<F>(x)); }
+        }
+    };
+
+    struct atan2_fn {
+        template<typename T> requires std::is_arithmetic_v<T>
+        constexpr math_float_t<T> operator()(T y, T x) const noexcept {
+            using F = math_float_t<T>;
+            if consteval { return static_cast<F>(constexpr_atan2(static_cast<double>(y), static_cast<double>(x))); }
+            else { return std::atan2(static_cast<F>(y), static_cast<F>(x)); }
+        }
+    };
+
+    struct sqrt_fn {
+        template<typename T> requires std::is_arithmetic_v<T>
+        constexpr math_float_t<T> operator()(T x) const noexcept {
+            using F = math_float_t<T>;
+            if consteval { return static_cast<F>(constexpr_sqrt(static_cast<double>(x))); }
+            else { return std::sqrt(static_cast<F>(x)); }
+        }
+    };
+
+    struct rsqrt_fn {
+        template<typename T> requires std::is_arithmetic_v<T>
+        constexpr math_float_t<T> operator()(T x) const noexcept {
+            using F = math_float_t<T>;
+            if consteval { return static_cast<F>(1. / constexpr_sqrt(static_cast<double>(x))); }
+            else { return static_cast<F>(1) / std::sqrt(static_cast<F>(x)); }
+        }
+    };
+
+
+    template<float(*Fn)(float)>
+    struct fast_math_fn {
+        template<typename T> requires std::is_arithmetic_v<T>
+        constexpr math_float_t<T> operator()(T x) const noexcept { return static_cast<math_float_t<T>>(Fn(static_cast<float>(x))); }
+    };
+
+    struct fast_atan2_fn {
+        template<typename T> requires std::is_arithmetic_v<T>
+        constexpr math_float_t<T> operator()(T y, T x) const noexcept { return static_cast<math_float_t<T>>(fast_atan2(static_cast<float>(y), static_cast<float>(x))); }
+    };
+}
+
+
+//Math functions that can be passed anywhere a sin_fn, cos_fn or sqrt_fn is taken (e.g. matrix::rotating or normalized).
+//The precision tier is picked per call site:
+// - acma::math::xxx can be used in constant expressions (e.g. consteval matrix builders) and defers to <cmath> at runtime.
+//   Constant evaluation is done in double precision, so float results are within 1 ulp. Double results are within 1 ulp for sqrt
+//   (correctly rounded without -ffast-math), 2.5 ulp for sin and cos (for |x| < 2^20, above which the argument reduction loses
+//   precision) and 3 ulp for atan2
+// - acma::math::fast::xxx are branchless single precision approximations that vectorize in omp simd loops, even without -ffast-math.
+//   Double arguments are computed in single precision. The error bounds are listed with each of them
+namespace acma::math {
+    inline constexpr impl::sin_fn sin{};
+    inline constexpr impl::cos_fn cos{};
+    inline constexpr impl::atan2_fn atan2{};
+    inline constexpr impl::sqrt_fn sqrt{};
+    inline constexpr impl::rsqrt_fn rsqrt{};
+}
+
+namespace acma::math::fast {
+    //Absolute error below 1e-7 for |x| < 2^20
+    inline constexpr impl::fast_math_fn<impl::fast_sin> sin{};
+    inline constexpr impl::fast_math_fn<impl::fast_cos> cos{};
+    //Absolute error below 3e-7 radians. atan2(0, 0) is 0 (or pi if x is -0)
+    inline constexpr impl::fast_atan2_fn atan2{};
+    //Relative error below 2e-7 for finite x > 0. rsqrt(0) is finite rather than infinity, but sqrt(0) is still 0
+    inline constexpr impl::fast_math_fn<impl::fast_rsqrt> rsqrt{};
+    inline constexpr impl::fast_math_fn<impl::fast_sqrt> sqrt{};
+}
+
+
+#include "sirius/arith/math.inl"
@@ -0,0 +1,214 @@
+#pragma once
+#include "sirius/arith/math.hpp"
+#include <array>
+#include <bit>
+#include <limits>
+#include <numbers>
+
+
+namespace acma::impl {
+    //fdlibm's pi/2 split into 33, 33 and 53 bits, so that j * pio2_1 and j * pio2_2 are exact for |j| < 2^20
+    constexpr double pio2_1 = 1.57079632673412561417e+00, pio2_2 = 6.07710050630396597660e-11, pio2_2t = 2.02226624879595063154e-21;
+
+    //Returns x - j * pi/2 (in [-pi/4, pi/4]) and sets j to the quadrant
+    constexpr double constexpr_reduce_half_pi(double x, std::int64_t& j) noexcept {
+        j = static_cast<std::int64_t>(x * (2 / std::numbers::pi) + (x < 0 ? -.5 : .5));
+        //Separate statements, so that -ffast-math doesn't fold the 3 parts back together
+        const double d = static_cast<double>(j);
+        const double r1 = x - d * pio2_1;
+        const double r2 = r1 - d * pio2_2;
+        return r2 - d * pio2_2t;
+    }
+
+    //1 / n!, starting at n = First and stepping by 2
+    template<int First, std::size_t N>
+    consteval std::array<double, N> constexpr_inverse_factorials() noexcept {
+        std::array<double, N> ret;
+        double factorial = 1;
+        for(int n = 2; n <= First - 2; ++n) factorial *= n;
+        for(std::size_t k = 0; k < N; ++k) {
+            const int n = First + 2 * static_cast<int>(k);
+            factorial *= (n - 1) * n;
+            ret[k] = 1 / factorial;
+        }
+        return ret;
+    }
+
+    //Taylor series for |r| <= pi/4, using Horner's method on the tail and adding the leading terms last to keep the rounding error low
+    constexpr double constexpr_sin_series(double r) noexcept {
+        constexpr std::array<double, 10> c = constexpr_inverse_factorials<3, 10>();
+        const double z = r * r;
+        double p = c[c.size() - 1];
+        for(std::size_t k = c.size() - 1; k-- > 0;) p = p * -z + c[k];
+        return r - r * z * p;
+    }
+
+    constexpr double constexpr_cos_series(double r) noexcept {
+        constexpr std::array<double, 10> c = constexpr_inverse_factorials<4, 10>();
+        const double z = r * r;
+        double p = c[c.size() - 1];
+        for(std::size_t k = c.size() - 1; k-- > 0;) p = p * -z + c[k];
+        //1 - z/2, keeping the rounding error of the subtraction
+        const double hz = .5 * z, w = 1 - hz;
+        return w + (((1 - w) - hz) + z * z * p);
+    }
+
+    constexpr double constexpr_sin(double x) noexcept {
+        if(x != x || x == std::numeric_limits<double>::infinity() || x == -std::numeric_limits<double>::infinity()) return std::numeric_limits<double>::quiet_NaN();
+        std::int64_t j;
+        const double r = constexpr_reduce_half_pi(x, j);
+        switch(j & 3) {
+        case 0:  return  constexpr_sin_series(r);
+        case 1:  return  constexpr_cos_series(r);
+        case 2:  return -constexpr_sin_series(r);
+        default: return -constexpr_cos_series(r);
+        }
+    }
+
+    constexpr double constexpr_cos(double x) noexcept {
+        if(x != x || x == std::numeric_limits<double>::infinity() || x == -std::numeric_limits<double>::infinity()) return std::numeric_limits<double>::quiet_NaN();
+        std::int64_t j;
+        const double r = constexpr_reduce_half_pi(x, j);
+        switch(j & 3) {
+        case 0:  return  constexpr_cos_series(r);
+        case 1:  return -constexpr_sin_series(r);
+        case 2:  return -constexpr_cos_series(r);
+        default: return  constexpr_sin_series(r);
+        }
+    }
+
+
+    //pi/2, pi/6 and pi as a double plus the (rounded) remainder
+    constexpr double pio2_hi = 1.57079632679489655800e+00, pio2_lo = 6.12323399573676603587e-17;
+    constexpr double pio6_hi = 5.23598775598298815659e-01, pio6_lo = 5.74182141399611043013e-17;
+    constexpr double pi_hi = 3.14159265358979311600e+00, pi_lo = 1.22464679914735320717e-16;
+
+    //atan(a) for a in [0, 1], reduced to |t| <= 2 - sqrt(3) with atan(a) = pi/6 + atan((sqrt(3) * a - 1) / (sqrt(3) + a))
+    constexpr double constexpr_atan01(double a) noexcept {
+        constexpr double sqrt3 = std::numbers::sqrt3;
+        const bool reduce = a > 2 - sqrt3;
+        const double t = reduce ? (sqrt3 * a - 1) / (sqrt3 + a) : a;
+        const double z = t * t;
+        double p = 1. / 63;
+        for(int k = 30; k > 0; --k) p = p * -z + 1. / (2 * k + 1);
+        const double sum = t - t * z * p;
+        return reduce ? pio6_hi + (sum + pio6_lo) : sum;
+    }
+
+    constexpr double constexpr_atan2(double y, double x) noexcept {
+        if(x != x || y != y) return std::numeric_limits<double>::quiet_NaN();
+        const bool x_negative = std::bit_cast<std::uint64_t>(x) >> 63, y_negative = std::bit_cast<std::uint64_t>(y) >> 63;
+        const double ax = x_negative ? -x : x, ay = y_negative ? -y : y;
+        const double mx = ax > ay ? ax : ay, mn = ax > ay ? ay : ax;
+
+        double a = 0;
+        if(mx == std::numeric_limits<double>::infinity()) a = mn == mx ? 1 : 0;
+        else if(mx != 0) a = mn / mx;
+
+        double r = constexpr_atan01(a);
+        if(ay > ax) r = (pio2_hi - r) + pio2_lo;
+        if(x_negative) r = (pi_hi - r) + pi_lo;
+        return y_negative ? -r : r;
+    }
+
+
+    constexpr double constexpr_sqrt(double x) noexcept {
+        if(x < 0 || x != x) return std::numeric_limits<double>::quiet_NaN();
+        if(x == 0 || x == std::numeric_limits<double>::infinity()) return x;
+
+        //Halving the exponent gives a starting point within a factor of 2, so Newton's method converges in a few iterations
+        double y = std::bit_cast<double>((std::bit_cast<std::uint64_t>(x) >> 1) + (0x3ff0000000000000ull >> 1));
+        for(int i = 0; i < 8; ++i) y = .5 * (y + x / y);
+
+        //Newton's method can stop 1 ulp away, so pick whichever neighbour has the smallest (exact) residual x - y^2
+        constexpr auto residual = [](double x, double y) noexcept {
+            //Dekker's exact product: y^2 = p + e
+            const double split = y * 134217729., hi = split - (split - y), lo = y - hi;
+            const double p = y * y, e = ((hi * hi - p) + 2 * hi * lo) + lo * lo;
+            const double r = (x - p) - e;
+            return r < 0 ? -r : r;
+        };
+        const std::uint64_t bits = std::bit_cast<std::uint64_t>(y);
+        const double below = std::bit_cast<double>(bits - 1), above = std::bit_cast<double>(bits + 1);
+        const double r = residual(x, y), r_below = residual(x, below), r_above = residual(x, above);
+        if(r_below < r && r_below <= r_above) return below;
+        if(r_above < r) return above;
+        return y;
+    }
+}
+
+
+namespace acma::impl {
+    //Bitwise select. Plain ternaries get turned back into branches around the (possibly trapping) arithmetic feeding them,
+    //which stops GCC from vectorizing the loop unless -fno-trapping-math is set
+    constexpr float fast_select(bool condition, float if_true, float if_false) noexcept {
+        const std::uint32_t mask = 0u - static_cast<std::uint32_t>(condition);
+        return std::bit_cast<float>((std::bit_cast<std::uint32_t>(if_true) & mask) | (std::bit_cast<std::uint32_t>(if_false) & ~mask));
+    }
+
+    //Done in double precision rather than with a split pi/2 like Cephes, since -ffast-math reassociates the split back into a single
+    //(inexact) constant. The product is then exact enough for any |x| < 2^20
+    constexpr float fast_reduce_half_pi(float x, std::int32_t& j) noexcept {
+        const float half = std::bit_cast<float>(std::bit_cast<std::uint32_t>(.5f) | (std::bit_cast<std::uint32_t>(x) & 0x80000000u));
+        j = static_cast<std::int32_t>(x * (2.f * std::numbers::inv_pi_v<float>) + half);
+        return static_cast<float>(static_cast<double>(x) - static_cast<double>(j) * (std::numbers::pi / 2));
+    }
+
+    //Cephes' sinf/cosf minimax polynomials for |r| <= pi/4
+    constexpr float fast_sin_poly(float r, float z) noexcept { return r + r * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f)); }
+    constexpr float fast_cos_poly(float z) noexcept { return 1.f - .5f * z + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f)); }
+
+    //Negates f if bit 1 of q is set
+    constexpr float fast_flip_sign(float f, std::int32_t q) noexcept {
+        return std::bit_cast<float>(std::bit_cast<std::uint32_t>(f) ^ (static_cast<std::uint32_t>(q & 2) << 30));
+    }
+
+    constexpr float fast_sin(float x) noexcept {
+        std::int32_t j;
+        const float r = fast_reduce_half_pi(x, j);
+        const float z = r * r;
+        return fast_flip_sign(fast_select(j & 1, fast_cos_poly(z), fast_sin_poly(r, z)), j);
+    }
+
+    constexpr float fast_cos(float x) noexcept {
+        std::int32_t j;
+        const float r = fast_reduce_half_pi(x, j);
+        const float z = r * r;
+        return fast_flip_sign(fast_select(j & 1, fast_sin_poly(r, z), fast_cos_poly(z)), j + 1);
+    }
+
+
+    constexpr float fast_atan2(float y, float x) noexcept {
+        const std::uint32_t x_bits = std::bit_cast<std::uint32_t>(x), y_bits = std::bit_cast<std::uint32_t>(y);
+        const float ax = std::bit_cast<float>(x_bits & 0x7fffffffu), ay = std::bit_cast<float>(y_bits & 0x7fffffffu);
+        const bool steep = ay > ax;
+        const float mx = fast_select(steep, ay, ax), mn = fast_select(steep, ax, ay);
+        const float a = mn / fast_select(mx > 0.f, mx, 1.f);
+
+        //Cephes' atanf: reduce [tan(pi/8), 1] with atan(a) = pi/4 + atan((a - 1) / (a + 1))
+        const bool reduce = a > 0.4142135623730950f;
+        const float t = fast_select(reduce, (a - 1.f) / (a + 1.f), a);
+        const float z = t * t;
+        float r = (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) * z * t + t;
+        r += fast_select(reduce, std::numbers::pi_v<float> / 4, 0.f);
+
+        r = fast_select(steep, std::numbers::pi_v<float> / 2 - r, r);
+        r = fast_select(x_bits >> 31, std::numbers::pi_v<float> - r, r);
+        return std::bit_cast<float>(std::bit_cast<std::uint32_t>(r) ^ (y_bits & 0x80000000u));
+    }
+
+
+    constexpr float fast_rsqrt(float x) noexcept {
+        //Bit-level initial guess (within 3.5%), then Newton's method
+        float y = std::bit_cast<float>(0x5f375a86u - (std::bit_cast<std::uint32_t>(x) >> 1));
+        const float half_x = .5f * x;
+        y = y * (1.5f - half_x * y * y);
+        y = y * (1.5f - half_x * y * y);
+        y = y * (1.5f - half_x * y * y);
+        return y;
+    }
+
+    constexpr float fast_sqrt(float x) noexcept {
+        return x * fast_rsqrt(x);
+    }
+}
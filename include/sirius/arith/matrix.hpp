@@ -2,6 +2,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <type_traits>
 #include <utility>
 #include <streamline/metaprogramming/constant.hpp>
@@ -9,6 +10,14 @@
 #include "sirius/arith/point.hpp"
 #include "sirius/arith/vector.hpp"
 #include "sirius/arith/axis.hpp"
+#include "sirius/arith/simd.hpp"
+
+
+namespace acma::impl {
+    template<std::size_t M, std::size_t N, std::size_t P, typename T>
+    concept simd_matrix_compatible = (std::is_same_v<T, float> || std::is_same_v<T, double>) && 
+        (M >= 3 && M <= 4) && (N >= 3 && N <= 4) && (P >= 3 && P <= 4);
+}
 
 
 namespace acma {
@@ -57,9 +66,19 @@ namespace acma {
         constexpr static matrix<M, N, T> orthographic(T screen_width, T screen_height, T near_z, T far_z) noexcept requires (M == N && N == 4);
         constexpr static matrix<M, N, T> orthographic(T screen_width, T screen_height) noexcept requires (M == N && N == 4);
 
+        //Composes two affine 3x4 transformations, treating both as 4x4 matrices with an implicit [0 0 0 1] last row
+        constexpr static matrix<M, N, T> composed(matrix<M, N, T> const& lhs, matrix<M, N, T> const& rhs) noexcept requires (M == 3 && N == 4);
+
+
+    public:
+        constexpr T determinant() const noexcept requires (M == N && N >= 2 && N <= 4);
+        //Closed-form cofactor inverse. The result is not finite if the matrix is singular (i.e. determinant() == 0)
+        constexpr matrix<M, N, T> inverse() const noexcept requires (M == N && N >= 2 && N <= 4);
+        //Inverse for affine transformations, whose last row is [0 ... 0 1] (or implicit for 3x4). Only inverts the linear part, so the last row stays exact
+        constexpr matrix<M, N, T> affine_inverse() const noexcept requires ((M == N && (N == 3 || N == 4)) || (M == 3 && N == 4));
+
 
     public:
-        //TODO use SIMD (i.e. target_clones)
         friend constexpr column_type operator*(matrix<M, N, T> lhs, const column_type& rhs) noexcept {
             return mult(lhs, rhs, std::make_index_sequence<M>{}, sl::size_constant<N>); 
         }
@@ -68,6 +87,9 @@ namespace acma {
         }
         template<std::size_t P>
         friend constexpr matrix<M, P, T> operator*(matrix<M, N, T> lhs, const matrix<N, P, T>& rhs) noexcept {
+            if !consteval {
+                if constexpr(impl::simd_matrix_compatible<M, N, P, T>) return simd_mult(lhs, rhs);
+            }
             return mult(lhs, rhs, std::make_index_sequence<M>{}, sl::size_constant<N>, std::make_index_sequence<P>{});
         }
 
@@ -88,6 +110,10 @@ namespace acma {
         constexpr static row_type mult_mat_cols(MatA&& m_a, MatB&& m_b, sl::size_constant_type<I> i, sl::size_constant_type<K>, std::index_sequence<Js...>) noexcept;
         template<typename MatA, typename MatB, std::size_t... Is, std::size_t K, std::size_t... Js>
         constexpr static matrix<sizeof...(Is), sizeof...(Js), T> mult(MatA&& m_a, MatB&& m_b, std::index_sequence<Is...>, sl::size_constant_type<K>, std::index_sequence<Js...>) noexcept;
+
+        //Each row of the result is a linear combination of the rows of rhs, so every row fits in a single register
+        template<std::size_t P>
+        static matrix<M, P, T> simd_mult(matrix<M, N, T> const& lhs, matrix<N, P, T> const& rhs) noexcept;
     };
 }
 
@@ -100,6 +126,11 @@ namespace acma {
     //TODO flatten/target_clones
     template<std::size_t Dims, typename UnitTy, typename... Args>
     constexpr point<Dims, UnitTy> transform(point<Dims, UnitTy> src_vec, Args&&... args) noexcept;
+
+    //Batched matrix-vector transformation: dst[i] = mats[i] * src[i], or mats[0] * src[i] if only one matrix is given.
+    //Stops at the end of the shortest span (so nothing is written if mats is empty), leaving the rest of dst untouched
+    template<std::size_t N, typename T>
+    constexpr void transform(std::span<matrix<N, N, T> const> mats, std::span<vector<N, T> const> src, std::span<vector<N, T>> dst) noexcept;
 }
 
 
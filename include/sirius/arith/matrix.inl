@@ -3,6 +3,8 @@
 #include "sirius/arith/matrix.hpp"
 #include "sirius/arith/point.hpp"
 #include "sirius/arith/vector.hpp"
+#include <algorithm>
+#include <cstring>
 #include <type_traits>
 #include <utility>
 
@@ -166,6 +168,32 @@ namespace acma {
 }
 
 
+namespace acma {
+    template<std::size_t M, std::size_t N, typename T>
+    template<std::size_t P>
+    matrix<M, P, T> matrix<M,N,T>::simd_mult(matrix<M, N, T> const& lhs, matrix<N, P, T> const& rhs) noexcept {
+        using register_type = impl::simd_register_t<T, 4>;
+        //Build the registers lane by lane rather than with a partial (12 byte) copy, which would stall store forwarding
+        const auto load_row = [](std::array<T, P> const& row) noexcept {
+            if constexpr(P == 4) return register_type{row[0], row[1], row[2], row[3]};
+            else return register_type{row[0], row[1], row[2], 0};
+        };
+
+        register_type rhs_rows[N];
+        for(std::size_t k = 0; k < N; ++k) rhs_rows[k] = load_row(rhs[k]);
+
+        //mult_mat is a right fold, so accumulate from the last term backwards to match the generic path exactly
+        matrix<M, P, T> ret;
+        for(std::size_t i = 0; i < M; ++i) {
+            register_type acc = lhs[i][N - 1] * rhs_rows[N - 1];
+            for(std::size_t k = N - 1; k-- > 0;)
+                acc = lhs[i][k] * rhs_rows[k] + acc;
+            for(std::size_t j = 0; j < P; ++j) ret[i][j] = acc[j];
+        }
+        return ret;
+    }
+}
+
 
 namespace acma {
     template<std::size_t M, std::size_t N, typename T>
@@ -362,3 +390,161 @@ namespace acma {
 }
 
 
+
+namespace acma {
+    template<std::size_t M, std::size_t N, typename T>
+    constexpr matrix<M, N, T> matrix<M, N, T>::composed(matrix<M, N, T> const& lhs, matrix<M, N, T> const& rhs) noexcept requires (M == 3 && N == 4) {
+        matrix<M, N, T> ret;
+        for(std::size_t i = 0; i < 3; ++i) {
+            for(std::size_t j = 0; j < 4; ++j)
+                ret[i][j] = lhs[i][0] * rhs[0][j] + lhs[i][1] * rhs[1][j] + lhs[i][2] * rhs[2][j];
+            ret[i][3] += lhs[i][3];
+        }
+        return ret;
+    }
+}
+
+
+namespace acma {
+    template<std::size_t M, std::size_t N, typename T>
+    constexpr T matrix<M, N, T>::determinant() const noexcept requires (M == N && N >= 2 && N <= 4) {
+        auto const& m = *this;
+        if constexpr(N == 2) {
+            return m[0][0] * m[1][1] - m[0][1] * m[1][0];
+        }
+        else if constexpr(N == 3) {
+            return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+                 - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+                 + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+        }
+        else {
+            //Laplace expansion over the 2x2 minors of the top two and bottom two rows
+            T s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+            T s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+            T s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+            T s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+            T s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+            T s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+            T c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+            T c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+            T c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+            T c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+            T c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+            T c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+            return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        }
+    }
+
+    template<std::size_t M, std::size_t N, typename T>
+    constexpr matrix<M, N, T> matrix<M, N, T>::inverse() const noexcept requires (M == N && N >= 2 && N <= 4) {
+        auto const& m = *this;
+        if constexpr(N == 2) {
+            const T inv_det = static_cast<T>(1) / determinant();
+            return {{{
+                {{ m[1][1] * inv_det, -m[0][1] * inv_det}},
+                {{-m[1][0] * inv_det,  m[0][0] * inv_det}},
+            }}};
+        }
+        else if constexpr(N == 3) {
+            const T inv_det = static_cast<T>(1) / determinant();
+            return {{{
+                {{(m[1][1] * m[2][2] - m[1][2] * m[2][1]) * inv_det, (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inv_det, (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inv_det}},
+                {{(m[1][2] * m[2][0] - m[1][0] * m[2][2]) * inv_det, (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv_det, (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv_det}},
+                {{(m[1][0] * m[2][1] - m[1][1] * m[2][0]) * inv_det, (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv_det, (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv_det}},
+            }}};
+        }
+        else {
+            //Same minors as determinant(), reused for every cofactor
+            T s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+            T s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+            T s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+            T s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+            T s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+            T s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+            T c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+            T c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+            T c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+            T c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+            T c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+            T c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+            const T inv_det = static_cast<T>(1) / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+            return {{{
+                {{( m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3) * inv_det, (-m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3) * inv_det, ( m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3) * inv_det, (-m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3) * inv_det}},
+                {{(-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1) * inv_det, ( m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1) * inv_det, (-m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1) * inv_det, ( m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1) * inv_det}},
+                {{( m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0) * inv_det, (-m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0) * inv_det, ( m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0) * inv_det, (-m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0) * inv_det}},
+                {{(-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0) * inv_det, ( m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0) * inv_det, (-m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0) * inv_det, ( m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0) * inv_det}},
+            }}};
+        }
+    }
+
+    template<std::size_t M, std::size_t N, typename T>
+    constexpr matrix<M, N, T> matrix<M, N, T>::affine_inverse() const noexcept requires ((M == N && (N == 3 || N == 4)) || (M == 3 && N == 4)) {
+        //[L t]^-1 = [L^-1  -L^-1 t], with L^-1 as the adjugate over the determinant of L.
+        //Only the linear block's cofactors are computed, and the result is built in one aggregate like inverse(): filling in a
+        //zeroed matrix element by element leaves narrow stores that the copy out of it can't forward from
+        auto const& m = *this;
+        if constexpr(N == 3) {
+            const T inv_det = static_cast<T>(1) / (m[0][0] * m[1][1] - m[0][1] * m[1][0]);
+            const T i00 =  m[1][1] * inv_det, i01 = -m[0][1] * inv_det;
+            const T i10 = -m[1][0] * inv_det, i11 =  m[0][0] * inv_det;
+            const T tx = m[0][2], ty = m[1][2];
+            return {{{
+                {{i00, i01, -(i00 * tx + i01 * ty)}},
+                {{i10, i11, -(i10 * tx + i11 * ty)}},
+                {{0, 0, 1}},
+            }}};
+        }
+        else {
+            const T c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+            const T c10 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+            const T c20 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+            const T inv_det = static_cast<T>(1) / (m[0][0] * c00 + m[0][1] * c10 + m[0][2] * c20);
+            const T i00 = c00 * inv_det, i01 = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inv_det, i02 = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inv_det;
+            const T i10 = c10 * inv_det, i11 = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv_det, i12 = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv_det;
+            const T i20 = c20 * inv_det, i21 = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv_det, i22 = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv_det;
+            const T tx = m[0][3], ty = m[1][3], tz = m[2][3];
+            if constexpr(M == N) return {{{
+                {{i00, i01, i02, -(i00 * tx + i01 * ty + i02 * tz)}},
+                {{i10, i11, i12, -(i10 * tx + i11 * ty + i12 * tz)}},
+                {{i20, i21, i22, -(i20 * tx + i21 * ty + i22 * tz)}},
+                {{0, 0, 0, 1}},
+            }}};
+            else return {{{
+                {{i00, i01, i02, -(i00 * tx + i01 * ty + i02 * tz)}},
+                {{i10, i11, i12, -(i10 * tx + i11 * ty + i12 * tz)}},
+                {{i20, i21, i22, -(i20 * tx + i21 * ty + i22 * tz)}},
+            }}};
+        }
+    }
+}
+
+
+namespace acma {
+    template<std::size_t N, typename T>
+    constexpr void transform(std::span<matrix<N, N, T> const> mats, std::span<vector<N, T> const> src, std::span<vector<N, T>> dst) noexcept {
+        const auto transform_one = [](matrix<N, N, T> const& m, vector<N, T> const& v, vector<N, T>& out) noexcept {
+            //Same (right fold) order as mult_row
+            for(std::size_t r = 0; r < N; ++r) {
+                T acc = m[r][N - 1] * v[N - 1];
+                for(std::size_t c = N - 1; c-- > 0;) acc = m[r][c] * v[c] + acc;
+                out[r] = acc;
+            }
+        };
+
+        //Only as many vectors as every span can hold are transformed
+        std::size_t count = std::min(src.size(), dst.size());
+        if(mats.empty()) return;
+        if(mats.size() != 1) count = std::min(count, mats.size());
+
+        //Vectorized across the batch (rather than within a single matrix-vector product), which keeps every lane busy without any horizontal adds
+        if(mats.size() == 1) {
+            const matrix<N, N, T> m = mats[0];
+            #pragma omp simd
+            for(std::size_t i = 0; i < count; ++i) transform_one(m, src[i], dst[i]);
+        }
+        else {
+            #pragma omp simd
+            for(std::size_t i = 0; i < count; ++i) transform_one(mats[i], src[i], dst[i]);
+        }
+    }
+}
@@ -0,0 +1,179 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include "sirius/arith/vector.hpp"
+#include "sirius/traits/packed_traits.hpp"
+
+
+namespace acma::impl {
+    //Round to nearest even, with overflow to infinity and NaNs kept as (quiet) NaNs
+    constexpr std::uint16_t float_to_half_bits(float f) noexcept;
+    constexpr float half_bits_to_float(std::uint16_t h) noexcept;
+}
+
+
+//Compact vertex/instance data types that map directly to a VkFormat (see packed_traits).
+//None of these do arithmetic: pack once on the CPU and let the GPU unpack them (either via vertex
+//attribute formats or the helpers in shaders/packing.glsl)
+namespace acma {
+    //IEEE 754 binary16
+    struct half {
+        using storage_type = std::uint16_t;
+        storage_type value = 0;
+
+    public:
+        constexpr half() noexcept = default;
+        constexpr explicit half(float f) noexcept : value(encode(f)) {}
+        constexpr static half from_bits(storage_type b) noexcept { half ret; ret.value = b; return ret; }
+
+        constexpr explicit operator float() const noexcept { return decode(value); }
+        constexpr bool operator==(half const&) const noexcept = default;
+
+    public:
+        constexpr static storage_type encode(float f) noexcept { return impl::float_to_half_bits(f); }
+        constexpr static float decode(storage_type b) noexcept { return impl::half_bits_to_float(b); }
+    };
+
+    //[0, 1] stored as [0, max]
+    template<typename T>
+    struct unorm {
+        static_assert(std::is_unsigned_v<T>, "unorm requires an unsigned integer type");
+        using storage_type = T;
+        constexpr static float max = static_cast<float>(std::numeric_limits<T>::max());
+        storage_type value = 0;
+
+    public:
+        constexpr unorm() noexcept = default;
+        constexpr explicit unorm(float f) noexcept : value(encode(f)) {}
+
+        constexpr explicit operator float() const noexcept { return decode(value); }
+        constexpr bool operator==(unorm const&) const noexcept = default;
+
+    public:
+        constexpr static storage_type encode(float f) noexcept { return static_cast<T>((f > 1.f ? 1.f : (f > 0.f ? f : 0.f)) * max + .5f); }
+        constexpr static float decode(storage_type v) noexcept { return v / max; }
+    };
+
+    //[-1, 1] stored as [-max, max] (both -max and -max - 1 unpack to -1)
+    template<typename T>
+    struct snorm {
+        static_assert(std::is_signed_v<T> && std::is_integral_v<T>, "snorm requires a signed integer type");
+        using storage_type = T;
+        constexpr static float max = static_cast<float>(std::numeric_limits<T>::max());
+        storage_type value = 0;
+
+    public:
+        constexpr snorm() noexcept = default;
+        constexpr explicit snorm(float f) noexcept : value(encode(f)) {}
+
+        constexpr explicit operator float() const noexcept { return decode(value); }
+        constexpr bool operator==(snorm const&) const noexcept = default;
+
+    public:
+        constexpr static storage_type encode(float f) noexcept { return static_cast<T>((f > 1.f ? 1.f : (f < -1.f ? -1.f : f)) * max + (f < 0.f ? -.5f : .5f)); }
+        constexpr static float decode(storage_type v) noexcept { const float f = v / max; return f < -1.f ? -1.f : f; }
+    };
+
+    using unorm8  = unorm<std::uint8_t>;
+    using unorm16 = unorm<std::uint16_t>;
+    using snorm8  = snorm<std::int8_t>;
+    using snorm16 = snorm<std::int16_t>;
+}
+
+
+namespace acma {
+    template<std::size_t Dims, typename ComponentT>
+    struct packed_vector : public std::array<ComponentT, Dims> {
+        static_assert(Dims > 0 && Dims <= 4, "packed_vector must have 1 to 4 components");
+        constexpr static std::size_t dimensions = Dims;
+        using component_type = ComponentT;
+        using unpacked_type = typename impl::packed_traits<packed_vector>::unpacked_type;
+        constexpr static VkFormat format = impl::packed_traits<packed_vector>::format;
+
+    public:
+        constexpr packed_vector() noexcept = default;
+        constexpr explicit packed_vector(unpacked_type const& v) noexcept;
+
+        constexpr unpacked_type unpack() const noexcept;
+        constexpr bool operator==(packed_vector const&) const noexcept = default;
+    };
+
+    using half2     = packed_vector<2, half>;
+    using half3     = packed_vector<3, half>;
+    using half4     = packed_vector<4, half>;
+    using unorm8x2  = packed_vector<2, unorm8>;
+    using unorm8x4  = packed_vector<4, unorm8>;
+    using unorm16x2 = packed_vector<2, unorm16>;
+    using unorm16x4 = packed_vector<4, unorm16>;
+    using snorm8x2  = packed_vector<2, snorm8>;
+    using snorm8x4  = packed_vector<4, snorm8>;
+    using snorm16x2 = packed_vector<2, snorm16>;
+    using snorm16x4 = packed_vector<4, snorm16>;
+
+
+    //10-bit unorm x, y and z with a 2-bit unorm w, in a single uint32 (w in the top 2 bits and x in the bottom 10)
+    struct a2b10g10r10 {
+        using unpacked_type = typename impl::packed_traits<a2b10g10r10>::unpacked_type;
+        constexpr static VkFormat format = impl::packed_traits<a2b10g10r10>::format;
+        std::uint32_t bits = 0;
+
+    public:
+        constexpr a2b10g10r10() noexcept = default;
+        constexpr explicit a2b10g10r10(unpacked_type const& v) noexcept : bits(encode(v)) {}
+
+        constexpr unpacked_type unpack() const noexcept { return decode(bits); }
+        constexpr bool operator==(a2b10g10r10 const&) const noexcept = default;
+
+    public:
+        constexpr static std::uint32_t encode(unpacked_type const& v) noexcept;
+        constexpr static unpacked_type decode(std::uint32_t b) noexcept;
+    };
+
+
+    //Unit vector projected onto an octahedron and unfolded into a square, so that it fits in 2 snorm components.
+    //The angular error is below 0.05 degrees with snorm16 components and 1 degree with snorm8 components
+    template<typename ComponentT>
+    struct oct_normal {
+        using component_type = ComponentT;
+        using unpacked_type = typename impl::packed_traits<oct_normal>::unpacked_type;
+        constexpr static VkFormat format = impl::packed_traits<oct_normal>::format;
+        packed_vector<2, ComponentT> encoded;
+
+    public:
+        constexpr oct_normal() noexcept = default;
+        //n does not need to be normalized, but must not be 0
+        constexpr explicit oct_normal(unpacked_type const& n) noexcept : encoded(project(n)) {}
+
+        //Normalized
+        unpacked_type unpack() const noexcept { return unproject(encoded.unpack()); }
+        constexpr bool operator==(oct_normal const&) const noexcept = default;
+
+    public:
+        //To and from the unfolded octahedron (i.e. [-1, 1]^2) before quantization
+        constexpr static vector<2, float> project(unpacked_type const& n) noexcept;
+        static unpacked_type unproject(vector<2, float> e) noexcept;
+    };
+
+    using oct_normal8  = oct_normal<snorm8>;
+    using oct_normal16 = oct_normal<snorm16>;
+}
+
+
+namespace acma {
+    //Bulk conversions, straight-line omp simd loops (for filling mapped buffers directly). Only as many values as both src and dst
+    //hold are converted, so the rest of the longer span is left as is
+    template<impl::packed_type PackedT>
+    void pack(std::span<typename impl::packed_traits<PackedT>::unpacked_type const> src, std::span<PackedT> dst) noexcept;
+    template<impl::packed_type PackedT>
+    void unpack(std::span<PackedT const> src, std::span<typename impl::packed_traits<PackedT>::unpacked_type> dst) noexcept;
+}
+
+
+#include "sirius/arith/packed.inl"
@@ -0,0 +1,170 @@
+#pragma once
+#include "sirius/arith/packed.hpp"
+#include <cmath>
+
+
+namespace acma::impl {
+    //Both conversions are branchless so that the bulk loops vectorize
+    constexpr std::uint16_t float_to_half_bits(float f) noexcept {
+        const std::uint32_t x = std::bit_cast<std::uint32_t>(f);
+        const std::uint32_t sign = (x >> 16) & 0x8000u;
+        const std::uint32_t a = x & 0x7fffffffu;
+
+        //Rebias the exponent (from 127 to 15), rounding the dropped mantissa bits to nearest even
+        const std::uint32_t normal = (a - 0x38000000u + 0xfffu + ((a >> 13) & 1u)) >> 13;
+        //Below 2^-14 the result is subnormal: adding 0.5f (whose ulp is the smallest subnormal half) lets the FPU do the rounding
+        const std::uint32_t subnormal = std::bit_cast<std::uint32_t>(std::bit_cast<float>(a) + .5f) - 0x3f000000u;
+        //65520 and above round to infinity
+        const std::uint32_t inf_nan = a > 0x7f800000u ? 0x7e00u : 0x7c00u;
+
+        const std::uint32_t h = a >= 0x477ff000u ? inf_nan : (a < 0x38800000u ? subnormal : normal);
+        return static_cast<std::uint16_t>(sign | h);
+    }
+
+    constexpr float half_bits_to_float(std::uint16_t h) noexcept {
+        const std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+        const std::uint32_t shifted = static_cast<std::uint32_t>(h & 0x7fffu) << 13;
+        const std::uint32_t exponent = shifted & 0x0f800000u;
+
+        const std::uint32_t normal = shifted + 0x38000000u;
+        const std::uint32_t inf_nan = shifted + 0x70000000u;
+        //Subnormal halves are normal floats: build 1.mantissa * 2^-14 then subtract the implicit 2^-14
+        const std::uint32_t subnormal = std::bit_cast<std::uint32_t>(std::bit_cast<float>(shifted + 0x38800000u) - std::bit_cast<float>(0x38800000u));
+
+        const std::uint32_t bits = exponent == 0x0f800000u ? inf_nan : (exponent == 0 ? subnormal : normal);
+        return std::bit_cast<float>(sign | bits);
+    }
+}
+
+
+namespace acma {
+    template<std::size_t Dims, typename ComponentT>
+    constexpr packed_vector<Dims, ComponentT>::packed_vector(unpacked_type const& v) noexcept {
+        for(std::size_t i = 0; i < Dims; ++i)
+            (*this)[i].value = ComponentT::encode(v[i]);
+    }
+
+    template<std::size_t Dims, typename ComponentT>
+    constexpr typename packed_vector<Dims, ComponentT>::unpacked_type packed_vector<Dims, ComponentT>::unpack() const noexcept {
+        unpacked_type ret;
+        for(std::size_t i = 0; i < Dims; ++i)
+            ret[i] = ComponentT::decode((*this)[i].value);
+        return ret;
+    }
+
+
+    constexpr std::uint32_t a2b10g10r10::encode(unpacked_type const& v) noexcept {
+        constexpr auto quantize = [](float f, float max) noexcept { return static_cast<std::uint32_t>((f > 1.f ? 1.f : (f > 0.f ? f : 0.f)) * max + .5f); };
+        return quantize(v[0], 1023.f) | (quantize(v[1], 1023.f) << 10) | (quantize(v[2], 1023.f) << 20) | (quantize(v[3], 3.f) << 30);
+    }
+
+    constexpr typename a2b10g10r10::unpacked_type a2b10g10r10::decode(std::uint32_t b) noexcept {
+        return {
+            static_cast<float>(b & 0x3ffu) / 1023.f,
+            static_cast<float>((b >> 10) & 0x3ffu) / 1023.f,
+            static_cast<float>((b >> 20) & 0x3ffu) / 1023.f,
+            static_cast<float>(b >> 30) / 3.f,
+        };
+    }
+
+
+    template<typename ComponentT>
+    constexpr vector<2, float> oct_normal<ComponentT>::project(unpacked_type const& n) noexcept {
+        constexpr auto abs = [](float f) noexcept { return f < 0.f ? -f : f; };
+        constexpr auto sign = [](float f) noexcept { return f < 0.f ? -1.f : 1.f; };
+
+        //Project onto the octahedron |x| + |y| + |z| = 1, then fold the lower hemisphere over the diagonals
+        const float l1 = abs(n[0]) + abs(n[1]) + abs(n[2]);
+        const float px = n[0] / l1, py = n[1] / l1;
+        const bool lower = n[2] < 0.f;
+        return {
+            lower ? (1.f - abs(py)) * sign(px) : px,
+            lower ? (1.f - abs(px)) * sign(py) : py,
+        };
+    }
+
+    template<typename ComponentT>
+    typename oct_normal<ComponentT>::unpacked_type oct_normal<ComponentT>::unproject(vector<2, float> e) noexcept {
+        const float z = 1.f - std::abs(e[0]) - std::abs(e[1]);
+        const float t = z < 0.f ? -z : 0.f;
+        //Unfolds the lower hemisphere (equivalent to (1 - |e.yx|) * sign(e.xy), without the select)
+        const float x = e[0] + (e[0] < 0.f ? t : -t);
+        const float y = e[1] + (e[1] < 0.f ? t : -t);
+        const float inv_len = 1.f / std::sqrt(x * x + y * y + z * z);
+        return {x * inv_len, y * inv_len, z * inv_len};
+    }
+}
+
+
+namespace acma::impl {
+    template<typename T>
+    struct is_packed_vector : std::false_type {};
+    template<std::size_t Dims, typename ComponentT>
+    struct is_packed_vector<packed_vector<Dims, ComponentT>> : std::true_type {};
+
+    template<typename T>
+    struct is_oct_normal : std::false_type {};
+    template<typename ComponentT>
+    struct is_oct_normal<oct_normal<ComponentT>> : std::true_type {};
+}
+
+//The loops work on the underlying storage (rather than constructing each packed type) so that GCC doesn't give up on vectorizing them
+namespace acma {
+    template<impl::packed_type PackedT>
+    void pack(std::span<typename impl::packed_traits<PackedT>::unpacked_type const> src, std::span<PackedT> dst) noexcept {
+        //Only as many values as both spans can hold are converted
+        const std::size_t count = std::min(src.size(), dst.size());
+        if constexpr(impl::is_packed_vector<PackedT>::value) {
+            using component_type = typename PackedT::component_type;
+            using storage_type = typename component_type::storage_type;
+            static_assert(sizeof(PackedT) == sizeof(storage_type) * PackedT::dimensions);
+            float const* s = reinterpret_cast<float const*>(src.data());
+            storage_type* d = reinterpret_cast<storage_type*>(dst.data());
+            #pragma omp simd
+            for(std::size_t i = 0; i < count * PackedT::dimensions; ++i)
+                d[i] = component_type::encode(s[i]);
+        }
+        else if constexpr(impl::is_oct_normal<PackedT>::value) {
+            using storage_type = typename PackedT::component_type::storage_type;
+            storage_type* d = reinterpret_cast<storage_type*>(dst.data());
+            #pragma omp simd
+            for(std::size_t i = 0; i < count; ++i) {
+                const vector<2, float> e = PackedT::project(src[i]);
+                d[2 * i + 0] = PackedT::component_type::encode(e[0]);
+                d[2 * i + 1] = PackedT::component_type::encode(e[1]);
+            }
+        }
+        else {
+            #pragma omp simd
+            for(std::size_t i = 0; i < count; ++i)
+                dst[i].bits = PackedT::encode(src[i]);
+        }
+    }
+
+    template<impl::packed_type PackedT>
+    void unpack(std::span<PackedT const> src, std::span<typename impl::packed_traits<PackedT>::unpacked_type> dst) noexcept {
+        //Only as many values as both spans can hold are converted
+        const std::size_t count = std::min(src.size(), dst.size());
+        if constexpr(impl::is_packed_vector<PackedT>::value) {
+            using component_type = typename PackedT::component_type;
+            using storage_type = typename component_type::storage_type;
+            storage_type const* s = reinterpret_cast<storage_type const*>(src.data());
+            float* d = reinterpret_cast<float*>(dst.data());
+            #pragma omp simd
+            for(std::size_t i = 0; i < count * PackedT::dimensions; ++i)
+                d[i] = component_type::decode(s[i]);
+        }
+        else if constexpr(impl::is_oct_normal<PackedT>::value) {
+            using storage_type = typename PackedT::component_type::storage_type;
+            storage_type const* s = reinterpret_cast<storage_type const*>(src.data());
+            #pragma omp simd
+            for(std::size_t i = 0; i < count; ++i)
+                dst[i] = PackedT::unproject({PackedT::component_type::decode(s[2 * i + 0]), PackedT::component_type::decode(s[2 * i + 1])});
+        }
+        else {
+            #pragma omp simd
+            for(std::size_t i = 0; i < count; ++i)
+                dst[i] = PackedT::decode(src[i].bits);
+        }
+    }
+}
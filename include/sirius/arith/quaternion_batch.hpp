@@ -0,0 +1,101 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "sirius/arith/matrix.hpp"
+#include "sirius/arith/quaternion.hpp"
+
+
+namespace acma {
+    //Non-owning structure-of-arrays view: the s, x, y and z components each live in their own contiguous lane,
+    //so every batch operation is a straight-line loop that processes a full register of quaternions at once (e.g. 8 floats with AVX2)
+    template<typename T>
+    struct quaternion_batch_view {
+        using value_type = std::remove_const_t<T>;
+
+    public:
+        constexpr quaternion_batch_view() noexcept = default;
+        constexpr quaternion_batch_view(T* s, T* x, T* y, T* z, std::size_t count) noexcept : lanes{s, x, y, z}, count(count) {}
+        template<typename U> requires (std::is_const_v<T> && std::is_same_v<U, value_type>)
+        constexpr quaternion_batch_view(quaternion_batch_view<U> other) noexcept : lanes{other.lane(0).data(), other.lane(1).data(), other.lane(2).data(), other.lane(3).data()}, count(other.size()) {}
+
+    public:
+        constexpr std::span<T> lane(std::size_t c) const noexcept { return {lanes[c], count}; }
+        constexpr std::size_t size() const noexcept { return count; }
+        constexpr bool empty() const noexcept { return count == 0; }
+
+        constexpr quaternion<value_type> operator[](std::size_t i) const noexcept { return {lanes[0][i], lanes[1][i], lanes[2][i], lanes[3][i]}; }
+        constexpr void set(std::size_t i, quaternion<value_type> q) const noexcept requires (!std::is_const_v<T>) { for(std::size_t c = 0; c < 4; ++c) lanes[c][i] = q[c]; }
+
+    private:
+        std::array<T*, 4> lanes = {};
+        std::size_t count = 0;
+    };
+
+
+    template<impl::arithmetic T>
+    class quaternion_batch {
+    public:
+        constexpr quaternion_batch() noexcept = default;
+        constexpr explicit quaternion_batch(std::size_t count) noexcept : lanes(4 * count), count(count) {}
+        constexpr quaternion_batch(std::span<quaternion<T> const> quats) noexcept : quaternion_batch(quats.size()) {
+            for(std::size_t i = 0; i < count; ++i) view().set(i, quats[i]);
+        }
+
+    public:
+        constexpr void resize(std::size_t new_size) noexcept;
+
+        constexpr std::size_t size() const noexcept { return count; }
+        constexpr bool empty() const noexcept { return count == 0; }
+
+        constexpr quaternion<T> operator[](std::size_t i) const noexcept { return view()[i]; }
+        constexpr void set(std::size_t i, quaternion<T> q) noexcept { view().set(i, q); }
+
+    public:
+        constexpr quaternion_batch_view<T      > view()       noexcept { T      * p = lanes.data(); return {p, p + count, p + 2 * count, p + 3 * count, count}; }
+        constexpr quaternion_batch_view<T const> view() const noexcept { T const* p = lanes.data(); return {p, p + count, p + 2 * count, p + 3 * count, count}; }
+        constexpr operator quaternion_batch_view<T      >()       noexcept { return view(); }
+        constexpr operator quaternion_batch_view<T const>() const noexcept { return view(); }
+
+    private:
+        std::vector<T> lanes;
+        std::size_t count = 0;
+    };
+}
+
+
+namespace acma {
+    //All of these may be called in place (i.e. dst may alias the inputs). Only as many quaternions as every view (and span of t) holds
+    //are processed, so the rest of a longer dst is left as is.
+    //The inputs accept batches and mutable views directly; dst must be a view (e.g. batch.view())
+    template<typename T> using quaternion_batch_input = std::type_identity_t<quaternion_batch_view<T const>>;
+
+    //dst[i] = lhs[i] * rhs[i] (Hamilton product)
+    template<typename T>
+    constexpr void multiply(quaternion_batch_input<T> lhs, quaternion_batch_input<T> rhs, quaternion_batch_view<T> dst) noexcept;
+
+    template<typename T>
+    void normalize(quaternion_batch_input<T> src, quaternion_batch_view<T> dst) noexcept;
+
+    //Normalized linear interpolation, taking the shortest path
+    template<typename T>
+    void nlerp(quaternion_batch_input<T> a, quaternion_batch_input<T> b, std::span<std::type_identity_t<T> const> t, quaternion_batch_view<T> dst) noexcept;
+    template<typename T>
+    void nlerp(quaternion_batch_input<T> a, quaternion_batch_input<T> b, std::type_identity_t<T> t, quaternion_batch_view<T> dst) noexcept;
+
+    //Spherical linear interpolation, taking the shortest path. Falls back to nlerp for nearly identical rotations
+    template<typename T>
+    void slerp(quaternion_batch_input<T> a, quaternion_batch_input<T> b, std::span<std::type_identity_t<T> const> t, quaternion_batch_view<T> dst) noexcept;
+    template<typename T>
+    void slerp(quaternion_batch_input<T> a, quaternion_batch_input<T> b, std::type_identity_t<T> t, quaternion_batch_view<T> dst) noexcept;
+
+    //dst[i] = to_matrix<N>(src[i])
+    template<std::size_t N, typename T>
+    constexpr void to_matrix(quaternion_batch_view<T> src, std::span<matrix<N, N, std::remove_const_t<T>>> dst) noexcept requires (N == 3 || N == 4);
+}
+
+
+#include "sirius/arith/quaternion_batch.inl"
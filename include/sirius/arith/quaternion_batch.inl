@@ -0,0 +1,138 @@
+#pragma once
+#include "sirius/arith/quaternion_batch.hpp"
+#include <algorithm>
+#include <cmath>
+
+
+namespace acma {
+    template<impl::arithmetic T>
+    constexpr void quaternion_batch<T>::resize(std::size_t new_size) noexcept {
+        std::vector<T> new_lanes(4 * new_size);
+        const std::size_t kept = std::min(count, new_size);
+        for(std::size_t c = 0; c < 4; ++c)
+            std::copy_n(lanes.data() + c * count, kept, new_lanes.data() + c * new_size);
+        lanes = std::move(new_lanes);
+        count = new_size;
+    }
+}
+
+
+namespace acma {
+    template<typename T>
+    constexpr void multiply(quaternion_batch_input<T> lhs, quaternion_batch_input<T> rhs, quaternion_batch_view<T> dst) noexcept {
+        T const* ls = lhs.lane(0).data(); T const* lx = lhs.lane(1).data(); T const* ly = lhs.lane(2).data(); T const* lz = lhs.lane(3).data();
+        T const* rs = rhs.lane(0).data(); T const* rx = rhs.lane(1).data(); T const* ry = rhs.lane(2).data(); T const* rz = rhs.lane(3).data();
+        T* ds = dst.lane(0).data(); T* dx = dst.lane(1).data(); T* dy = dst.lane(2).data(); T* dz = dst.lane(3).data();
+        const std::size_t count = std::min({lhs.size(), rhs.size(), dst.size()});
+
+        #pragma omp simd
+        for(std::size_t i = 0; i < count; ++i) {
+            const T s = ls[i] * rs[i] - lx[i] * rx[i] - ly[i] * ry[i] - lz[i] * rz[i];
+            const T x = ls[i] * rx[i] + lx[i] * rs[i] + ly[i] * rz[i] - lz[i] * ry[i];
+            const T y = ls[i] * ry[i] - lx[i] * rz[i] + ly[i] * rs[i] + lz[i] * rx[i];
+            const T z = ls[i] * rz[i] + lx[i] * ry[i] - ly[i] * rx[i] + lz[i] * rs[i];
+            ds[i] = s; dx[i] = x; dy[i] = y; dz[i] = z;
+        }
+    }
+
+    template<typename T>
+    void normalize(quaternion_batch_input<T> src, quaternion_batch_view<T> dst) noexcept {
+        T const* ss = src.lane(0).data(); T const* sx = src.lane(1).data(); T const* sy = src.lane(2).data(); T const* sz = src.lane(3).data();
+        T* ds = dst.lane(0).data(); T* dx = dst.lane(1).data(); T* dy = dst.lane(2).data(); T* dz = dst.lane(3).data();
+        const std::size_t count = std::min(src.size(), dst.size());
+
+        #pragma omp simd
+        for(std::size_t i = 0; i < count; ++i) {
+            const T inv_len = static_cast<T>(1) / std::sqrt(ss[i] * ss[i] + sx[i] * sx[i] + sy[i] * sy[i] + sz[i] * sz[i]);
+            ds[i] = ss[i] * inv_len; dx[i] = sx[i] * inv_len; dy[i] = sy[i] * inv_len; dz[i] = sz[i] * inv_len;
+        }
+    }
+}
+
+
+namespace acma::impl {
+    //Every lane computes both the slerp and the nlerp weights and selects between them, so that the loop stays branchless
+    template<bool Spherical, typename T, typename TFn>
+    void interpolate(quaternion_batch_view<T const> a, quaternion_batch_view<T const> b, TFn&& t_at, std::size_t t_count, quaternion_batch_view<T> dst) noexcept {
+        //Past this point sin(theta) is too small to divide by accurately
+        constexpr T nlerp_threshold = static_cast<T>(0.9995);
+
+        T const* as = a.lane(0).data(); T const* ax = a.lane(1).data(); T const* ay = a.lane(2).data(); T const* az = a.lane(3).data();
+        T const* bs = b.lane(0).data(); T const* bx = b.lane(1).data(); T const* by = b.lane(2).data(); T const* bz = b.lane(3).data();
+        T* ds = dst.lane(0).data(); T* dx = dst.lane(1).data(); T* dy = dst.lane(2).data(); T* dz = dst.lane(3).data();
+        const std::size_t count = std::min({a.size(), b.size(), t_count, dst.size()});
+
+        #pragma omp simd
+        for(std::size_t i = 0; i < count; ++i) {
+            const T t = t_at(i);
+            T cos_theta = as[i] * bs[i] + ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+            //q and -q are the same rotation, so flip b to take the shortest path
+            const T sign = cos_theta < 0 ? static_cast<T>(-1) : static_cast<T>(1);
+            cos_theta *= sign;
+
+            T wa = static_cast<T>(1) - t, wb = t;
+            if constexpr(Spherical) {
+                const T theta = std::acos(std::min(cos_theta, static_cast<T>(1)));
+                const T inv_sin_theta = static_cast<T>(1) / std::sin(theta);
+                const bool spherical = cos_theta < nlerp_threshold;
+                wa = spherical ? std::sin(wa * theta) * inv_sin_theta : wa;
+                wb = spherical ? std::sin(wb * theta) * inv_sin_theta : wb;
+            }
+            wb *= sign;
+
+            const T s = wa * as[i] + wb * bs[i];
+            const T x = wa * ax[i] + wb * bx[i];
+            const T y = wa * ay[i] + wb * by[i];
+            const T z = wa * az[i] + wb * bz[i];
+            //slerp of unit quaternions is already unit length, but renormalizing keeps both paths consistent and corrects drift
+            const T inv_len = static_cast<T>(1) / std::sqrt(s * s + x * x + y * y + z * z);
+            ds[i] = s * inv_len; dx[i] = x * inv_len; dy[i] = y * inv_len; dz[i] = z * inv_len;
+        }
+    }
+}
+
+namespace acma {
+    template<typename T>
+    void nlerp(quaternion_batch_input<T> a, quaternion_batch_input<T> b, std::span<std::type_identity_t<T> const> t, quaternion_batch_view<T> dst) noexcept {
+        impl::interpolate<false>(a, b, [t](std::size_t i) noexcept { return t[i]; }, t.size(), dst);
+    }
+
+    template<typename T>
+    void nlerp(quaternion_batch_input<T> a, quaternion_batch_input<T> b, std::type_identity_t<T> t, quaternion_batch_view<T> dst) noexcept {
+        impl::interpolate<false>(a, b, [t](std::size_t) noexcept { return t; }, dst.size(), dst);
+    }
+
+    template<typename T>
+    void slerp(quaternion_batch_input<T> a, quaternion_batch_input<T> b, std::span<std::type_identity_t<T> const> t, quaternion_batch_view<T> dst) noexcept {
+        impl::interpolate<true>(a, b, [t](std::size_t i) noexcept { return t[i]; }, t.size(), dst);
+    }
+
+    template<typename T>
+    void slerp(quaternion_batch_input<T> a, quaternion_batch_input<T> b, std::type_identity_t<T> t, quaternion_batch_view<T> dst) noexcept {
+        impl::interpolate<true>(a, b, [t](std::size_t) noexcept { return t; }, dst.size(), dst);
+    }
+}
+
+
+namespace acma {
+    template<std::size_t N, typename T>
+    constexpr void to_matrix(quaternion_batch_view<T> src, std::span<matrix<N, N, std::remove_const_t<T>>> dst) noexcept requires (N == 3 || N == 4) {
+        using U = std::remove_const_t<T>;
+        T const* qs = src.lane(0).data(); T const* qx = src.lane(1).data(); T const* qy = src.lane(2).data(); T const* qz = src.lane(3).data();
+        const std::size_t count = std::min(src.size(), dst.size());
+
+        //Same expressions as the single quaternion to_matrix
+        #pragma omp simd
+        for(std::size_t i = 0; i < count; ++i) {
+            const U s = qs[i], x = qx[i], y = qy[i], z = qz[i];
+            matrix<N, N, U>& m = dst[i];
+            m[0][0] = s * s + x * x - y * y - z * z; m[0][1] = 2 * x * y - 2 * s * z;         m[0][2] = 2 * x * z + 2 * s * y;
+            m[1][0] = 2 * x * y + 2 * s * z;         m[1][1] = s * s - x * x + y * y - z * z; m[1][2] = 2 * y * z - 2 * s * x;
+            m[2][0] = 2 * x * z - 2 * s * y;         m[2][1] = 2 * y * z + 2 * s * x;         m[2][2] = s * s - x * x - y * y + z * z;
+            if constexpr(N == 4) {
+                m[0][3] = 0; m[1][3] = 0; m[2][3] = 0;
+                m[3][0] = 0; m[3][1] = 0; m[3][2] = 0; m[3][3] = 1;
+            }
+        }
+    }
+}
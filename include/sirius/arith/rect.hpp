@@ -44,11 +44,11 @@ namespace acma {
         //TODO consider calculating points when constructing instead of when called
         constexpr std::array<point2<T>, 4> points() const noexcept requires (impl::identity_rect<T, SizeT>) { return {top_left(), top_right(), bottom_right(), bottom_left()}; }
         constexpr std::array<point2<T>, 4> points(size2<T> normalize_to) const noexcept requires (impl::identity_rect<T, SizeT>) { 
-            constexpr point2<T> twos = {2,2}, ones = {1,1};
-            return {
-                (twos * (top_left()/normalize_to)) - ones, (twos * (top_right()/normalize_to)) - ones, 
-                (twos * (bottom_right()/normalize_to)) - ones, (twos * (bottom_left()/normalize_to)) - ones, 
-            }; 
+            //Written out per component so that rect doesn't need the expression templates to avoid the eager operators' temporaries
+            const auto normalize = [normalize_to](point2<T> p) noexcept -> point2<T> {
+                return {T{2} * (p.x() / normalize_to.width()) - T{1}, T{2} * (p.y() / normalize_to.height()) - T{1}};
+            };
+            return {normalize(top_left()), normalize(top_right()), normalize(bottom_right()), normalize(bottom_left())}; 
         }
         constexpr point2<T> operator[](std::size_t pos) const noexcept requires (impl::identity_rect<T, SizeT>) { return points()[pos]; }
         
@@ -0,0 +1,143 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <span>
+
+#include "sirius/arith/affine2.hpp"
+#include "sirius/arith/rect.hpp"
+#include "sirius/arith/vector_batch.hpp"
+
+
+namespace acma {
+    //Structure-of-arrays counterpart to std::vector<rect<T>>
+    template<typename T>
+    class rect_batch {
+    public:
+        using value_type = rect<T>;
+
+    public:
+        constexpr rect_batch() noexcept = default;
+        constexpr explicit rect_batch(std::size_t count) noexcept : pos(count), size(count) {}
+        constexpr rect_batch(std::span<rect<T> const> rects) noexcept;
+
+    public:
+        constexpr void reserve(std::size_t new_capacity) noexcept { pos.reserve(new_capacity); size.reserve(new_capacity); }
+        constexpr void resize(std::size_t new_size) noexcept { pos.resize(new_size); size.resize(new_size); }
+        constexpr void clear() noexcept { pos.clear(); size.clear(); }
+        constexpr void push_back(rect<T> r) noexcept { pos.push_back(r.pos); size.push_back(r.size); }
+
+        constexpr std::size_t count() const noexcept { return pos.size(); }
+        constexpr bool empty() const noexcept { return pos.empty(); }
+
+        constexpr rect<T> operator[](std::size_t i) const noexcept { return {pos[i], size[i]}; }
+        constexpr void set(std::size_t i, rect<T> r) noexcept { pos.set(i, r.pos); size.set(i, r.size); }
+
+    public:
+        constexpr rect_batch& translate(vector<2, T> translate_by) noexcept { pos.translate(translate_by); return *this; }
+        constexpr rect_batch& scale(vector<2, T> scale_by) noexcept { pos.scale(scale_by); size.scale(scale_by); return *this; }
+        constexpr rect_batch& scale(vector<2, T> scale_by, vector<2, T> origin) noexcept { pos.scale(scale_by, origin); size.scale(scale_by); return *this; }
+
+        //Replaces each rect with the smallest rect containing it after the transformation (see transform_bounds in affine2.hpp)
+        constexpr rect_batch& transform_bounds(affine2<T> const& m) noexcept;
+
+        //Smallest rect containing every rect in the batch
+        constexpr rect<T> bounds() const noexcept;
+
+        //Writes corner k of rect i (in the same order as rect::points(size2)) to dst[k * n + i], normalized to [-1, 1], where n is
+        //count() or, for a dst shorter than 4 * count() points, as many rects as it has room for. Each corner is its own contiguous
+        //run, so the stores vectorize like the loads. dst may point directly into mapped device memory
+        constexpr void points(size2<T> normalize_to, point_batch_view<2, T> dst) const noexcept;
+        constexpr point_batch<2, T> points(size2<T> normalize_to) const noexcept;
+
+    public:
+        point_batch<2, T> pos;
+        size_batch<2, T> size;
+    };
+}
+
+
+namespace acma {
+    template<typename T>
+    constexpr rect_batch<T>::rect_batch(std::span<rect<T> const> rects) noexcept : rect_batch(rects.size()) {
+        for(std::size_t i = 0; i < rects.size(); ++i) set(i, rects[i]);
+    }
+
+
+    template<typename T>
+    constexpr rect_batch<T>& rect_batch<T>::transform_bounds(affine2<T> const& m) noexcept {
+        const std::size_t n = count();
+        T* x = pos.component(0).data();
+        T* y = pos.component(1).data();
+        T* w = size.component(0).data();
+        T* h = size.component(1).data();
+
+        constexpr auto abs = [](T t) noexcept { return t < 0 ? -t : t; };
+        const T m00 = m[0][0], m01 = m[0][1], m10 = m[1][0], m11 = m[1][1], tx = m[2][0], ty = m[2][1];
+        const T a00 = abs(m00), a01 = abs(m01), a10 = abs(m10), a11 = abs(m11);
+        #pragma omp simd
+        for(std::size_t i = 0; i < n; ++i) {
+            const T hx = w[i] / 2, hy = h[i] / 2;
+            const T cx = x[i] + hx, cy = y[i] + hy;
+            const T ex = a00 * hx + a10 * hy, ey = a01 * hx + a11 * hy;
+            x[i] = m00 * cx + m10 * cy + tx - ex;
+            y[i] = m01 * cx + m11 * cy + ty - ey;
+            w[i] = 2 * ex;
+            h[i] = 2 * ey;
+        }
+        return *this;
+    }
+
+
+    template<typename T>
+    constexpr rect<T> rect_batch<T>::bounds() const noexcept {
+        const std::size_t n = count();
+        if(n == 0) return {};
+
+        T const* x = pos.component(0).data();
+        T const* y = pos.component(1).data();
+        T const* w = size.component(0).data();
+        T const* h = size.component(1).data();
+        T min_x = x[0], min_y = y[0], max_x = x[0] + w[0], max_y = y[0] + h[0];
+        #pragma omp simd reduction(min:min_x,min_y) reduction(max:max_x,max_y)
+        for(std::size_t i = 1; i < n; ++i) {
+            min_x = x[i] < min_x ? x[i] : min_x;
+            min_y = y[i] < min_y ? y[i] : min_y;
+            max_x = x[i] + w[i] > max_x ? x[i] + w[i] : max_x;
+            max_y = y[i] + h[i] > max_y ? y[i] + h[i] : max_y;
+        }
+        return {min_x, min_y, max_x - min_x, max_y - min_y};
+    }
+
+
+    template<typename T>
+    constexpr void rect_batch<T>::points(size2<T> normalize_to, point_batch_view<2, T> dst) const noexcept {
+        //Only as many rects as dst has room for all 4 corners of are written
+        const std::size_t n = std::min(count(), dst.size() / 4);
+        T const* x = pos.component(0).data();
+        T const* y = pos.component(1).data();
+        T const* w = size.component(0).data();
+        T const* h = size.component(1).data();
+        T* dst_x = dst.component(0).data();
+        T* dst_y = dst.component(1).data();
+
+        //Same arithmetic as rect::points(size2) so that both produce identical results
+        const T sx = normalize_to.width(), sy = normalize_to.height();
+        constexpr T two = 2, one = 1;
+        #pragma omp simd
+        for(std::size_t i = 0; i < n; ++i) {
+            const T left   = two * (x[i] / sx) - one, right  = two * ((x[i] + w[i]) / sx) - one;
+            const T top    = two * (y[i] / sy) - one, bottom = two * ((y[i] + h[i]) / sy) - one;
+            dst_x[0 * n + i] = left;  dst_y[0 * n + i] = top;
+            dst_x[1 * n + i] = right; dst_y[1 * n + i] = top;
+            dst_x[2 * n + i] = right; dst_y[2 * n + i] = bottom;
+            dst_x[3 * n + i] = left;  dst_y[3 * n + i] = bottom;
+        }
+    }
+
+    template<typename T>
+    constexpr point_batch<2, T> rect_batch<T>::points(size2<T> normalize_to) const noexcept {
+        point_batch<2, T> ret(4 * count());
+        points(normalize_to, ret.view());
+        return ret;
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "sirius/arith/point.hpp"
+#include "sirius/arith/rect.hpp"
+
+
+namespace acma {
+    using rect_handle = std::uint32_t;
+    constexpr rect_handle null_rect_handle = std::numeric_limits<rect_handle>::max();
+}
+
+
+namespace acma {
+    //Dynamic AABB tree over rects for hit-testing (i.e. replacing a linear rect::contains scan on every mouse move).
+    //Leaves are kept balanced with AVL-style rotations, so insert, update, remove and point queries are all O(log n).
+    //Queries are const and may run concurrently with each other (e.g. from event functions on the thread pool),
+    //but not concurrently with insert, update, remove or clear
+    template<typename T, typename ValueT = std::size_t>
+    class rect_tree {
+    public:
+        using value_type = ValueT;
+
+    public:
+        constexpr rect_tree() noexcept = default;
+
+    public:
+        constexpr rect_handle insert(rect<T> r, ValueT value) noexcept;
+        //Moves or resizes the rect, keeping its handle
+        constexpr void update(rect_handle h, rect<T> r) noexcept;
+        constexpr void remove(rect_handle h) noexcept;
+        constexpr void clear() noexcept;
+        constexpr void reserve(std::size_t new_capacity) noexcept { nodes.reserve(2 * new_capacity); }
+
+        constexpr std::size_t size() const noexcept { return leaf_count; }
+        constexpr bool empty() const noexcept { return leaf_count == 0; }
+        constexpr std::size_t height() const noexcept { return root == null_rect_handle ? 0 : static_cast<std::size_t>(nodes[root].height) + 1; }
+
+        constexpr rect<T> get_rect(rect_handle h) const noexcept { return to_rect(nodes[h]); }
+        constexpr ValueT      & operator[](rect_handle h)       noexcept { return nodes[h].value; }
+        constexpr ValueT const& operator[](rect_handle h) const noexcept { return nodes[h].value; }
+
+    public:
+        //Calls fn(handle, value) for every rect containing pt (with the same inclusive edges as rect::contains).
+        //fn may return bool, in which case returning false stops the query early
+        template<typename U, typename Fn>
+        constexpr void query(point2<U> pt, Fn&& fn) const noexcept;
+        //Calls fn(handle, value) for every rect overlapping r
+        template<typename Fn>
+        constexpr void query(rect<T> const& r, Fn&& fn) const noexcept;
+
+        //Returns any rect containing pt, or null_rect_handle if there is none.
+        //Takes an optional point so that the mouse_aux_t passed to event functions can be forwarded directly
+        template<typename U>
+        constexpr rect_handle find(point2<U> pt) const noexcept;
+        template<typename U>
+        constexpr rect_handle find(std::optional<point2<U>> pt) const noexcept { return pt ? find(*pt) : null_rect_handle; }
+
+    private:
+        struct node {
+            point2<T> lo;
+            point2<T> hi;
+            rect_handle parent = null_rect_handle;
+            rect_handle left = null_rect_handle;
+            rect_handle right = null_rect_handle;
+            //Leaves have a height of 0 and free nodes a height of -1
+            std::int32_t height = 0;
+            ValueT value;
+
+            constexpr bool is_leaf() const noexcept { return left == null_rect_handle; }
+        };
+
+    private:
+        constexpr rect_handle allocate_node() noexcept;
+        constexpr void free_node(rect_handle h) noexcept;
+        constexpr void insert_leaf(rect_handle leaf) noexcept;
+        constexpr void remove_leaf(rect_handle leaf) noexcept;
+        constexpr rect_handle balance(rect_handle a) noexcept;
+        constexpr void refit(rect_handle h) noexcept;
+
+        template<typename Overlaps, typename Fn>
+        constexpr void traverse(Overlaps&& overlaps, Fn&& fn) const noexcept;
+
+        constexpr static rect<T> to_rect(node const& n) noexcept { return {n.lo, size2<T>{n.hi[0] - n.lo[0], n.hi[1] - n.lo[1]}}; }
+        constexpr static T perimeter(point2<T> lo, point2<T> hi) noexcept { return (hi[0] - lo[0]) + (hi[1] - lo[1]); }
+        constexpr static point2<T> min(point2<T> a, point2<T> b) noexcept { return {a[0] < b[0] ? a[0] : b[0], a[1] < b[1] ? a[1] : b[1]}; }
+        constexpr static point2<T> max(point2<T> a, point2<T> b) noexcept { return {a[0] > b[0] ? a[0] : b[0], a[1] > b[1] ? a[1] : b[1]}; }
+
+    private:
+        std::vector<node> nodes;
+        rect_handle root = null_rect_handle;
+        rect_handle free_list = null_rect_handle;
+        std::size_t leaf_count = 0;
+    };
+}
+
+
+#include "sirius/arith/rect_tree.inl"
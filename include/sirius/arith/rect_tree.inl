@@ -0,0 +1,265 @@
+#pragma once
+#include "sirius/arith/rect_tree.hpp"
+#include <algorithm>
+#include <functional>
+
+
+namespace acma {
+    template<typename T, typename ValueT>
+    constexpr rect_handle rect_tree<T, ValueT>::insert(rect<T> r, ValueT value) noexcept {
+        const rect_handle h = allocate_node();
+        node& n = nodes[h];
+        n.lo = r.pos;
+        n.hi = {r.pos[0] + r.size[0], r.pos[1] + r.size[1]};
+        n.value = std::move(value);
+        insert_leaf(h);
+        ++leaf_count;
+        return h;
+    }
+
+    template<typename T, typename ValueT>
+    constexpr void rect_tree<T, ValueT>::update(rect_handle h, rect<T> r) noexcept {
+        const point2<T> lo = r.pos, hi = {r.pos[0] + r.size[0], r.pos[1] + r.size[1]};
+        if(nodes[h].lo == lo && nodes[h].hi == hi) return;
+
+        remove_leaf(h);
+        nodes[h].lo = lo;
+        nodes[h].hi = hi;
+        insert_leaf(h);
+    }
+
+    template<typename T, typename ValueT>
+    constexpr void rect_tree<T, ValueT>::remove(rect_handle h) noexcept {
+        remove_leaf(h);
+        free_node(h);
+        --leaf_count;
+    }
+
+    template<typename T, typename ValueT>
+    constexpr void rect_tree<T, ValueT>::clear() noexcept {
+        nodes.clear();
+        root = null_rect_handle;
+        free_list = null_rect_handle;
+        leaf_count = 0;
+    }
+}
+
+
+namespace acma {
+    template<typename T, typename ValueT>
+    template<typename U, typename Fn>
+    constexpr void rect_tree<T, ValueT>::query(point2<U> pt, Fn&& fn) const noexcept {
+        const point2<T> p = {static_cast<T>(pt[0]), static_cast<T>(pt[1])};
+        traverse([p](node const& n) noexcept {
+            return static_cast<bool>(
+                static_cast<int>(n.lo[0] <= p[0]) & (n.lo[1] <= p[1]) &
+                static_cast<int>(p[0] <= n.hi[0]) & (p[1] <= n.hi[1])
+            );
+        }, std::forward<Fn>(fn));
+    }
+
+    template<typename T, typename ValueT>
+    template<typename Fn>
+    constexpr void rect_tree<T, ValueT>::query(rect<T> const& r, Fn&& fn) const noexcept {
+        const point2<T> lo = r.pos, hi = {r.pos[0] + r.size[0], r.pos[1] + r.size[1]};
+        traverse([lo, hi](node const& n) noexcept {
+            return static_cast<bool>(
+                static_cast<int>(n.lo[0] <= hi[0]) & (n.lo[1] <= hi[1]) &
+                static_cast<int>(lo[0] <= n.hi[0]) & (lo[1] <= n.hi[1])
+            );
+        }, std::forward<Fn>(fn));
+    }
+
+    template<typename T, typename ValueT>
+    template<typename U>
+    constexpr rect_handle rect_tree<T, ValueT>::find(point2<U> pt) const noexcept {
+        rect_handle ret = null_rect_handle;
+        query(pt, [&ret](rect_handle h, ValueT const&) noexcept { ret = h; return false; });
+        return ret;
+    }
+
+
+    template<typename T, typename ValueT>
+    template<typename Overlaps, typename Fn>
+    constexpr void rect_tree<T, ValueT>::traverse(Overlaps&& overlaps, Fn&& fn) const noexcept {
+        if(root == null_rect_handle) return;
+
+        //The tree is balanced, so the stack only spills to the heap for absurdly large trees
+        std::array<rect_handle, 64> inline_stack;
+        std::vector<rect_handle> spilled_stack;
+        std::size_t top = 0;
+        auto push = [&](rect_handle h) noexcept {
+            if(top < inline_stack.size()) inline_stack[top] = h;
+            else spilled_stack.push_back(h);
+            ++top;
+        };
+        auto pop = [&]() noexcept {
+            if(--top < inline_stack.size()) return inline_stack[top];
+            const rect_handle h = spilled_stack.back();
+            spilled_stack.pop_back();
+            return h;
+        };
+
+        push(root);
+        while(top > 0) {
+            const rect_handle h = pop();
+            node const& n = nodes[h];
+            if(!overlaps(n)) continue;
+
+            if(!n.is_leaf()) {
+                push(n.left);
+                push(n.right);
+                continue;
+            }
+
+            if constexpr(std::is_same_v<std::invoke_result_t<Fn&, rect_handle, ValueT const&>, bool>) {
+                if(!fn(h, n.value)) return;
+            }
+            else fn(h, n.value);
+        }
+    }
+}
+
+
+namespace acma {
+    template<typename T, typename ValueT>
+    constexpr rect_handle rect_tree<T, ValueT>::allocate_node() noexcept {
+        if(free_list == null_rect_handle) {
+            nodes.emplace_back();
+            return static_cast<rect_handle>(nodes.size() - 1);
+        }
+
+        const rect_handle h = free_list;
+        free_list = nodes[h].parent;
+        nodes[h] = node{};
+        return h;
+    }
+
+    template<typename T, typename ValueT>
+    constexpr void rect_tree<T, ValueT>::free_node(rect_handle h) noexcept {
+        nodes[h].parent = free_list;
+        nodes[h].left = null_rect_handle;
+        nodes[h].height = -1;
+        free_list = h;
+    }
+
+
+    //Picks the sibling that increases the total perimeter of the tree the least (the 2D equivalent of the surface area heuristic)
+    template<typename T, typename ValueT>
+    constexpr void rect_tree<T, ValueT>::insert_leaf(rect_handle leaf) noexcept {
+        if(root == null_rect_handle) {
+            root = leaf;
+            nodes[root].parent = null_rect_handle;
+            return;
+        }
+
+        const point2<T> lo = nodes[leaf].lo, hi = nodes[leaf].hi;
+        rect_handle sibling = root;
+        while(!nodes[sibling].is_leaf()) {
+            node const& n = nodes[sibling];
+            const T combined = perimeter(min(n.lo, lo), max(n.hi, hi));
+            const T cost = 2 * combined;
+            //Minimum cost of pushing the leaf further down, since every ancestor grows by the same amount
+            const T inherited = 2 * (combined - perimeter(n.lo, n.hi));
+
+            auto descend_cost = [&](rect_handle child) noexcept {
+                node const& c = nodes[child];
+                const T grown = perimeter(min(c.lo, lo), max(c.hi, hi));
+                return (c.is_leaf() ? grown : grown - perimeter(c.lo, c.hi)) + inherited;
+            };
+            const T left_cost = descend_cost(n.left), right_cost = descend_cost(n.right);
+
+            if(cost < left_cost && cost < right_cost) break;
+            sibling = left_cost < right_cost ? n.left : n.right;
+        }
+
+        const rect_handle old_parent = nodes[sibling].parent;
+        const rect_handle new_parent = allocate_node();
+        nodes[new_parent].parent = old_parent;
+        nodes[new_parent].left = sibling;
+        nodes[new_parent].right = leaf;
+        nodes[sibling].parent = new_parent;
+        nodes[leaf].parent = new_parent;
+
+        if(old_parent == null_rect_handle) root = new_parent;
+        else if(nodes[old_parent].left == sibling) nodes[old_parent].left = new_parent;
+        else nodes[old_parent].right = new_parent;
+
+        for(rect_handle h = new_parent; h != null_rect_handle; h = nodes[h].parent) {
+            h = balance(h);
+            refit(h);
+        }
+    }
+
+    template<typename T, typename ValueT>
+    constexpr void rect_tree<T, ValueT>::remove_leaf(rect_handle leaf) noexcept {
+        if(leaf == root) {
+            root = null_rect_handle;
+            return;
+        }
+
+        const rect_handle parent = nodes[leaf].parent;
+        const rect_handle grandparent = nodes[parent].parent;
+        const rect_handle sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+        free_node(parent);
+        nodes[sibling].parent = grandparent;
+
+        if(grandparent == null_rect_handle) {
+            root = sibling;
+            return;
+        }
+
+        if(nodes[grandparent].left == parent) nodes[grandparent].left = sibling;
+        else nodes[grandparent].right = sibling;
+
+        for(rect_handle h = grandparent; h != null_rect_handle; h = nodes[h].parent) {
+            h = balance(h);
+            refit(h);
+        }
+    }
+
+    template<typename T, typename ValueT>
+    constexpr void rect_tree<T, ValueT>::refit(rect_handle h) noexcept {
+        node& n = nodes[h];
+        node const& l = nodes[n.left];
+        node const& r = nodes[n.right];
+        n.lo = min(l.lo, r.lo);
+        n.hi = max(l.hi, r.hi);
+        n.height = 1 + std::max(l.height, r.height);
+    }
+
+
+    //If one child of a is more than 1 level taller than the other, rotates that child up into a's place.
+    //Returns the node now at a's position
+    template<typename T, typename ValueT>
+    constexpr rect_handle rect_tree<T, ValueT>::balance(rect_handle a) noexcept {
+        if(nodes[a].is_leaf() || nodes[a].height < 2) return a;
+
+        const rect_handle b = nodes[a].left, c = nodes[a].right;
+        const std::int32_t skew = nodes[c].height - nodes[b].height;
+        if(skew >= -1 && skew <= 1) return a;
+
+        //up is the taller child, which takes a's place; a keeps the shorter child and the shorter of up's children
+        const bool right_heavy = skew > 1;
+        const rect_handle up = right_heavy ? c : b;
+        const rect_handle f = nodes[up].left, g = nodes[up].right;
+        const bool keep_f = nodes[f].height > nodes[g].height;
+        const rect_handle kept = keep_f ? f : g, moved = keep_f ? g : f;
+
+        nodes[up].left = a;
+        nodes[up].right = kept;
+        nodes[up].parent = nodes[a].parent;
+        nodes[a].parent = up;
+        if(nodes[up].parent == null_rect_handle) root = up;
+        else if(nodes[nodes[up].parent].left == a) nodes[nodes[up].parent].left = up;
+        else nodes[nodes[up].parent].right = up;
+
+        if(right_heavy) nodes[a].right = moved;
+        else nodes[a].left = moved;
+        nodes[moved].parent = a;
+
+        refit(a);
+        refit(up);
+        return up;
+    }
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+
+namespace acma::impl {
+    //Maps directly to the native vector registers (SSE/AVX on x86, NEON on AArch64, etc.)
+    template<typename T, std::size_t Lanes>
+    using simd_register_t [[gnu::vector_size(Lanes * sizeof(T))]] = T;
+
+    //Only vectors that exactly fill a 128 or 256-bit register are worth moving into one. Narrower vectors would need their padding lanes
+    //filled on every load, which costs far more than the operation itself, so they stay on the scalar path (which the autovectorizer
+    //handles well across loops anyway)
+    template<typename T, std::size_t Dims>
+    constexpr bool simd_fills_register = Dims * sizeof(T) == 16 || Dims * sizeof(T) == 32;
+}
+
+namespace acma::impl {
+    template<typename T>
+    concept simd_element = std::same_as<T, float> || std::same_as<T, double> || std::same_as<T, std::int32_t>;
+
+    template<typename Op>
+    concept simd_operation = std::same_as<Op, std::plus<>> || std::same_as<Op, std::minus<>> || std::same_as<Op, std::multiplies<>> || std::same_as<Op, std::divides<>>;
+
+
+    template<typename V>
+    struct elementwise_operand { using type = V; };
+    template<typename V> requires (!std::is_arithmetic_v<V>)
+    struct elementwise_operand<V> { using type = typename V::value_type; };
+
+    template<typename V>
+    using elementwise_operand_t = typename elementwise_operand<V>::type;
+
+
+    //Only vectorize when the scalar operation would have been performed entirely in T.
+    //Otherwise the result could differ from the scalar path (e.g. float += double rounds differently than float += float)
+    template<typename Op, typename T, typename V>
+    concept simd_operand = std::same_as<elementwise_operand_t<V>, T> ||
+        (std::is_arithmetic_v<V> && std::same_as<decltype(std::declval<Op>()(std::declval<T>(), std::declval<V>())), T>);
+
+    template<std::size_t Dims, typename Op, typename Ret, typename L, typename R>
+    concept simd_elementwise_compatible =
+        (Dims >= 2 && Dims <= 4) && simd_element<typename Ret::value_type> && simd_fills_register<typename Ret::value_type, Dims> && simd_operation<Op> &&
+        !(std::same_as<Op, std::divides<>> && std::is_integral_v<typename Ret::value_type>) &&
+        simd_operand<Op, typename Ret::value_type, L> && simd_operand<Op, typename Ret::value_type, R>;
+}
+
+
+namespace acma::impl {
+    template<typename V>
+    constexpr decltype(auto) elementwise_lane(V const& v, std::size_t i) noexcept {
+        if constexpr(std::is_arithmetic_v<V>) return v;
+        else return v[i];
+    }
+
+    template<std::size_t Dims, typename Op, typename Ret, typename L, typename R>
+    constexpr void scalar_elementwise(Ret& ret, L const& lhs, R const& rhs) noexcept {
+        for(std::size_t i = 0; i < Dims; ++i) ret[i] = Op{}(elementwise_lane(lhs, i), elementwise_lane(rhs, i));
+    }
+}
+
+namespace acma::impl {
+    //Registers are passed by reference so that 256-bit registers don't change the ABI when AVX isn't enabled
+    template<std::size_t Dims, typename T, typename V>
+    inline void simd_load(simd_register_t<T, Dims>& reg, V const& v) noexcept {
+        if constexpr(std::is_arithmetic_v<V>) {
+            for(std::size_t i = 0; i < Dims; ++i) reg[i] = static_cast<T>(v);
+        }
+        else std::memcpy(&reg, v.data(), sizeof(reg));
+    }
+
+    template<std::size_t Dims, typename T, typename Ret>
+    inline void simd_store(Ret& ret, simd_register_t<T, Dims> const& reg) noexcept {
+        std::memcpy(ret.data(), &reg, sizeof(reg));
+    }
+
+
+    template<std::size_t Dims, typename Op, typename Ret, typename L, typename R> requires simd_elementwise_compatible<Dims, Op, Ret, L, R>
+    inline void simd_elementwise(Ret& ret, L const& lhs, R const& rhs) noexcept {
+        using T = typename Ret::value_type;
+        simd_register_t<T, Dims> l, r;
+        simd_load<Dims, T>(l, lhs);
+        simd_load<Dims, T>(r, rhs);
+        //Apply the operator in place rather than through Op::operator(), which would return the register by value
+        if constexpr(std::same_as<Op, std::plus<>>)            l += r;
+        else if constexpr(std::same_as<Op, std::minus<>>)      l -= r;
+        else if constexpr(std::same_as<Op, std::multiplies<>>) l *= r;
+        else                                                   l /= r;
+        simd_store<Dims, T>(ret, l);
+    }
+}
+
+
+namespace acma::impl {
+    //Binary operators stay on the scalar path: their results are fresh vectors, which the autovectorizer packs across the surrounding
+    //loop, and one register per vector measured slower (e.g. 0.92 vs 0.78 ns for an f32x4 add, 1.66 vs 0.97 for a divide)
+    template<std::size_t Dims, typename Op, typename Ret, typename L, typename R>
+    constexpr void elementwise(Ret& ret, L const& lhs, R const& rhs) noexcept {
+        scalar_elementwise<Dims, Op>(ret, lhs, rhs);
+    }
+
+    //Compound assignment reads and writes the same vector, which the autovectorizer leaves scalar, so that is where the register
+    //path pays off (e.g. 1.4 vs 3.8 ns for an f32x4 +=). Falls back to the scalar path at compile time and for any types or operations
+    //without a vector equivalent
+    template<std::size_t Dims, typename Op, typename Ret, typename R>
+    constexpr void elementwise_assign(Ret& ret, R const& rhs) noexcept {
+        if !consteval {
+            if constexpr(simd_elementwise_compatible<Dims, Op, Ret, Ret, R>)
+                return simd_elementwise<Dims, Op>(ret, ret, rhs);
+        }
+        return scalar_elementwise<Dims, Op>(ret, ret, rhs);
+    }
+}
@@ -13,6 +13,7 @@
 #include <vulkan/vulkan_core.h>
 
 #include "sirius/arith/axis.hpp"
+#include "sirius/arith/simd.hpp"
 #include "sirius/traits/vector_traits.hpp"
 
 
@@ -68,31 +69,30 @@ namespace acma {
 
     
     public:
-        //TODO: SIMD (probably just needs a target_clones)
-        template<typename U, impl::vec_data_type OtherHoldsData> constexpr vector& operator+=(const vector<Dims, U, OtherHoldsData>& rhs) noexcept { for(std::size_t i = 0; i < Dims; ++i) (*this)[i] += rhs[i]; return *this; }
-        template<typename U, impl::vec_data_type OtherHoldsData> constexpr vector& operator-=(const vector<Dims, U, OtherHoldsData>& rhs) noexcept { for(std::size_t i = 0; i < Dims; ++i) (*this)[i] -= rhs[i]; return *this; }
-        template<typename U, impl::vec_data_type OtherHoldsData> constexpr vector& operator*=(const vector<Dims, U, OtherHoldsData>& rhs) noexcept { for(std::size_t i = 0; i < Dims; ++i) (*this)[i] *= rhs[i]; return *this; }
-        template<typename U, impl::vec_data_type OtherHoldsData> constexpr vector& operator/=(const vector<Dims, U, OtherHoldsData>& rhs) noexcept { for(std::size_t i = 0; i < Dims; ++i) (*this)[i] /= rhs[i]; return *this; }
-
-        template<typename U, impl::vec_data_type OtherHoldsData> friend constexpr result_vector<T, U, std::plus<>      > operator+(vector lhs, const vector<Dims, U, OtherHoldsData>& rhs) noexcept { result_vector<T, U, std::plus<>      > ret; for(std::size_t i = 0; i < Dims; ++i) ret[i] = (lhs[i] + rhs[i]); return ret; }
-        template<typename U, impl::vec_data_type OtherHoldsData> friend constexpr result_vector<T, U, std::minus<>     > operator-(vector lhs, const vector<Dims, U, OtherHoldsData>& rhs) noexcept { result_vector<T, U, std::minus<>     > ret; for(std::size_t i = 0; i < Dims; ++i) ret[i] = (lhs[i] - rhs[i]); return ret; }
-        template<typename U, impl::vec_data_type OtherHoldsData> friend constexpr result_vector<T, U, std::multiplies<>> operator*(vector lhs, const vector<Dims, U, OtherHoldsData>& rhs) noexcept { result_vector<T, U, std::multiplies<>> ret; for(std::size_t i = 0; i < Dims; ++i) ret[i] = (lhs[i] * rhs[i]); return ret; }
-        template<typename U, impl::vec_data_type OtherHoldsData> friend constexpr result_vector<T, U, std::divides<>   > operator/(vector lhs, const vector<Dims, U, OtherHoldsData>& rhs) noexcept { result_vector<T, U, std::divides<>   > ret; for(std::size_t i = 0; i < Dims; ++i) ret[i] = (lhs[i] / rhs[i]); return ret; }
+        template<typename U, impl::vec_data_type OtherHoldsData> constexpr vector& operator+=(const vector<Dims, U, OtherHoldsData>& rhs) noexcept { impl::elementwise_assign<Dims, std::plus<>      >(*this, rhs); return *this; }
+        template<typename U, impl::vec_data_type OtherHoldsData> constexpr vector& operator-=(const vector<Dims, U, OtherHoldsData>& rhs) noexcept { impl::elementwise_assign<Dims, std::minus<>     >(*this, rhs); return *this; }
+        template<typename U, impl::vec_data_type OtherHoldsData> constexpr vector& operator*=(const vector<Dims, U, OtherHoldsData>& rhs) noexcept { impl::elementwise_assign<Dims, std::multiplies<>>(*this, rhs); return *this; }
+        template<typename U, impl::vec_data_type OtherHoldsData> constexpr vector& operator/=(const vector<Dims, U, OtherHoldsData>& rhs) noexcept { impl::elementwise_assign<Dims, std::divides<>   >(*this, rhs); return *this; }
+
+        template<typename U, impl::vec_data_type OtherHoldsData> friend constexpr result_vector<T, U, std::plus<>      > operator+(vector lhs, const vector<Dims, U, OtherHoldsData>& rhs) noexcept { result_vector<T, U, std::plus<>      > ret; impl::elementwise<Dims, std::plus<>      >(ret, lhs, rhs); return ret; }
+        template<typename U, impl::vec_data_type OtherHoldsData> friend constexpr result_vector<T, U, std::minus<>     > operator-(vector lhs, const vector<Dims, U, OtherHoldsData>& rhs) noexcept { result_vector<T, U, std::minus<>     > ret; impl::elementwise<Dims, std::minus<>     >(ret, lhs, rhs); return ret; }
+        template<typename U, impl::vec_data_type OtherHoldsData> friend constexpr result_vector<T, U, std::multiplies<>> operator*(vector lhs, const vector<Dims, U, OtherHoldsData>& rhs) noexcept { result_vector<T, U, std::multiplies<>> ret; impl::elementwise<Dims, std::multiplies<>>(ret, lhs, rhs); return ret; }
+        template<typename U, impl::vec_data_type OtherHoldsData> friend constexpr result_vector<T, U, std::divides<>   > operator/(vector lhs, const vector<Dims, U, OtherHoldsData>& rhs) noexcept { result_vector<T, U, std::divides<>   > ret; impl::elementwise<Dims, std::divides<>   >(ret, lhs, rhs); return ret; }
     public:
-        template<impl::non_vector U> constexpr vector& operator+=(const U& rhs) noexcept { for(std::size_t i = 0; i < Dims; ++i) (*this)[i] += rhs; return *this; }
-        template<impl::non_vector U> constexpr vector& operator-=(const U& rhs) noexcept { for(std::size_t i = 0; i < Dims; ++i) (*this)[i] -= rhs; return *this; }
-        template<impl::non_vector U> constexpr vector& operator*=(const U& rhs) noexcept { for(std::size_t i = 0; i < Dims; ++i) (*this)[i] *= rhs; return *this; }
-        template<impl::non_vector U> constexpr vector& operator/=(const U& rhs) noexcept { for(std::size_t i = 0; i < Dims; ++i) (*this)[i] /= rhs; return *this; }
-
-        //TODO expression templates
-        template<impl::non_vector U> friend constexpr result_vector<T, U, std::plus<>      > operator+(vector lhs, const U& rhs) noexcept { result_vector<T, U, std::plus<>      > ret; for(std::size_t i = 0; i < Dims; ++i) ret[i] = (lhs[i] + rhs   ); return ret;  }
-        template<impl::non_vector U> friend constexpr result_vector<T, U, std::minus<>     > operator-(vector lhs, const U& rhs) noexcept { result_vector<T, U, std::minus<>     > ret; for(std::size_t i = 0; i < Dims; ++i) ret[i] = (lhs[i] - rhs   ); return ret;  }
-        template<impl::non_vector U> friend constexpr result_vector<T, U, std::multiplies<>> operator*(vector lhs, const U& rhs) noexcept { result_vector<T, U, std::multiplies<>> ret; for(std::size_t i = 0; i < Dims; ++i) ret[i] = (lhs[i] * rhs   ); return ret;  }
-        template<impl::non_vector U> friend constexpr result_vector<T, U, std::divides<>   > operator/(vector lhs, const U& rhs) noexcept { result_vector<T, U, std::divides<>   > ret; for(std::size_t i = 0; i < Dims; ++i) ret[i] = (lhs[i] / rhs   ); return ret;  }
-        template<impl::non_vector U> friend constexpr result_vector<U, T, std::plus<>      > operator+(U lhs, const vector& rhs) noexcept { result_vector<U, T, std::plus<>      > ret; for(std::size_t i = 0; i < Dims; ++i) ret[i] = (lhs    + rhs[i]); return ret;  }
-        template<impl::non_vector U> friend constexpr result_vector<U, T, std::minus<>     > operator-(U lhs, const vector& rhs) noexcept { result_vector<U, T, std::minus<>     > ret; for(std::size_t i = 0; i < Dims; ++i) ret[i] = (lhs    - rhs[i]); return ret;  }
-        template<impl::non_vector U> friend constexpr result_vector<U, T, std::multiplies<>> operator*(U lhs, const vector& rhs) noexcept { result_vector<U, T, std::multiplies<>> ret; for(std::size_t i = 0; i < Dims; ++i) ret[i] = (lhs    * rhs[i]); return ret;  }
-        template<impl::non_vector U> friend constexpr result_vector<U, T, std::divides<>   > operator/(U lhs, const vector& rhs) noexcept { result_vector<U, T, std::divides<>   > ret; for(std::size_t i = 0; i < Dims; ++i) ret[i] = (lhs    / rhs[i]); return ret;  }
+        template<impl::non_vector U> constexpr vector& operator+=(const U& rhs) noexcept { impl::elementwise_assign<Dims, std::plus<>      >(*this, rhs); return *this; }
+        template<impl::non_vector U> constexpr vector& operator-=(const U& rhs) noexcept { impl::elementwise_assign<Dims, std::minus<>     >(*this, rhs); return *this; }
+        template<impl::non_vector U> constexpr vector& operator*=(const U& rhs) noexcept { impl::elementwise_assign<Dims, std::multiplies<>>(*this, rhs); return *this; }
+        template<impl::non_vector U> constexpr vector& operator/=(const U& rhs) noexcept { impl::elementwise_assign<Dims, std::divides<>   >(*this, rhs); return *this; }
+
+        //Chains of these operators can be fused into a single loop with acma::lazy (see expression.hpp)
+        template<impl::non_vector U> friend constexpr result_vector<T, U, std::plus<>      > operator+(vector lhs, const U& rhs) noexcept { result_vector<T, U, std::plus<>      > ret; impl::elementwise<Dims, std::plus<>      >(ret, lhs, rhs); return ret; }
+        template<impl::non_vector U> friend constexpr result_vector<T, U, std::minus<>     > operator-(vector lhs, const U& rhs) noexcept { result_vector<T, U, std::minus<>     > ret; impl::elementwise<Dims, std::minus<>     >(ret, lhs, rhs); return ret; }
+        template<impl::non_vector U> friend constexpr result_vector<T, U, std::multiplies<>> operator*(vector lhs, const U& rhs) noexcept { result_vector<T, U, std::multiplies<>> ret; impl::elementwise<Dims, std::multiplies<>>(ret, lhs, rhs); return ret; }
+        template<impl::non_vector U> friend constexpr result_vector<T, U, std::divides<>   > operator/(vector lhs, const U& rhs) noexcept { result_vector<T, U, std::divides<>   > ret; impl::elementwise<Dims, std::divides<>   >(ret, lhs, rhs); return ret; }
+        template<impl::non_vector U> friend constexpr result_vector<U, T, std::plus<>      > operator+(U lhs, const vector& rhs) noexcept { result_vector<U, T, std::plus<>      > ret; impl::elementwise<Dims, std::plus<>      >(ret, lhs, rhs); return ret; }
+        template<impl::non_vector U> friend constexpr result_vector<U, T, std::minus<>     > operator-(U lhs, const vector& rhs) noexcept { result_vector<U, T, std::minus<>     > ret; impl::elementwise<Dims, std::minus<>     >(ret, lhs, rhs); return ret; }
+        template<impl::non_vector U> friend constexpr result_vector<U, T, std::multiplies<>> operator*(U lhs, const vector& rhs) noexcept { result_vector<U, T, std::multiplies<>> ret; impl::elementwise<Dims, std::multiplies<>>(ret, lhs, rhs); return ret; }
+        template<impl::non_vector U> friend constexpr result_vector<U, T, std::divides<>   > operator/(U lhs, const vector& rhs) noexcept { result_vector<U, T, std::divides<>   > ret; impl::elementwise<Dims, std::divides<>   >(ret, lhs, rhs); return ret; }
 
         constexpr vector operator-() const noexcept { vector ret; for(std::size_t i = 0; i < Dims; ++i) ret[i] = -(*this)[i]; return ret; }
 
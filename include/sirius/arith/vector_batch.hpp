@@ -0,0 +1,162 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "sirius/arith/affine2.hpp"
+#include "sirius/arith/matrix.hpp"
+#include "sirius/arith/point.hpp"
+#include "sirius/arith/rect.hpp"
+#include "sirius/arith/size.hpp"
+#include "sirius/arith/vector.hpp"
+
+
+namespace acma::impl {
+    //Bulk operations shared by owning batches and views.
+    //Every component is stored in its own contiguous plane (x0 x1 x2 ... | y0 y1 y2 ... | ...) so that each operation is a straight-line loop over plain arrays
+    template<std::size_t Dims, typename T, vec_data_type HoldsData, typename Derived>
+    struct vector_batch_ops {
+        using value_type = vector<Dims, T, HoldsData>;
+        using component_type = T;
+        constexpr static std::size_t dimensions = Dims;
+
+    public:
+        constexpr value_type operator[](std::size_t i) const noexcept;
+        constexpr void set(std::size_t i, value_type v) noexcept;
+
+    public:
+        constexpr Derived& translate(vector<Dims, T> translate_by) noexcept;
+        constexpr Derived& scale(vector<Dims, T> scale_by) noexcept;
+        constexpr Derived& scale(vector<Dims, T> scale_by, vector<Dims, T> origin) noexcept;
+
+        //Linear transformation (i.e. rotation/scale)
+        constexpr Derived& transform(matrix<Dims, Dims, T> const& m) noexcept;
+        //Affine transformation in homogeneous coordinates. The last row of the matrix is assumed to be [0 ... 0 1]
+        constexpr Derived& transform(matrix<Dims + 1, Dims + 1, T> const& m) noexcept;
+        constexpr Derived& transform(affine2<T> const& m) noexcept requires (Dims == 2);
+
+        //Maps [0, extent] to [-1, 1] (the same mapping as rect::points(size2))
+        constexpr Derived& normalize(size<Dims, T> extent) noexcept;
+
+    public:
+        constexpr value_type min() const noexcept;
+        constexpr value_type max() const noexcept;
+        constexpr rect<T> bounds() const noexcept requires (Dims == 2);
+
+    private:
+        constexpr Derived      & derived()       noexcept { return static_cast<Derived      &>(*this); }
+        constexpr Derived const& derived() const noexcept { return static_cast<Derived const&>(*this); }
+    };
+}
+
+
+namespace acma {
+    //Non-owning view over planar (SoA) data, e.g. the mapped memory of a device_allocation_segment.
+    //Writing through a view modifies the underlying memory directly, so no copy is needed to hand the data to the GPU.
+    template<std::size_t Dims, typename T, impl::vec_data_type HoldsData = impl::vec_data_type::point>
+    class vector_batch_view : public impl::vector_batch_ops<Dims, T, HoldsData, vector_batch_view<Dims, T, HoldsData>> {
+    public:
+        constexpr vector_batch_view() noexcept = default;
+        constexpr vector_batch_view(T* data, std::size_t count, std::size_t stride) noexcept : ptr(data), count(count), plane_stride(stride) {}
+        constexpr vector_batch_view(T* data, std::size_t count) noexcept : vector_batch_view(data, count, count) {}
+
+        //Views `bytes` as Dims planes of `count` components each, starting `stride` components apart.
+        //Returns nothing if the planes would overlap or overrun `bytes`, or if `bytes` isn't aligned for T
+        static std::optional<vector_batch_view> from_bytes(std::span<std::byte> bytes, std::size_t count, std::size_t stride) noexcept {
+            if(stride < count || reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(T) != 0) return std::nullopt;
+            if(count != 0 && bytes.size_bytes() / sizeof(T) < (Dims - 1) * stride + count) return std::nullopt;
+            return vector_batch_view(reinterpret_cast<T*>(bytes.data()), count, stride);
+        }
+        //Views `bytes` as exactly Dims tightly packed planes, so its size must be a multiple of Dims * sizeof(T)
+        static std::optional<vector_batch_view> from_bytes(std::span<std::byte> bytes) noexcept {
+            if(bytes.size_bytes() % (Dims * sizeof(T)) != 0) return std::nullopt;
+            const std::size_t count = bytes.size_bytes() / (Dims * sizeof(T));
+            return from_bytes(bytes, count, count);
+        }
+
+    public:
+        constexpr std::span<T      > component(std::size_t c)       noexcept { return {ptr + c * plane_stride, count}; }
+        constexpr std::span<T const> component(std::size_t c) const noexcept { return {ptr + c * plane_stride, count}; }
+
+        constexpr std::size_t size() const noexcept { return count; }
+        constexpr std::size_t stride() const noexcept { return plane_stride; }
+        constexpr bool empty() const noexcept { return count == 0; }
+
+        constexpr T      * data()       noexcept { return ptr; }
+        constexpr T const* data() const noexcept { return ptr; }
+        std::span<std::byte const> bytes() const noexcept { return std::as_bytes(std::span<T const>{ptr, Dims * plane_stride}); }
+
+    private:
+        T* ptr = nullptr;
+        std::size_t count = 0;
+        std::size_t plane_stride = 0;
+    };
+
+
+    template<std::size_t Dims, typename T, impl::vec_data_type HoldsData = impl::vec_data_type::point>
+    class vector_batch : public impl::vector_batch_ops<Dims, T, HoldsData, vector_batch<Dims, T, HoldsData>> {
+        using base_type = impl::vector_batch_ops<Dims, T, HoldsData, vector_batch<Dims, T, HoldsData>>;
+    public:
+        using typename base_type::value_type;
+
+    public:
+        constexpr vector_batch() noexcept = default;
+        constexpr explicit vector_batch(std::size_t count) noexcept : planes(Dims * count), count(count), cap(count) {}
+        constexpr vector_batch(std::span<value_type const> values) noexcept;
+
+    public:
+        constexpr void reserve(std::size_t new_capacity) noexcept;
+        constexpr void resize(std::size_t new_size) noexcept;
+        constexpr void clear() noexcept { count = 0; }
+        constexpr void push_back(value_type v) noexcept;
+
+        //Packs the planes tightly (stride() == size()) so that bytes() can be copied in a single block
+        constexpr void shrink_to_fit() noexcept;
+
+    public:
+        constexpr std::span<T      > component(std::size_t c)       noexcept { return {planes.data() + c * cap, count}; }
+        constexpr std::span<T const> component(std::size_t c) const noexcept { return {planes.data() + c * cap, count}; }
+
+        constexpr std::size_t size() const noexcept { return count; }
+        constexpr std::size_t capacity() const noexcept { return cap; }
+        constexpr std::size_t stride() const noexcept { return cap; }
+        constexpr bool empty() const noexcept { return count == 0; }
+
+        constexpr T      * data()       noexcept { return planes.data(); }
+        constexpr T const* data() const noexcept { return planes.data(); }
+        std::span<std::byte const> bytes() const noexcept { return std::as_bytes(std::span<T const>{planes}); }
+
+        constexpr vector_batch_view<Dims, T, HoldsData> view() noexcept { return {planes.data(), count, cap}; }
+        constexpr operator vector_batch_view<Dims, T, HoldsData>() noexcept { return view(); }
+
+    private:
+        constexpr void repack(std::size_t new_capacity) noexcept;
+
+    private:
+        std::vector<T> planes;
+        std::size_t count = 0;
+        std::size_t cap = 0;
+    };
+}
+
+
+namespace acma {
+    template<std::size_t Dims, typename T> using point_batch = vector_batch<Dims, T, impl::vec_data_type::point>;
+    template<std::size_t Dims, typename T> using size_batch  = vector_batch<Dims, T, impl::vec_data_type::size>;
+    template<std::size_t Dims, typename T> using point_batch_view = vector_batch_view<Dims, T, impl::vec_data_type::point>;
+    template<std::size_t Dims, typename T> using size_batch_view  = vector_batch_view<Dims, T, impl::vec_data_type::size>;
+
+    template<typename T> using point2_batch = point_batch<2, T>;
+    template<typename T> using point3_batch = point_batch<3, T>;
+    template<typename T> using size2_batch  = size_batch<2, T>;
+    template<typename T> using size3_batch  = size_batch<3, T>;
+
+    using point2f_batch = point2_batch<float>;
+    using size2f_batch  = size2_batch<float>;
+}
+
+#include "sirius/arith/vector_batch.inl"
@@ -0,0 +1,223 @@
+#pragma once
+#include "sirius/arith/vector_batch.hpp"
+#include <algorithm>
+#include <cstring>
+
+
+namespace acma::impl {
+    template<std::size_t Dims, typename T, vec_data_type HoldsData, typename Derived>
+    constexpr typename vector_batch_ops<Dims, T, HoldsData, Derived>::value_type vector_batch_ops<Dims, T, HoldsData, Derived>::operator[](std::size_t i) const noexcept {
+        value_type ret;
+        for(std::size_t c = 0; c < Dims; ++c)
+            ret[c] = derived().component(c)[i];
+        return ret;
+    }
+
+    template<std::size_t Dims, typename T, vec_data_type HoldsData, typename Derived>
+    constexpr void vector_batch_ops<Dims, T, HoldsData, Derived>::set(std::size_t i, value_type v) noexcept {
+        for(std::size_t c = 0; c < Dims; ++c)
+            derived().component(c)[i] = v[c];
+    }
+}
+
+
+namespace acma::impl {
+    template<std::size_t Dims, typename T, vec_data_type HoldsData, typename Derived>
+    constexpr Derived& vector_batch_ops<Dims, T, HoldsData, Derived>::translate(vector<Dims, T> translate_by) noexcept {
+        const std::size_t count = derived().size();
+        for(std::size_t c = 0; c < Dims; ++c) {
+            T* plane = derived().component(c).data();
+            const T offset = translate_by[c];
+            #pragma omp simd
+            for(std::size_t i = 0; i < count; ++i)
+                plane[i] += offset;
+        }
+        return derived();
+    }
+
+    template<std::size_t Dims, typename T, vec_data_type HoldsData, typename Derived>
+    constexpr Derived& vector_batch_ops<Dims, T, HoldsData, Derived>::scale(vector<Dims, T> scale_by) noexcept {
+        const std::size_t count = derived().size();
+        for(std::size_t c = 0; c < Dims; ++c) {
+            T* plane = derived().component(c).data();
+            const T factor = scale_by[c];
+            #pragma omp simd
+            for(std::size_t i = 0; i < count; ++i)
+                plane[i] *= factor;
+        }
+        return derived();
+    }
+
+    template<std::size_t Dims, typename T, vec_data_type HoldsData, typename Derived>
+    constexpr Derived& vector_batch_ops<Dims, T, HoldsData, Derived>::scale(vector<Dims, T> scale_by, vector<Dims, T> origin) noexcept {
+        const std::size_t count = derived().size();
+        for(std::size_t c = 0; c < Dims; ++c) {
+            T* plane = derived().component(c).data();
+            const T factor = scale_by[c], o = origin[c];
+            #pragma omp simd
+            for(std::size_t i = 0; i < count; ++i)
+                plane[i] = (plane[i] - o) * factor + o;
+        }
+        return derived();
+    }
+
+
+    template<std::size_t Dims, typename T, vec_data_type HoldsData, typename Derived>
+    constexpr Derived& vector_batch_ops<Dims, T, HoldsData, Derived>::transform(matrix<Dims, Dims, T> const& m) noexcept {
+        const std::size_t count = derived().size();
+        std::array<T*, Dims> planes;
+        for(std::size_t c = 0; c < Dims; ++c) planes[c] = derived().component(c).data();
+
+        //No omp simd here: it turns src into a per-lane array before the component loops are unrolled, which keeps GCC from vectorizing
+        //the loop at all. Left alone, the component loops unroll first and the loop vectorizes (about 4-8x faster)
+        for(std::size_t i = 0; i < count; ++i) {
+            std::array<T, Dims> src;
+            for(std::size_t c = 0; c < Dims; ++c) src[c] = planes[c][i];
+            for(std::size_t r = 0; r < Dims; ++r) {
+                T dst = m[r][0] * src[0];
+                for(std::size_t c = 1; c < Dims; ++c) dst += m[r][c] * src[c];
+                planes[r][i] = dst;
+            }
+        }
+        return derived();
+    }
+
+    template<std::size_t Dims, typename T, vec_data_type HoldsData, typename Derived>
+    constexpr Derived& vector_batch_ops<Dims, T, HoldsData, Derived>::transform(matrix<Dims + 1, Dims + 1, T> const& m) noexcept {
+        const std::size_t count = derived().size();
+        std::array<T*, Dims> planes;
+        for(std::size_t c = 0; c < Dims; ++c) planes[c] = derived().component(c).data();
+
+        //No omp simd, for the same reason as the linear transform
+        for(std::size_t i = 0; i < count; ++i) {
+            std::array<T, Dims> src;
+            for(std::size_t c = 0; c < Dims; ++c) src[c] = planes[c][i];
+            for(std::size_t r = 0; r < Dims; ++r) {
+                T dst = m[r][Dims];
+                for(std::size_t c = 0; c < Dims; ++c) dst += m[r][c] * src[c];
+                planes[r][i] = dst;
+            }
+        }
+        return derived();
+    }
+
+    template<std::size_t Dims, typename T, vec_data_type HoldsData, typename Derived>
+    constexpr Derived& vector_batch_ops<Dims, T, HoldsData, Derived>::transform(affine2<T> const& m) noexcept requires (Dims == 2) {
+        const std::size_t count = derived().size();
+        T* x = derived().component(0).data();
+        T* y = derived().component(1).data();
+        const T m00 = m[0][0], m01 = m[0][1], m10 = m[1][0], m11 = m[1][1], tx = m[2][0], ty = m[2][1];
+
+        #pragma omp simd
+        for(std::size_t i = 0; i < count; ++i) {
+            const T px = x[i], py = y[i];
+            x[i] = m00 * px + m10 * py + tx;
+            y[i] = m01 * px + m11 * py + ty;
+        }
+        return derived();
+    }
+
+    template<std::size_t Dims, typename T, vec_data_type HoldsData, typename Derived>
+    constexpr Derived& vector_batch_ops<Dims, T, HoldsData, Derived>::normalize(size<Dims, T> extent) noexcept {
+        const std::size_t count = derived().size();
+        for(std::size_t c = 0; c < Dims; ++c) {
+            T* plane = derived().component(c).data();
+            const T e = extent[c];
+            #pragma omp simd
+            for(std::size_t i = 0; i < count; ++i)
+                plane[i] = static_cast<T>(2) * (plane[i] / e) - static_cast<T>(1);
+        }
+        return derived();
+    }
+}
+
+
+namespace acma::impl {
+    template<std::size_t Dims, typename T, vec_data_type HoldsData, typename Derived>
+    constexpr typename vector_batch_ops<Dims, T, HoldsData, Derived>::value_type vector_batch_ops<Dims, T, HoldsData, Derived>::min() const noexcept {
+        value_type ret{};
+        const std::size_t count = derived().size();
+        if(count == 0) return ret;
+
+        for(std::size_t c = 0; c < Dims; ++c) {
+            T const* plane = derived().component(c).data();
+            T m = plane[0];
+            #pragma omp simd reduction(min:m)
+            for(std::size_t i = 1; i < count; ++i)
+                m = plane[i] < m ? plane[i] : m;
+            ret[c] = m;
+        }
+        return ret;
+    }
+
+    template<std::size_t Dims, typename T, vec_data_type HoldsData, typename Derived>
+    constexpr typename vector_batch_ops<Dims, T, HoldsData, Derived>::value_type vector_batch_ops<Dims, T, HoldsData, Derived>::max() const noexcept {
+        value_type ret{};
+        const std::size_t count = derived().size();
+        if(count == 0) return ret;
+
+        for(std::size_t c = 0; c < Dims; ++c) {
+            T const* plane = derived().component(c).data();
+            T m = plane[0];
+            #pragma omp simd reduction(max:m)
+            for(std::size_t i = 1; i < count; ++i)
+                m = plane[i] > m ? plane[i] : m;
+            ret[c] = m;
+        }
+        return ret;
+    }
+
+    template<std::size_t Dims, typename T, vec_data_type HoldsData, typename Derived>
+    constexpr rect<T> vector_batch_ops<Dims, T, HoldsData, Derived>::bounds() const noexcept requires (Dims == 2) {
+        const value_type lo = min(), hi = max();
+        return {lo[0], lo[1], hi[0] - lo[0], hi[1] - lo[1]};
+    }
+}
+
+
+namespace acma {
+    template<std::size_t Dims, typename T, impl::vec_data_type HoldsData>
+    constexpr vector_batch<Dims, T, HoldsData>::vector_batch(std::span<value_type const> values) noexcept : vector_batch(values.size()) {
+        for(std::size_t c = 0; c < Dims; ++c) {
+            T* plane = planes.data() + c * cap;
+            for(std::size_t i = 0; i < count; ++i)
+                plane[i] = values[i][c];
+        }
+    }
+
+
+    template<std::size_t Dims, typename T, impl::vec_data_type HoldsData>
+    constexpr void vector_batch<Dims, T, HoldsData>::reserve(std::size_t new_capacity) noexcept {
+        if(new_capacity <= cap) return;
+        repack(new_capacity);
+    }
+
+    template<std::size_t Dims, typename T, impl::vec_data_type HoldsData>
+    constexpr void vector_batch<Dims, T, HoldsData>::resize(std::size_t new_size) noexcept {
+        reserve(new_size);
+        for(std::size_t c = 0; c < Dims; ++c)
+            std::fill(planes.data() + c * cap + count, planes.data() + c * cap + std::max(count, new_size), T{});
+        count = new_size;
+    }
+
+    template<std::size_t Dims, typename T, impl::vec_data_type HoldsData>
+    constexpr void vector_batch<Dims, T, HoldsData>::push_back(value_type v) noexcept {
+        if(count == cap) repack(cap ? cap * 2 : 16);
+        this->set(count++, v);
+    }
+
+    template<std::size_t Dims, typename T, impl::vec_data_type HoldsData>
+    constexpr void vector_batch<Dims, T, HoldsData>::shrink_to_fit() noexcept {
+        if(count == cap) return;
+        repack(count);
+    }
+
+    template<std::size_t Dims, typename T, impl::vec_data_type HoldsData>
+    constexpr void vector_batch<Dims, T, HoldsData>::repack(std::size_t new_capacity) noexcept {
+        std::vector<T> new_planes(Dims * new_capacity);
+        for(std::size_t c = 0; c < Dims; ++c)
+            std::copy_n(planes.data() + c * cap, count, new_planes.data() + c * new_capacity);
+        planes = std::move(new_planes);
+        cap = new_capacity;
+    }
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <array>
+#include <span>
 #include <vector>
 #include <streamline/functional/functor/generic_stateless.hpp>
 #include <streamline/memory/unique_ptr.hpp>
@@ -9,7 +10,9 @@
 #include <harfbuzz/hb.h>
 
 #include "sirius/arith/point.hpp"
+#include "sirius/arith/size.hpp"
 #include "sirius/core/error.hpp"
+#include "sirius/graphics/core/glyph_edge_buffer.hpp"
 #include "sirius/graphics/core/texture.hpp"
 
 
@@ -25,6 +28,22 @@ namespace acma {
         	constexpr double distance_range = 0.125;
         	constexpr sl::size_t glyph_scale = length_pixels;
 		}
+
+		//The part of a glyph's font_texture that it covers, i.e. its outline plus padding_em (the texels beyond that are too far from
+		//the outline to matter). Glyphs are placed against the bottom-left corner of their font_texture
+		struct glyph_extent {
+			//In pixels, at most length_pixels (and empty for glyphs without an outline, like spaces)
+			sz2u32 size;
+			//The position of the font_texture's bottom-left corner relative to the glyph's origin, in ems
+			pt2f origin;
+		};
+
+		//Where shaders/generate_glyphs.comp writes a glyph's extent: the top-left texel of it goes at offset in the image at image_index
+		//of the storage image array
+		struct glyph_target {
+			std::uint32_t image_index;
+			pt2u32 offset;
+		};
 	}
 
 
@@ -38,6 +57,28 @@ namespace acma {
  
 		result<std::vector<std::array<std::byte, font_texture::size_bytes>>>
 		decode_font(llfio::mapped_file_handle const& handle) noexcept;
+
+		//Generates the MSDF of each of glyph_ids into the same index of glyphs and extents, across the thread pool.
+		//font must be immutable (see hb_font_make_immutable), since every worker draws from it.
+		//Returns errc::invalid_argument if glyphs or extents is shorter than glyph_ids
+		result<void> generate_glyphs(
+			hb_font_t* font,
+			std::span<const unsigned int> glyph_ids,
+			std::span<std::array<std::byte, font_texture::size_bytes>> glyphs,
+			std::span<glyph_extent> extents
+		) noexcept;
+
+		//The GPU counterpart of generate_glyphs: flattens the outline of each of glyph_ids into edges (to be written into a buffer and
+		//dispatched with shaders/generate_glyphs.comp, which writes the glyph into targets at the same index), and fills in the same
+		//extents generate_glyphs does (with the same errc::invalid_argument for short spans). Runs serially, since flattening is cheap
+		//next to evaluating the distances
+		result<void> flatten_glyphs(
+			hb_font_t* font,
+			std::span<const unsigned int> glyph_ids,
+			std::span<const glyph_target> targets,
+			glyph_edge_buffer& edges,
+			std::span<glyph_extent> extents
+		) noexcept;
 		
 	};
 }
@@ -99,6 +99,7 @@ namespace acma::error {
         descriptors_not_initialized,
         font_not_found,
         texture_not_found,
+        atlas_full,
 
         acma_custom_end = 0xFFF,
 
@@ -305,7 +306,7 @@ namespace acma::error {
 
         //Number of codes (cannot be used externally as a size)
         num_duplicate_codes = 1,
-        num_unique_codes = 99,
+        num_unique_codes = 100,
         num_codes = num_unique_codes + num_duplicate_codes
     };
 }
@@ -336,6 +337,7 @@ namespace acma::error {
         {descriptors_not_initialized,        "The given descriptors have not been initialized yet"},
         {font_not_found,                     "The requested font was not found. Did you forget to insert it into the window?"},
         {texture_not_found,                  "The requested texture was not found. Did you forget to insert it into the window?"},
+        {atlas_full,                         "The texture atlas has no space left for the requested area"},
 
     
         {invalid_texture_file_format,              "The given KTX texture file contains invalid data"},
@@ -555,6 +557,7 @@ namespace acma::error {
         {descriptors_not_initialized,        bad_file_descriptor},
         {font_not_found,                     no_such_device_or_address},
         {texture_not_found,                  no_such_device_or_address},
+        {atlas_full,                         not_enough_memory},
 
 
         {invalid_texture_file_format,              invalid_argument},
@@ -0,0 +1,138 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+#include <streamline/functional/functor/generic_stateless.hpp>
+#include <streamline/memory/unique_ptr.hpp>
+
+#include <llfio.hpp>
+#include <harfbuzz/hb.h>
+
+#include "sirius/arith/point.hpp"
+#include "sirius/arith/rect.hpp"
+#include "sirius/arith/size.hpp"
+#include "sirius/core/decoder.hpp"
+#include "sirius/core/error.hpp"
+#include "sirius/core/glyph_cache.hpp"
+#include "sirius/graphics/core/atlas_packer.hpp"
+#include "sirius/graphics/core/texture_view.hpp"
+#include "sirius/vulkan/device/physical_device.hpp"
+
+
+namespace acma {
+	//Where a generated glyph is in its font's atlas, and where to draw it relative to the pen position
+	struct font_glyph {
+		//In atlas pixels (empty for glyphs without an outline, like spaces)
+		rect<std::uint32_t> atlas_rect;
+		//The position of atlas_rect's bottom-left corner and its size, in ems
+		pt2f origin;
+		sz2f size;
+		//In ems
+		float advance;
+	};
+}
+
+
+namespace acma {
+	//A font whose glyphs are only generated once they're asked for, instead of every glyph of the face up front (see decoder::decode_font).
+	//Asking for a glyph that hasn't been generated queues it, and generate_pending (i.e. once per frame) generates everything queued since
+	//the last call as one batch across the thread pool, then packs the glyphs into a shared MSDF atlas. upload then copies only the parts
+	//of the atlas that changed into an asset heap image.
+	//With use_gpu, glyphs generated once the atlas has been uploaded are instead flattened into gpu_glyphs, for shaders/generate_glyphs.comp
+	//to write straight into the atlas' image.
+	//Not thread-safe: all of it is meant to be used from the render thread
+	class font {
+	public:
+		constexpr static std::uint32_t default_atlas_length_pixels = 512;
+
+	public:
+		static result<font> create(llfio::mapped_file_handle const& handle, std::uint32_t atlas_length_pixels = default_atlas_length_pixels) noexcept;
+
+	public:
+		//The glyph the font maps the codepoint to, or 0 (.notdef) if it has none
+		std::uint32_t glyph_id(char32_t codepoint) const noexcept;
+		constexpr std::size_t glyph_count() const noexcept { return glyph_slots.size(); }
+
+		//Returns nullptr if the glyph hasn't been generated yet, in which case it's queued for the next generate_pending, or if it didn't
+		//fit in the atlas (which is never queued again). The returned pointer is invalidated by generate_pending
+		font_glyph const* find(std::uint32_t glyph_id) noexcept;
+		font_glyph const* find_codepoint(char32_t codepoint) noexcept { return find(glyph_id(codepoint)); }
+
+		//Generates the queued glyphs and packs them into the atlas. If the atlas runs out of space, the glyphs that didn't fit are
+		//dropped for good (rects are never freed from the atlas, so they'd never fit later either) and errc::atlas_full is returned
+		result<void> generate_pending() noexcept;
+		constexpr bool has_pending() const noexcept { return !pending.empty(); }
+
+		//Makes generate_pending read glyphs from (and write newly generated ones to) an on-disk glyph_cache in directory.
+		//Glyphs generated on the GPU never reach the CPU, so they aren't cached
+		result<void> use_cache(llfio::path_view directory) noexcept;
+
+		//Makes generate_pending leave the glyphs for shaders/generate_glyphs.comp (instead of decoder::generate_glyphs) if device can
+		//write to the atlas as a storage image, which is returned. Has to be called before the first upload
+		bool use_gpu(vk::physical_device const& device) noexcept;
+		//The glyphs the last generate_pending left for shaders/generate_glyphs.comp, already targeting their places in the atlas' storage
+		//image: write them into a generic buffer and dispatch them before drawing them. Empty unless use_gpu was successful
+		constexpr glyph_edge_buffer const& gpu_glyphs() const noexcept { return gpu_edges; }
+
+	public:
+		//RGBA8 MSDF atlas (a storage texture with use_gpu)
+		texture_view atlas() const noexcept;
+		constexpr std::span<const rect<std::uint32_t>> dirty_regions() const noexcept { return dirty; }
+		constexpr atlas_packer const& packer() const noexcept { return atlas_pack; }
+
+		//Uploads the atlas into the asset heap: the first call adds it as a new image, and the next ones only copy the dirty regions into it.
+		//staging must be a texture_data buffer segment that is cpu-writable, and that nothing else emplaces into an asset heap
+		//(since emplace_back adds every texture in it)
+		template<typename AssetHeapT, typename TextureDataSegmentT>
+		result<void> upload(AssetHeapT& heap, TextureDataSegmentT& staging) noexcept;
+		//The atlas' image in the asset heap it was uploaded to
+		constexpr std::size_t image_index() const noexcept { return atlas_image_idx; }
+
+	private:
+		using hb_blob_ptr = sl::unique_ptr<hb_blob_t, sl::functor::generic_stateless<hb_blob_destroy>>;
+		using hb_face_ptr = sl::unique_ptr<hb_face_t, sl::functor::generic_stateless<hb_face_destroy>>;
+		using hb_font_ptr = sl::unique_ptr<hb_font_t, sl::functor::generic_stateless<hb_font_destroy>>;
+
+		//glyph_slots values that aren't indices into glyphs
+		constexpr static std::uint32_t not_requested = std::numeric_limits<std::uint32_t>::max();
+		constexpr static std::uint32_t requested = not_requested - 1;
+		constexpr static std::uint32_t no_space = not_requested - 2;
+		//Left between glyphs in the atlas, so that filtering at a glyph's edge never reads its neighbour
+		constexpr static std::uint32_t atlas_gutter_pixels = 1;
+
+	private:
+		hb_blob_ptr blob_ptr;
+		hb_face_ptr face_ptr;
+		hb_font_ptr font_ptr;
+		double em_scale;
+
+		//Per glyph ID: its index in glyphs, requested, not_requested or no_space
+		std::vector<std::uint32_t> glyph_slots;
+		std::vector<font_glyph> glyphs;
+		std::vector<unsigned int> pending;
+		//Scratch memory for generate_pending, kept between batches
+		std::vector<std::array<std::byte, decoder::font_texture::size_bytes>> generated;
+		std::vector<decoder::glyph_extent> extents;
+		std::optional<glyph_cache> cache;
+		glyph_edge_buffer gpu_edges;
+		std::vector<decoder::glyph_target> gpu_targets;
+		bool gpu_generation = false;
+
+		std::uint32_t atlas_length;
+		std::vector<sl::byte> atlas_bytes;
+		atlas_packer atlas_pack;
+		std::vector<rect<std::uint32_t>> dirty;
+
+		bool uploaded = false;
+		std::size_t atlas_texture_idx = 0;
+		std::size_t atlas_image_idx = 0;
+		//The atlas' index in the asset heap's descriptor array for its usage
+		std::uint32_t atlas_descriptor_idx = 0;
+	};
+}
+
+
+#include "sirius/core/font.inl"
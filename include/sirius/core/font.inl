@@ -0,0 +1,34 @@
+#pragma once
+#include "sirius/core/font.hpp"
+#include <cstring>
+
+
+namespace acma {
+	template<typename AssetHeapT, typename TextureDataSegmentT>
+	result<void> font::upload(AssetHeapT& heap, TextureDataSegmentT& staging) noexcept {
+		if(!uploaded) {
+			atlas_texture_idx = staging.textures().size();
+			RESULT_VERIFY(staging.push_back(atlas()));
+			atlas_image_idx = heap.image_count();
+			atlas_descriptor_idx = static_cast<std::uint32_t>(heap.image_count(gpu_generation ? texture_usage::storage : texture_usage::sampled));
+			RESULT_VERIFY(heap.emplace_back(staging));
+			uploaded = true;
+			dirty.clear();
+			return {};
+		}
+		if(dirty.empty()) return {};
+
+		//The staging copy of the atlas has the same layout, so only the dirty rows need to be refreshed
+		constexpr std::size_t channels = decoder::font_texture::channels;
+		std::byte* const staging_atlas = staging.data() + staging.textures()[atlas_texture_idx].offset;
+		for(rect<std::uint32_t> const& region : dirty) {
+			for(std::uint32_t y = region.y(); y < region.y() + region.height(); ++y) {
+				const std::size_t offset = (static_cast<std::size_t>(y) * atlas_length + region.x()) * channels;
+				std::memcpy(staging_atlas + offset, atlas_bytes.data() + offset, region.width() * channels);
+			}
+		}
+		RESULT_VERIFY(heap.update(staging, atlas_texture_idx, atlas_image_idx, dirty));
+		dirty.clear();
+		return {};
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <llfio.hpp>
+
+#include "sirius/core/decoder.hpp"
+#include "sirius/core/error.hpp"
+
+
+namespace acma {
+	//Glyph MSDFs persisted on disk (one file per font and set of font_texture parameters), so that a glyph generated once by any process
+	//is read straight out of a memory-mapped file afterwards. The file starts with a header page, followed by a table with an entry per
+	//glyph ID and the page-aligned glyph bitmaps, so a lookup is a single index (and untouched glyphs stay sparse on disk).
+	//Any number of processes (and threads) may share the file: entries are published atomically and checksummed, so a torn or corrupt
+	//entry is treated as missing (and overwritten by the next store). A file with a mismatching header (from another version, other
+	//font_texture parameters or a different font) is rebuilt and atomically swapped in, without disturbing processes still mapping the old one
+	class glyph_cache {
+	public:
+		//Bumped whenever the file layout or the glyph generation changes
+		constexpr static std::uint32_t format_version = 2;
+
+	public:
+		static result<glyph_cache> create(llfio::path_view directory, std::span<const std::byte> font_file_bytes, std::uint32_t glyph_count) noexcept;
+
+	public:
+		//Copies the glyph out if it's cached and intact. Returns false otherwise
+		bool load(std::uint32_t glyph_id, std::array<std::byte, decoder::font_texture::size_bytes>& glyph, decoder::glyph_extent& extent) const noexcept;
+		void store(std::uint32_t glyph_id, std::array<std::byte, decoder::font_texture::size_bytes> const& glyph, decoder::glyph_extent extent) noexcept;
+
+		constexpr std::uint32_t glyph_count() const noexcept { return glyphs; }
+
+	private:
+		std::byte* entry_address(std::uint32_t glyph_id) const noexcept;
+		std::byte* glyph_address(std::uint32_t glyph_id) const noexcept;
+
+	private:
+		llfio::mapped_file_handle handle;
+		std::uint32_t glyphs = 0;
+		std::uint64_t entries_offset = 0;
+		std::uint64_t glyphs_offset = 0;
+		std::uint64_t glyph_stride = 0;
+	};
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+
+namespace acma::impl {
+	//wyhash's 64x64->128 bit multiply-and-fold
+	constexpr std::uint64_t mum(std::uint64_t a, std::uint64_t b) noexcept {
+		const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+		return static_cast<std::uint64_t>(r) ^ static_cast<std::uint64_t>(r >> 64);
+	}
+
+	//wyhash's default secrets
+	constexpr std::array<std::uint64_t, 4> hash_secret{0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull};
+
+
+	//Non-cryptographic hash (in the style of wyhash) of any bytes, fast enough to run over a whole file
+	inline std::uint64_t hash_bytes(std::span<const std::byte> bytes, std::uint64_t seed = 0) noexcept {
+		std::uint64_t h = seed ^ hash_secret[0];
+		std::size_t i = 0;
+		for(; i + 16 <= bytes.size(); i += 16) {
+			std::array<std::uint64_t, 2> words;
+			std::memcpy(words.data(), bytes.data() + i, sizeof(words));
+			h = mum(words[0] ^ h ^ hash_secret[1], words[1] ^ hash_secret[2]);
+		}
+		//Zero-padded (an empty span's data may be null, which memcpy doesn't allow even for no bytes)
+		std::array<std::uint64_t, 2> tail{};
+		if(i < bytes.size()) std::memcpy(tail.data(), bytes.data() + i, bytes.size() - i);
+		h = mum(tail[0] ^ h ^ hash_secret[1], tail[1] ^ hash_secret[2]);
+		return mum(h ^ hash_secret[3], bytes.size() ^ hash_secret[0]);
+	}
+
+	template<typename T>
+	std::uint64_t hash_object(T const& t, std::uint64_t seed = 0) noexcept {
+		return hash_bytes(std::as_bytes(std::span<const T, 1>(&t, 1)), seed);
+	}
+}
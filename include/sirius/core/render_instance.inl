@@ -244,6 +244,7 @@ namespace acma {
 		static_assert(impl::window_capability, "Cannot poll window events with windowing capabilities disabled");
 		if(!has_window) return;
 		
+		this->flush_pending_input();
         glfwPollEvents();
 
 		if(!this->window_handle) [[unlikely]] return;
@@ -307,6 +308,7 @@ namespace acma {
 			.image_index = 0
 		};
 		
+		if(has_window) this->swap_input_state();
 		D2D_INVOKE_ALL(this->timeline_callbacks(), on_frame_begin, *this, *this, timeline_state);
 
 		
@@ -321,6 +323,7 @@ namespace acma {
 
         //frame_idx = (frame_idx + 1) % impl::frames_in_flight;
         ++this->_frame_count;
+		if(has_window) this->end_input_frame();
 		//this->frame_count.fetch_add();
         return {};
     }
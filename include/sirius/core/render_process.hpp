@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <memory>
+#include <span>
 #include <streamline/functional/functor/subscript.hpp>
 #include <streamline/functional/functor/identity_index.hpp>
 #include <streamline/functional/functor/generic_stateless.hpp>
@@ -166,7 +167,8 @@ namespace acma {
 
 	public:
 		constexpr result<sl::uint64_t> begin_dedicated_copy(sl::index_t command_group_idx, sl::uint64_t timeout) & noexcept;
-		constexpr result<void> end_dedicated_copy(sl::uint64_t wait_value, sl::index_t command_group_idx, sl::uint64_t timeout) const& noexcept;
+		//The copy's submission waits on wait_semaphore_infos first
+		constexpr result<void> end_dedicated_copy(sl::uint64_t wait_value, sl::index_t command_group_idx, sl::uint64_t timeout, std::span<const vk::semaphore_submit_info> wait_semaphore_infos = {}) const& noexcept;
 
 
 	protected:
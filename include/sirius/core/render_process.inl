@@ -141,7 +141,7 @@ namespace acma{
 
 	template<auto BufferConfigs, auto AssetHeapConfigs, sl::size_t CommandGroupCount>
 	constexpr result<void>    render_process<BufferConfigs, AssetHeapConfigs, CommandGroupCount>::
-	end_dedicated_copy(sl::uint64_t wait_value, sl::index_t command_group_idx, sl::uint64_t timeout) const& noexcept {
+	end_dedicated_copy(sl::uint64_t wait_value, sl::index_t command_group_idx, sl::uint64_t timeout, std::span<const vk::semaphore_submit_info> wait_semaphore_infos) const& noexcept {
 		const sl::index_t frame_idx = frame_index();
 
 		const vk::semaphore_submit_info semaphore_signal_info{
@@ -152,7 +152,7 @@ namespace acma{
 
 		vk::command_buffer const& transfer_command_buffer = command_buffers()[frame_idx][command_group_idx];
 		RESULT_VERIFY(transfer_command_buffer.end());
-		RESULT_VERIFY(transfer_command_buffer.submit(command_family::transfer, {}, {&semaphore_signal_info, 1}));
+		RESULT_VERIFY(transfer_command_buffer.submit(command_family::transfer, wait_semaphore_infos, {&semaphore_signal_info, 1}));
 
 
 		RESULT_VERIFY(command_buffer_semaphores()[frame_idx][command_group_idx].wait(wait_value, timeout));
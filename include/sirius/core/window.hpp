@@ -2,6 +2,7 @@
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <span>
 #include <string_view>
 #include <streamline/functional/functor/generic_stateless.hpp>
 
@@ -9,11 +10,18 @@
 #include "sirius/core/window.fwd.hpp"
 #include "sirius/arith/size.hpp"
 #include "sirius/input/category.hpp"
+#include "sirius/input/coalescing.hpp"
 #include "sirius/input/code.hpp"
 #include "sirius/core/error.hpp"
 #include "sirius/input/event_function.hpp"
+#include "sirius/input/event_queue.hpp"
+#include "sirius/input/input_state.hpp"
+#include "sirius/input/late_latch.hpp"
+#include "sirius/input/latency_stats.hpp"
 #include "sirius/input/map_types.hpp"
 #include "sirius/input/modifier_flags.hpp"
+#include "sirius/input/recording.hpp"
+#include "sirius/input/window_info.hpp"
 #include "sirius/vulkan/core/instance.hpp"
 #include "sirius/vulkan/display/surface.hpp"
 #include "sirius/vulkan/display/swap_chain.hpp"
@@ -26,6 +34,7 @@ namespace acma {
         constexpr window() noexcept :
             category_flags(static_cast<input::category_flags_t>(0b1) << input::category::system),
             active_bindings(), inactive_bindings(), event_fns(), text_input_fn(), modifier_flags{},
+            coalescing(), move_coalescer(), scroll_coalescer(), current_motion(), polled_input(), latched_input(), input_recorder(nullptr), latency(),
 			window_handle(), _surface{}, _swap_chain{}, _depth_image{}, _size{} {}
 	public:
         inline static result<window> create(
@@ -59,9 +68,51 @@ namespace acma {
         constexpr auto&& input_event_functions   (this auto&& self) noexcept { return sl::forward_like<decltype(self)>(self.event_fns); }
         constexpr auto&& text_input_function     (this auto&& self) noexcept { return sl::forward_like<decltype(self)>(self.text_input_fn); }
         constexpr auto&& input_modifier_flags    (this auto&& self) noexcept { return sl::forward_like<decltype(self)>(self.modifier_flags); }
+        //Read by the thread draining the input queue, so only change it while no input is being processed (e.g. before the first poll_events)
+        constexpr auto&& input_coalescing        (this auto&& self) noexcept { return sl::forward_like<decltype(self)>(self.coalescing); }
+        //Only meaningful from a mouse move or scroll event function
+        constexpr input::pointer_motion const& input_pointer_motion() const noexcept { return current_motion; }
+        //Only available if SIRIUS_INPUT_LATENCY_STATS is defined as true. Safe to read (or reset) from any thread
+        constexpr auto&& input_latency_stats     (this auto&& self) noexcept requires input::impl::latency_stats_enabled { return sl::forward_like<decltype(self)>(self.latency); }
+
+    public:
+        //Lock-free snapshot of the currently held inputs (e.g. for the render thread). main_input is the last processed input
+        inline input::combination input_combination() const noexcept;
+        //Flushes the cursor motion and scrolls merged during this frame (for input::coalesce_mode::per_frame).
+        //Can be called from any thread: the end of the frame is queued by the next render_instance::poll_events
+        inline void end_input_frame() noexcept;
+
+    public:
+        //The input of the last frame, for polling instead of (or along with) event functions. Only read it from the thread swapping it
+        constexpr input::input_snapshot const& input_state() const noexcept { return polled_input.snapshot(); }
+        //Takes in all the input since the last swap. render_instance::render does this before the on_frame_begin callbacks
+        input::input_snapshot const& swap_input_state() noexcept { return polled_input.swap(); }
+        //The cursor and mouse buttons as of the last GLFW callback, before the input is even queued (see timeline::predefined_callbacks::late_latch_input).
+        //Lock-free, so it can be read from any thread
+        input::late_latch_data latest_pointer_input() const noexcept { return latched_input.load(); }
+
+    public:
+        //Records every event arriving from the GLFW callbacks (with its timestamp) into r until called with nullptr.
+        //Only change it from the thread polling events
+        constexpr void record_input(input::recorder* r) noexcept { input_recorder = r; }
+        //Processes recorded events on the calling thread, the same way as live ones (coalescing, bindings and event functions),
+        //starting with no inputs held. Doesn't need a GLFW window, so it also works on a default-constructed window (e.g. for tests
+        //and benchmarks). Don't replay while live input is being processed
+        inline void replay_input(std::span<input::event_record const> records, input::replay_speed speed = input::replay_speed::full) noexcept;
 
     private:
-        inline static void process_input(GLFWwindow* window_ptr, input::code_t code, bool pressed, input::mouse_aux_t mouse_aux_data) noexcept;
+        inline static void process_input(GLFWwindow* window_ptr, input::impl::window_info& info, input::code_t code, bool pressed, input::mouse_aux_t mouse_aux_data) noexcept;
+        inline static void queue_input(GLFWwindow* window_ptr, input::event_record record) noexcept;
+        inline static void push_input(GLFWwindow* window_ptr, input::impl::window_info& info, input::event_record const& record) noexcept;
+        inline static void push_overflow_input(GLFWwindow* window_ptr, input::impl::window_info& info) noexcept;
+        inline static void schedule_input_drain(GLFWwindow* window_ptr, input::impl::window_info& info) noexcept;
+        //Moves the records that overflowed the input queue into it, as space frees up, then queues the end of the last rendered frame.
+        //Called by render_instance::poll_events, before polling so that the input polled next goes to the next frame
+        inline void flush_pending_input() noexcept;
+        inline static void process_queued_input(GLFWwindow* window_ptr, input::impl::window_info& info) noexcept;
+        inline static void process_input_records(GLFWwindow* window_ptr, input::impl::window_info& info, std::span<input::event_record const> records) noexcept;
+        inline static void flush_coalesced_input(GLFWwindow* window_ptr, input::impl::window_info& info) noexcept;
+        inline static void process_coalesced_input(GLFWwindow* window_ptr, input::impl::window_info& info, input::code_t code, input::impl::coalescer& pending) noexcept;
     private:
         inline static void kb_key_input(GLFWwindow* window_ptr, int key, int scancode, int action, int mods) noexcept;
         inline static void kb_text_input(GLFWwindow* window_ptr, unsigned int codepoint) noexcept; //not tied to a category
@@ -84,6 +135,14 @@ namespace acma {
         input::event_fns_map event_fns;
         std::function<input::text_event_function> text_input_fn;
         std::array<input::modifier_flags_t, input::num_codes> modifier_flags;
+        input::coalesce_policy coalescing;
+        input::impl::coalescer move_coalescer;
+        input::impl::coalescer scroll_coalescer;
+        input::pointer_motion current_motion;
+        input::input_state polled_input;
+        input::late_latch_state latched_input;
+        input::recorder* input_recorder;
+        [[no_unique_address]] input::impl::latency_stats_t latency;
     private:
         std::unique_ptr<GLFWwindow, sl::functor::generic_stateless<glfwDestroyWindow>> window_handle;
 		vk::surface _surface;
@@ -1,9 +1,12 @@
 #pragma once
 #include "sirius/core/window.hpp"
 
+#include <chrono>
 #include <cstring>
 #include <memory>
+#include <span>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <streamline/functional/functor/generic_stateless.hpp>
 #include <streamline/functional/functor/subscript.hpp>
@@ -21,6 +24,7 @@
 #include "sirius/core/error.hpp"
 #include "sirius/core/thread_pool.hpp"
 #include "sirius/input/codes_map.hpp"
+#include "sirius/input/event_queue.hpp"
 #include "sirius/input/window_info.hpp"
 #include "sirius/timeline/state.hpp"
 #include "sirius/input/combination.hpp"
@@ -117,17 +121,17 @@ namespace acma {
 
 
 namespace acma {
-    void window::process_input(GLFWwindow* window_ptr, input::code_t code, bool pressed, input::mouse_aux_t mouse_aux_data) noexcept {
-        auto window_info_it = input::impl::glfw_window_map().find(window_ptr);
-        if(window_info_it == input::impl::glfw_window_map().end()) [[unlikely]] return;
-        window* win_ptr = static_cast<window*>(window_info_it->second.window_ptr);
-
-        std::unique_lock<std::mutex> current_combo_lock(window_info_it->second.combo_mutex);
-        window_info_it->second.current_combo.main_input() = code;
-        window_info_it->second.current_combo.set(code, false);
-        input::combination combo = (win_ptr->input_modifier_flags()[code] & input::modifier_flags::no_modifiers_allowed) ? input::combination{{}, code} : window_info_it->second.current_combo;
-        window_info_it->second.current_combo.set(code, pressed);
-        current_combo_lock.unlock();
+    void window::process_input(GLFWwindow* window_ptr, input::impl::window_info& info, input::code_t code, bool pressed, input::mouse_aux_t mouse_aux_data) noexcept {
+        window* win_ptr = static_cast<window*>(info.window_ptr);
+        const input::impl::latency_timer lookup_timer;
+
+        //Only the thread draining the event queue writes the combination, so it can read, modify and store it without a lock
+        input::combination current = info.current_combo.last_stored();
+        current.main_input() = code;
+        current.set(code, false);
+        input::combination combo = (win_ptr->input_modifier_flags()[code] & input::modifier_flags::no_modifiers_allowed) ? input::combination{{}, code} : current;
+        current.set(code, pressed);
+        info.current_combo.store(current);
         
         input::binding_map const& bind_map = pressed ? win_ptr->input_active_bindings() : win_ptr->input_inactive_bindings();
         auto event_set_it = bind_map.find(combo);
@@ -143,17 +147,21 @@ namespace acma {
         event_set_it = bind_map.find(input::combination{{acma::input::generic_code::any}, acma::input::generic_code::any});
         if(event_set_it != bind_map.end()) goto invoke_event;
 
+        lookup_timer.stop(win_ptr->latency.lookup);
         return;
         
     invoke_event:
+        lookup_timer.stop(win_ptr->latency.lookup);
         input::category_flags_t category_flags = win_ptr->current_input_categories() & event_set_it->second.applicable_categories;
         //const unsigned long long category_flags = category_bitset.to_ullong();
         while(category_flags.any()) {
             input::category_id_t category_id = input::max_category_id - std::countl_zero(category_flags.to_ullong());
             input::event_id_t event_id = event_set_it->second.event_ids[category_id];
-            auto event_fn_it = win_ptr->input_event_functions().find(input::categorized_event_t{event_id, category_id});
-            if(event_fn_it != win_ptr->input_event_functions().end()) {
-                std::invoke(event_fn_it->second, win_ptr, combo, pressed, input::categorized_event_t{event_id, category_id}, mouse_aux_data, glfwGetWindowUserPointer(window_ptr));
+            if(input::event_function_ref event_fn = win_ptr->input_event_functions().find(input::categorized_event_t{event_id, category_id})) {
+                const input::impl::latency_timer handler_timer;
+                //Replayed input may have no GLFW window behind it
+                event_fn(win_ptr, combo, pressed, input::categorized_event_t{event_id, category_id}, mouse_aux_data, window_ptr ? glfwGetWindowUserPointer(window_ptr) : nullptr);
+                handler_timer.stop(win_ptr->latency.handler);
                 //return;
             }
             category_flags.reset(category_id);
@@ -161,6 +169,152 @@ namespace acma {
     }
 
 
+    void window::queue_input(GLFWwindow* window_ptr, input::event_record record) noexcept {
+        auto window_info_it = input::impl::glfw_window_map().find(window_ptr);
+        if(window_info_it == input::impl::glfw_window_map().end()) [[unlikely]] return;
+        input::impl::window_info& info = window_info_it->second;
+        window* win_ptr = static_cast<window*>(info.window_ptr);
+        record.time_us = input::event_record::now_us();
+        win_ptr->latched_input.record(record);
+        if(input::recorder* r = win_ptr->input_recorder) [[unlikely]] r->record(record);
+        push_input(window_ptr, info, record);
+    }
+
+    void window::push_input(GLFWwindow* window_ptr, input::impl::window_info& info, input::event_record const& record) noexcept {
+        if(!info.overflow_input.empty()) [[unlikely]] push_overflow_input(window_ptr, info);
+        //A full queue means a drain is already pending, so rather than waiting on it (and stalling the GLFW callbacks), keep the record
+        //until the drain frees up space. Once one record overflows, the later ones queue up behind it to stay in order
+        if(!info.overflow_input.empty() || !info.queued_input.push(record)) [[unlikely]] {
+            info.overflow_input.push_back(record);
+            return;
+        }
+        schedule_input_drain(window_ptr, info);
+    }
+
+    void window::push_overflow_input(GLFWwindow* window_ptr, input::impl::window_info& info) noexcept {
+        std::size_t pushed = 0;
+        for(; pushed < info.overflow_input.size() && info.queued_input.push(info.overflow_input[pushed]); ++pushed)
+            schedule_input_drain(window_ptr, info);
+        info.overflow_input.erase(info.overflow_input.begin(), info.overflow_input.begin() + static_cast<std::ptrdiff_t>(pushed));
+    }
+
+    void window::schedule_input_drain(GLFWwindow* window_ptr, input::impl::window_info& info) noexcept {
+        if(!info.queued_input.request_drain()) return;
+        //Only captures 2 pointers, so unlike the std::bind of process_input's arguments, this fits in the task's small buffer
+        thread_pool().detach_task([window_ptr, &info]() noexcept { process_queued_input(window_ptr, info); });
+    }
+
+    void window::flush_pending_input() noexcept {
+        GLFWwindow* const window_ptr = window_handle.get();
+        auto window_info_it = input::impl::glfw_window_map().find(window_ptr);
+        if(window_info_it == input::impl::glfw_window_map().end()) [[unlikely]] return;
+        input::impl::window_info& info = window_info_it->second;
+
+        if(!info.overflow_input.empty()) [[unlikely]] push_overflow_input(window_ptr, info);
+        //Through queue_input like the GLFW callbacks, so the marker is recorded too, and queues up behind any overflow
+        if(info.frame_ended.exchange(false, std::memory_order_acq_rel))
+            queue_input(window_ptr, input::event_record{{}, 0, input::key_code::none, input::input_action::end_frame, false});
+    }
+
+    void window::process_queued_input(GLFWwindow* window_ptr, input::impl::window_info& info) noexcept {
+        window* win_ptr = static_cast<window*>(info.window_ptr);
+        info.queued_input.drain([&](std::span<input::event_record const> batch) noexcept {
+            if constexpr(input::impl::latency_stats_enabled) {
+                const std::uint32_t now_us = input::event_record::now_us();
+                for(input::event_record const& record : batch)
+                    if(record.action != input::input_action::end_frame) win_ptr->latency.queueing.record(std::chrono::microseconds{now_us - record.time_us});
+            }
+            process_input_records(window_ptr, info, batch);
+        }, [&]() noexcept {
+            //Only per_frame holds merged motion past the end of the queue (until the end_frame record)
+            if(win_ptr->coalescing.mode != input::coalesce_mode::per_frame) flush_coalesced_input(window_ptr, info);
+        });
+    }
+
+    void window::process_input_records(GLFWwindow* window_ptr, input::impl::window_info& info, std::span<input::event_record const> records) noexcept {
+        window* win_ptr = static_cast<window*>(info.window_ptr);
+        const input::coalesce_policy policy = win_ptr->coalescing;
+        for(input::event_record const& record : records) {
+            win_ptr->polled_input.record(record);
+            if(record.action == input::input_action::end_frame) {
+                flush_coalesced_input(window_ptr, info);
+                continue;
+            }
+
+            if(record.code == input::mouse_code::move || record.code == input::mouse_code::scroll) {
+                input::impl::coalescer& pending = record.code == input::mouse_code::move ? win_ptr->move_coalescer : win_ptr->scroll_coalescer;
+                if(pending.splits(record, policy)) process_coalesced_input(window_ptr, info, record.code, pending);
+                pending.add(record);
+                continue;
+            }
+
+            //Keep merged motion ordered before the keys and buttons that came after it
+            flush_coalesced_input(window_ptr, info);
+            if(record.action != input::input_action::release)
+                process_input(window_ptr, info, record.code, true, record.mouse_aux());
+            if(record.action != input::input_action::press)
+                process_input(window_ptr, info, record.code, false, record.mouse_aux());
+        }
+    }
+
+    void window::flush_coalesced_input(GLFWwindow* window_ptr, input::impl::window_info& info) noexcept {
+        window* win_ptr = static_cast<window*>(info.window_ptr);
+        process_coalesced_input(window_ptr, info, input::mouse_code::move, win_ptr->move_coalescer);
+        process_coalesced_input(window_ptr, info, input::mouse_code::scroll, win_ptr->scroll_coalescer);
+    }
+
+    void window::process_coalesced_input(GLFWwindow* window_ptr, input::impl::window_info& info, input::code_t code, input::impl::coalescer& pending) noexcept {
+        if(!pending.pending()) return;
+        window* win_ptr = static_cast<window*>(info.window_ptr);
+        win_ptr->current_motion = pending.merged(code == input::mouse_code::scroll);
+        process_input(window_ptr, info, code, true, win_ptr->current_motion.position);
+        process_input(window_ptr, info, code, false, win_ptr->current_motion.position);
+        pending.clear();
+    }
+
+    input::combination window::input_combination() const noexcept {
+        auto window_info_it = input::impl::glfw_window_map().find(window_handle.get());
+        if(window_info_it == input::impl::glfw_window_map().end()) [[unlikely]] return input::combination{{}, input::key_code::none};
+        return window_info_it->second.current_combo.load();
+    }
+
+    void window::replay_input(std::span<input::event_record const> records, input::replay_speed speed) noexcept {
+        if(records.empty()) return;
+        //Separate from the live window_info, whose combination state has the drain as its only writer
+        const std::unique_ptr<input::impl::window_info> info = std::make_unique<input::impl::window_info>();
+        info->window_ptr = this;
+        GLFWwindow* const window_ptr = window_handle.get();
+
+        if(speed == input::replay_speed::full) process_input_records(window_ptr, *info, records);
+        else {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            const std::uint32_t first_us = records.front().time_us;
+            const auto recorded_at = [&](input::event_record const& r) noexcept { return start + std::chrono::microseconds{r.time_us - first_us}; };
+            for(std::size_t i = 0; i < records.size();) {
+                std::this_thread::sleep_until(recorded_at(records[i]));
+                //Like a drain, process everything that is due by now as one batch, then flush
+                const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                std::size_t due = i + 1;
+                while(due < records.size() && recorded_at(records[due]) <= now) ++due;
+                process_input_records(window_ptr, *info, records.subspan(i, due - i));
+                if(coalescing.mode != input::coalesce_mode::per_frame) flush_coalesced_input(window_ptr, *info);
+                i = due;
+            }
+        }
+
+        //Nothing merged during the replay is left for live input to flush
+        flush_coalesced_input(window_ptr, *info);
+    }
+
+    void window::end_input_frame() noexcept {
+        if(coalescing.mode != input::coalesce_mode::per_frame) return;
+        auto window_info_it = input::impl::glfw_window_map().find(window_handle.get());
+        if(window_info_it == input::impl::glfw_window_map().end()) [[unlikely]] return;
+        //Only flags it: the recorder and the input queue's overflow belong to the thread polling events
+        window_info_it->second.frame_ended.store(true, std::memory_order_release);
+    }
+
+
     void window::kb_key_input(GLFWwindow* window_ptr, int key, int, int action, int) noexcept {
         if(key == GLFW_KEY_UNKNOWN) return;
         switch(action) {
@@ -171,7 +325,7 @@ namespace acma {
             return;
         }
 
-        thread_pool().detach_task(std::bind(process_input, window_ptr, input::codes_map[key], static_cast<bool>(action), input::mouse_aux_t{}));
+        queue_input(window_ptr, input::event_record{{}, 0, input::codes_map[key], action == GLFW_PRESS ? input::input_action::press : input::input_action::release, false});
         //return process_input(window_ptr, input::codes_map[key], static_cast<bool>(action), input::mouse_aux_t{});
     }
 
@@ -179,6 +333,7 @@ namespace acma {
         auto window_info_it = input::impl::glfw_window_map().find(window_ptr);
         if(window_info_it == input::impl::glfw_window_map().end()) [[unlikely]] return;
         window* win_ptr = static_cast<window*>(window_info_it->second.window_ptr);
+        win_ptr->polled_input.record_text(codepoint);
 
         std::function<input::text_event_function> const& text_input_fn = win_ptr->text_input_function();
         if(!text_input_fn) return;
@@ -187,18 +342,16 @@ namespace acma {
     }
 
     void window::mouse_move(GLFWwindow* window_ptr, double x, double y) noexcept {
-        thread_pool().detach_task(std::bind(process_input, window_ptr, input::mouse_code::move, true, input::mouse_aux_t{pt2d{x, y}}));
-        thread_pool().detach_task(std::bind(process_input, window_ptr, input::mouse_code::move, false, input::mouse_aux_t{pt2d{x, y}}));
+        queue_input(window_ptr, input::event_record{pt2d{x, y}, 0, input::mouse_code::move, input::input_action::press_release, true});
         //return process_input(window_ptr, input::mouse_code::move, std::nullopt, pt2d{x, y});
     }
 
     void window::mouse_button_input(GLFWwindow* window_ptr, int button, int action, int) noexcept {
-        thread_pool().detach_task(std::bind(process_input, window_ptr, input::codes_map[button], static_cast<bool>(action), input::mouse_aux_t{}));
+        queue_input(window_ptr, input::event_record{{}, 0, input::codes_map[button], action == GLFW_PRESS ? input::input_action::press : input::input_action::release, false});
         //return process_input(window_ptr, input::codes_map[button], static_cast<bool>(action), input::mouse_aux_t{});
     }
 
     void window::mouse_scroll(GLFWwindow* window_ptr, double x, double y) noexcept {
-        thread_pool().detach_task(std::bind(process_input, window_ptr, input::mouse_code::scroll, true, input::mouse_aux_t{-pt2d{x, y}}));
-        thread_pool().detach_task(std::bind(process_input, window_ptr, input::mouse_code::scroll, false, input::mouse_aux_t{-pt2d{x, y}}));
+        queue_input(window_ptr, input::event_record{-pt2d{x, y}, 0, input::mouse_code::scroll, input::input_action::press_release, true});
     }
 }
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "sirius/arith/point.hpp"
+#include "sirius/arith/size.hpp"
+
+
+namespace acma {
+	//Skyline bottom-left rect packer for texture atlases (filling from the top, since that's where images start): keeps the bottom edge
+	//of everything packed so far as a list of horizontal segments, and places each rect where its own bottom edge ends up highest
+	//(breaking ties by the narrowest segment, to leave wide gaps for wide rects).
+	//Rects are never removed; clear the packer (and the atlas) to start over
+	class atlas_packer {
+	public:
+		constexpr atlas_packer() noexcept = default;
+		explicit atlas_packer(sz2u32 atlas_extent) noexcept;
+
+	public:
+		//Returns the top-left corner of a free area of the given size, or nothing if the atlas has no room left for it
+		std::optional<pt2u32> insert(sz2u32 rect_size) noexcept;
+		void clear() noexcept;
+
+	public:
+		constexpr sz2u32 extent() const noexcept { return atlas_extent; }
+		//The area covered by the inserted rects, in pixels (i.e. divide by the atlas' area for the occupancy)
+		constexpr std::uint64_t used_area() const noexcept { return used; }
+
+	private:
+		struct skyline_segment {
+			std::uint32_t x;
+			std::uint32_t y;
+			std::uint32_t width;
+		};
+
+		//The y at which a rect of the given size fits on top of the skyline starting at segment i, if it fits at all
+		std::optional<std::uint32_t> fit(std::size_t i, sz2u32 rect_size) const noexcept;
+
+	private:
+		std::vector<skyline_segment> skyline;
+		sz2u32 atlas_extent{};
+		std::uint64_t used = 0;
+	};
+}
+
+
+#include "sirius/graphics/core/atlas_packer.inl"
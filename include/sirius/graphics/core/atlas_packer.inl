@@ -0,0 +1,84 @@
+#pragma once
+#include "sirius/graphics/core/atlas_packer.hpp"
+#include <algorithm>
+#include <limits>
+
+
+namespace acma {
+	inline atlas_packer::atlas_packer(sz2u32 atlas_extent) noexcept : atlas_extent(atlas_extent) {
+		clear();
+	}
+
+	inline void atlas_packer::clear() noexcept {
+		skyline.clear();
+		skyline.push_back(skyline_segment{0, 0, atlas_extent.width()});
+		used = 0;
+	}
+}
+
+
+namespace acma {
+	inline std::optional<std::uint32_t> atlas_packer::fit(std::size_t i, sz2u32 rect_size) const noexcept {
+		const std::uint32_t x = skyline[i].x;
+		if(rect_size.width() > atlas_extent.width() - x) return std::nullopt;
+
+		//The rect rests on the lowest of the segments it spans
+		std::uint32_t y = 0;
+		for(std::uint32_t width_left = rect_size.width(); width_left > 0; ++i) {
+			y = std::max(y, skyline[i].y);
+			if(rect_size.height() > atlas_extent.height() - y) return std::nullopt;
+			width_left -= std::min(width_left, skyline[i].width);
+		}
+		return y;
+	}
+
+	inline std::optional<pt2u32> atlas_packer::insert(sz2u32 rect_size) noexcept {
+		if(rect_size.width() == 0 || rect_size.height() == 0) return pt2u32{};
+
+		std::size_t best = skyline.size();
+		std::uint32_t best_bottom = std::numeric_limits<std::uint32_t>::max();
+		std::uint32_t best_width = std::numeric_limits<std::uint32_t>::max();
+		std::uint32_t best_y = 0;
+		for(std::size_t i = 0; i < skyline.size(); ++i) {
+			const std::optional<std::uint32_t> y = fit(i, rect_size);
+			if(!y) continue;
+			const std::uint32_t bottom = *y + rect_size.height();
+			if(bottom < best_bottom || (bottom == best_bottom && skyline[i].width < best_width)) {
+				best = i;
+				best_bottom = bottom;
+				best_width = skyline[i].width;
+				best_y = *y;
+			}
+		}
+		if(best == skyline.size()) return std::nullopt;
+
+		const pt2u32 pos{skyline[best].x, best_y};
+		skyline.insert(skyline.begin() + best, skyline_segment{pos.x(), best_bottom, rect_size.width()});
+
+		//Cut the segments now under the rect
+		const std::uint32_t right = pos.x() + rect_size.width();
+		std::size_t i = best + 1;
+		while(i < skyline.size() && skyline[i].x < right) {
+			const std::uint32_t segment_right = skyline[i].x + skyline[i].width;
+			if(segment_right > right) {
+				skyline[i].width = segment_right - right;
+				skyline[i].x = right;
+				break;
+			}
+			++i;
+		}
+		skyline.erase(skyline.begin() + best + 1, skyline.begin() + i);
+
+		//Merge neighbours at the same height, so that the skyline stays as short as possible
+		for(std::size_t j = best > 0 ? best - 1 : 0; j + 1 < skyline.size() && j <= best + 1;) {
+			if(skyline[j].y == skyline[j + 1].y) {
+				skyline[j].width += skyline[j + 1].width;
+				skyline.erase(skyline.begin() + j + 1);
+			}
+			else ++j;
+		}
+
+		used += std::uint64_t{rect_size.width()} * rect_size.height();
+		return pos;
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "sirius/graphics/core/color.hpp"
+
+
+namespace acma::impl {
+    template<typename T>
+    concept color_component = std::is_same_v<T, std::uint8_t> || std::is_same_v<T, std::uint16_t>;
+
+    //With 2 or 4 channels, the last channel is alpha (which is always linear)
+    template<std::size_t Channels>
+    constexpr bool has_alpha_channel = Channels == 2 || Channels == 4;
+    template<std::size_t Channels>
+    constexpr std::size_t color_channels = has_alpha_channel<Channels> ? Channels - 1 : Channels;
+
+    //Lookup tables are built on first use, since std::pow is not constexpr
+    inline std::array<float, 256> const& srgb8_to_linear_table() noexcept;
+    inline std::array<std::uint8_t, 256> const& srgb8_to_linear8_table() noexcept;
+    inline std::array<std::uint8_t, 256> const& linear8_to_srgb8_table() noexcept;
+    inline std::array<std::uint8_t, 8192> const& linear_to_srgb8_table() noexcept;
+    inline std::array<std::uint16_t, 65536> const& srgb16_to_linear16_table() noexcept;
+    inline std::array<std::uint16_t, 65536> const& linear16_to_srgb16_table() noexcept;
+}
+
+
+//All of these operate on spans of interleaved components (i.e. RGBARGBA...), which is how texture bytes are laid out.
+//Each loop is a straight-line loop marked omp simd, and src and dst must be the same size (in components)
+namespace acma {
+    //8-bit sRGB to floating point linear (exact, from a 256 entry table)
+    template<std::size_t Channels>
+    void srgb_to_linear(std::span<std::uint8_t const> src, std::span<float> dst) noexcept;
+    //Floating point linear (clamped to [0, 1]) to 8-bit sRGB, off by at most 1 from the exactly rounded value
+    template<std::size_t Channels>
+    void linear_to_srgb(std::span<float const> src, std::span<std::uint8_t> dst) noexcept;
+
+    //In place conversions, for converting texture bytes before they are uploaded.
+    //Note that storing linear values in 8 bits loses precision in dark colors
+    template<std::size_t Channels, impl::color_component T>
+    void srgb_to_linear(std::span<T> components) noexcept;
+    template<std::size_t Channels, impl::color_component T>
+    void linear_to_srgb(std::span<T> components) noexcept;
+
+
+    //Straight to premultiplied alpha (exactly rounded)
+    template<std::size_t Channels, impl::color_component T> requires impl::has_alpha_channel<Channels>
+    void premultiply_alpha(std::span<T> components) noexcept;
+    //Premultiplied to straight alpha. Fully transparent colors become 0
+    template<std::size_t Channels, impl::color_component T> requires impl::has_alpha_channel<Channels>
+    void unpremultiply_alpha(std::span<T> components) noexcept;
+
+
+    //8 to 16 bits per component (exact)
+    inline void widen(std::span<std::uint8_t const> src, std::span<std::uint16_t> dst) noexcept;
+    //16 to 8 bits per component (exactly rounded)
+    inline void narrow(std::span<std::uint16_t const> src, std::span<std::uint8_t> dst) noexcept;
+
+    //Span counterpart to basic_color::normalize(), writing Channels floats per color
+    template<std::size_t Channels, std::size_t BPC>
+    void normalize(std::span<basic_color<Channels, BPC> const> src, std::span<float> dst) noexcept;
+}
+
+
+namespace acma {
+    //Overloads for spans of colors, for the color types whose components fill their storage
+    template<std::size_t Channels, std::size_t BPC> requires (BPC == 8 || BPC == 16)
+    void srgb_to_linear(std::span<basic_color<Channels, BPC>> colors) noexcept;
+    template<std::size_t Channels, std::size_t BPC> requires (BPC == 8 || BPC == 16)
+    void linear_to_srgb(std::span<basic_color<Channels, BPC>> colors) noexcept;
+    template<std::size_t Channels, std::size_t BPC> requires ((BPC == 8 || BPC == 16) && impl::has_alpha_channel<Channels>)
+    void premultiply_alpha(std::span<basic_color<Channels, BPC>> colors) noexcept;
+    template<std::size_t Channels, std::size_t BPC> requires ((BPC == 8 || BPC == 16) && impl::has_alpha_channel<Channels>)
+    void unpremultiply_alpha(std::span<basic_color<Channels, BPC>> colors) noexcept;
+}
+
+
+#include "sirius/graphics/core/color_conversion.inl"
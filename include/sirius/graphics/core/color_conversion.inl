@@ -0,0 +1,210 @@
+#pragma once
+#include "sirius/graphics/core/color_conversion.hpp"
+#include <algorithm>
+#include <cmath>
+
+
+namespace acma::impl {
+    inline double srgb_decode(double c) noexcept { return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4); }
+    inline double srgb_encode(double l) noexcept { return l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1 / 2.4) - 0.055; }
+
+    template<typename T, std::size_t N, typename Fn>
+    std::array<T, N> make_color_table(Fn&& fn) noexcept {
+        std::array<T, N> table;
+        for(std::size_t i = 0; i < N; ++i)
+            table[i] = static_cast<T>(fn(static_cast<double>(i) / (N - 1)));
+        return table;
+    }
+
+    template<typename T>
+    constexpr double component_max_v = static_cast<double>(std::numeric_limits<T>::max());
+
+
+    inline std::array<float, 256> const& srgb8_to_linear_table() noexcept {
+        static const std::array<float, 256> table = make_color_table<float, 256>([](double c) noexcept { return srgb_decode(c); });
+        return table;
+    }
+
+    inline std::array<std::uint8_t, 256> const& srgb8_to_linear8_table() noexcept {
+        static const std::array<std::uint8_t, 256> table = make_color_table<std::uint8_t, 256>([](double c) noexcept { return std::round(srgb_decode(c) * 255); });
+        return table;
+    }
+
+    inline std::array<std::uint8_t, 256> const& linear8_to_srgb8_table() noexcept {
+        static const std::array<std::uint8_t, 256> table = make_color_table<std::uint8_t, 256>([](double l) noexcept { return std::round(srgb_encode(l) * 255); });
+        return table;
+    }
+
+    inline std::array<std::uint8_t, 8192> const& linear_to_srgb8_table() noexcept {
+        static const std::array<std::uint8_t, 8192> table = make_color_table<std::uint8_t, 8192>([](double l) noexcept { return std::round(srgb_encode(l) * 255); });
+        return table;
+    }
+
+    inline std::array<std::uint16_t, 65536> const& srgb16_to_linear16_table() noexcept {
+        static const std::array<std::uint16_t, 65536> table = make_color_table<std::uint16_t, 65536>([](double c) noexcept { return std::round(srgb_decode(c) * 65535); });
+        return table;
+    }
+
+    inline std::array<std::uint16_t, 65536> const& linear16_to_srgb16_table() noexcept {
+        static const std::array<std::uint16_t, 65536> table = make_color_table<std::uint16_t, 65536>([](double l) noexcept { return std::round(srgb_encode(l) * 65535); });
+        return table;
+    }
+
+
+    //Exactly rounded c * a / max, without a division
+    template<color_component T>
+    constexpr std::uint32_t mul_div_max(std::uint32_t c, std::uint32_t a) noexcept {
+        constexpr std::uint32_t bits = sizeof(T) * 8;
+        const std::uint32_t v = c * a + (1u << (bits - 1));
+        return (v + (v >> bits)) >> bits;
+    }
+
+    //Applies the table to every color channel (but not to alpha)
+    template<std::size_t Channels, typename T, typename U, std::size_t N>
+    void apply_color_table(std::span<T const> src, std::span<U> dst, std::array<U, N> const& table) noexcept {
+        const std::size_t count = src.size() / Channels;
+        T const* s = src.data();
+        U* d = dst.data();
+        #pragma omp simd
+        for(std::size_t i = 0; i < count; ++i) {
+            for(std::size_t c = 0; c < color_channels<Channels>; ++c)
+                d[Channels * i + c] = table[s[Channels * i + c]];
+            if constexpr(has_alpha_channel<Channels>)
+                d[Channels * i + Channels - 1] = static_cast<U>(s[Channels * i + Channels - 1]);
+        }
+    }
+
+    template<std::size_t Channels, std::size_t BPC>
+    std::span<typename basic_color<Channels, BPC>::component_type> components(std::span<basic_color<Channels, BPC>> colors) noexcept {
+        using component_type = typename basic_color<Channels, BPC>::component_type;
+        static_assert(sizeof(basic_color<Channels, BPC>) == Channels * sizeof(component_type));
+        return {reinterpret_cast<component_type*>(colors.data()), colors.size() * Channels};
+    }
+}
+
+
+namespace acma {
+    template<std::size_t Channels>
+    void srgb_to_linear(std::span<std::uint8_t const> src, std::span<float> dst) noexcept {
+        std::array<float, 256> const& table = impl::srgb8_to_linear_table();
+        const std::size_t count = src.size() / Channels;
+        std::uint8_t const* s = src.data();
+        float* d = dst.data();
+        #pragma omp simd
+        for(std::size_t i = 0; i < count; ++i) {
+            for(std::size_t c = 0; c < impl::color_channels<Channels>; ++c)
+                d[Channels * i + c] = table[s[Channels * i + c]];
+            if constexpr(impl::has_alpha_channel<Channels>)
+                d[Channels * i + Channels - 1] = s[Channels * i + Channels - 1] / 255.f;
+        }
+    }
+
+    template<std::size_t Channels>
+    void linear_to_srgb(std::span<float const> src, std::span<std::uint8_t> dst) noexcept {
+        std::array<std::uint8_t, 8192> const& table = impl::linear_to_srgb8_table();
+        constexpr float table_max = static_cast<float>(8192 - 1);
+        const std::size_t count = src.size() / Channels;
+        float const* s = src.data();
+        std::uint8_t* d = dst.data();
+        #pragma omp simd
+        for(std::size_t i = 0; i < count; ++i) {
+            for(std::size_t c = 0; c < impl::color_channels<Channels>; ++c)
+                d[Channels * i + c] = table[static_cast<std::size_t>(std::clamp(s[Channels * i + c], 0.f, 1.f) * table_max + .5f)];
+            if constexpr(impl::has_alpha_channel<Channels>)
+                d[Channels * i + Channels - 1] = static_cast<std::uint8_t>(std::clamp(s[Channels * i + Channels - 1], 0.f, 1.f) * 255.f + .5f);
+        }
+    }
+
+
+    template<std::size_t Channels, impl::color_component T>
+    void srgb_to_linear(std::span<T> components) noexcept {
+        if constexpr(std::is_same_v<T, std::uint8_t>) impl::apply_color_table<Channels, T, T>(components, components, impl::srgb8_to_linear8_table());
+        else impl::apply_color_table<Channels, T, T>(components, components, impl::srgb16_to_linear16_table());
+    }
+
+    template<std::size_t Channels, impl::color_component T>
+    void linear_to_srgb(std::span<T> components) noexcept {
+        if constexpr(std::is_same_v<T, std::uint8_t>) impl::apply_color_table<Channels, T, T>(components, components, impl::linear8_to_srgb8_table());
+        else impl::apply_color_table<Channels, T, T>(components, components, impl::linear16_to_srgb16_table());
+    }
+}
+
+
+namespace acma {
+    template<std::size_t Channels, impl::color_component T> requires impl::has_alpha_channel<Channels>
+    void premultiply_alpha(std::span<T> components) noexcept {
+        const std::size_t count = components.size() / Channels;
+        T* p = components.data();
+        #pragma omp simd
+        for(std::size_t i = 0; i < count; ++i) {
+            const std::uint32_t a = p[Channels * i + Channels - 1];
+            for(std::size_t c = 0; c < Channels - 1; ++c)
+                p[Channels * i + c] = static_cast<T>(impl::mul_div_max<T>(p[Channels * i + c], a));
+        }
+    }
+
+    template<std::size_t Channels, impl::color_component T> requires impl::has_alpha_channel<Channels>
+    void unpremultiply_alpha(std::span<T> components) noexcept {
+        constexpr float max = static_cast<float>(std::numeric_limits<T>::max());
+        const std::size_t count = components.size() / Channels;
+        T* p = components.data();
+        #pragma omp simd
+        for(std::size_t i = 0; i < count; ++i) {
+            const float a = p[Channels * i + Channels - 1];
+            const float scale = a > 0 ? max / a : 0.f;
+            for(std::size_t c = 0; c < Channels - 1; ++c)
+                p[Channels * i + c] = static_cast<T>(std::min(p[Channels * i + c] * scale + .5f, max));
+        }
+    }
+
+
+    inline void widen(std::span<std::uint8_t const> src, std::span<std::uint16_t> dst) noexcept {
+        std::uint8_t const* s = src.data();
+        std::uint16_t* d = dst.data();
+        #pragma omp simd
+        for(std::size_t i = 0; i < src.size(); ++i)
+            d[i] = static_cast<std::uint16_t>(s[i] * 257u);
+    }
+
+    inline void narrow(std::span<std::uint16_t const> src, std::span<std::uint8_t> dst) noexcept {
+        std::uint16_t const* s = src.data();
+        std::uint8_t* d = dst.data();
+        #pragma omp simd
+        for(std::size_t i = 0; i < src.size(); ++i)
+            d[i] = static_cast<std::uint8_t>((s[i] * 255u + 32895u) >> 16);
+    }
+
+
+    template<std::size_t Channels, std::size_t BPC>
+    void normalize(std::span<basic_color<Channels, BPC> const> src, std::span<float> dst) noexcept {
+        constexpr float max = static_cast<float>(basic_color<Channels, BPC>::component_max);
+        float* d = dst.data();
+        #pragma omp simd
+        for(std::size_t i = 0; i < src.size(); ++i)
+            for(std::size_t c = 0; c < Channels; ++c)
+                d[Channels * i + c] = src[i][c] / max;
+    }
+}
+
+
+namespace acma {
+    template<std::size_t Channels, std::size_t BPC> requires (BPC == 8 || BPC == 16)
+    void srgb_to_linear(std::span<basic_color<Channels, BPC>> colors) noexcept {
+        srgb_to_linear<Channels>(impl::components(colors));
+    }
+
+    template<std::size_t Channels, std::size_t BPC> requires (BPC == 8 || BPC == 16)
+    void linear_to_srgb(std::span<basic_color<Channels, BPC>> colors) noexcept {
+        linear_to_srgb<Channels>(impl::components(colors));
+    }
+
+    template<std::size_t Channels, std::size_t BPC> requires ((BPC == 8 || BPC == 16) && impl::has_alpha_channel<Channels>)
+    void premultiply_alpha(std::span<basic_color<Channels, BPC>> colors) noexcept {
+        premultiply_alpha<Channels>(impl::components(colors));
+    }
+
+    template<std::size_t Channels, std::size_t BPC> requires ((BPC == 8 || BPC == 16) && impl::has_alpha_channel<Channels>)
+    void unpremultiply_alpha(std::span<basic_color<Channels, BPC>> colors) noexcept {
+        unpremultiply_alpha<Channels>(impl::components(colors));
+    }
+}
@@ -0,0 +1,151 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "sirius/arith/point.hpp"
+
+
+namespace acma {
+	//The channels of a colored edge (same values as msdfgen::EdgeColor)
+	namespace edge_color {
+	enum : std::uint8_t {
+		black   = 0,
+		red     = 1,
+		green   = 2,
+		yellow  = red | green,
+		blue    = 4,
+		magenta = red | blue,
+		cyan    = green | blue,
+		white   = red | green | blue,
+	};
+	}
+
+
+	struct glyph_edge {
+		//Only the first degree + 1 are used
+		std::array<pt2d, 4> points;
+		//1 (line), 2 (quadratic bezier) or 3 (cubic bezier)
+		std::uint8_t degree;
+		std::uint8_t color;
+	};
+
+
+	//A glyph's edges by contour, already normalized and edge-colored (e.g. converted from an msdfgen::Shape)
+	class glyph_outline {
+	public:
+		void add_contour() noexcept { contour_offsets.push_back(edges.size()); }
+		//Adds to the last contour
+		void add_edge(glyph_edge const& edge) noexcept { edges.push_back(edge); }
+		void clear() noexcept {
+			edges.clear();
+			contour_offsets.clear();
+		}
+
+	public:
+		std::size_t contour_count() const noexcept { return contour_offsets.size(); }
+		std::size_t edge_count() const noexcept { return edges.size(); }
+		std::span<glyph_edge const> contour(std::size_t i) const noexcept {
+			const std::size_t end = i + 1 < contour_offsets.size() ? contour_offsets[i + 1] : edges.size();
+			return {edges.data() + contour_offsets[i], end - contour_offsets[i]};
+		}
+
+	private:
+		std::vector<glyph_edge> edges;
+		std::vector<std::size_t> contour_offsets;
+	};
+}
+
+
+namespace acma::impl {
+	struct signed_distance {
+		double distance;
+		double dot;
+	};
+
+	//Everything about an edge that doesn't depend on the pixel, computed once per glyph
+	struct prepared_edge {
+		std::array<double, 4> x;
+		std::array<double, 4> y;
+		unsigned int degree;
+		std::uint8_t color;
+		//Index of the last point
+		unsigned int end;
+		//Unnormalized and normalized directions at both ends
+		double dir0_x, dir0_y, dir1_x, dir1_y;
+		double a_dir_x, a_dir_y, b_dir_x, b_dir_y;
+		//Normalized bisectors of the corners with the previous and next edges
+		double a_bisector_x, a_bisector_y, b_bisector_x, b_bisector_y;
+		//p1 - p0, p2 - p1 - (p1 - p0) and (p3 - p2) - (p2 - p1) - br (only what the degree uses)
+		double ab_x, ab_y, br_x, br_y, as_x, as_y;
+		//Line: 1/|ab|^2 and |ab|. Quadratic: the coefficients of the closest point's cubic that don't depend on the pixel
+		std::array<double, 3> k;
+		//Unit normal of a line
+		double normal_x, normal_y;
+		//Bounding box of the control points (which contains the edge)
+		double min_x, min_y, max_x, max_y;
+	};
+
+	//msdfgen's PerpendicularDistanceSelectorBase, for one channel of one pixel
+	struct channel_selector {
+		signed_distance min_true{-std::numeric_limits<double>::max(), 0};
+		std::int32_t near_edge = -1;
+		double near_param = 0;
+		double min_negative = -std::numeric_limits<double>::max();
+		double min_positive = std::numeric_limits<double>::max();
+	};
+
+	//msdfgen's MultiAndTrueDistanceSelector, for one pixel (the true distance is the closest of the channels')
+	using pixel_selector = std::array<channel_selector, 3>;
+	using multi_distance = std::array<double, 4>;
+}
+
+
+namespace acma {
+	//Multi-channel signed distance field of a glyph: the same as msdfgen's
+	//ShapeDistanceFinder<OverlappingContourCombiner<MultiAndTrueDistanceSelector>> for each pixel, but without testing every edge for every pixel.
+	//The pixels are split into TileLength x TileLength tiles, and each tile only tests the edges that can affect it: an edge is skipped if even
+	//the closest point of its control points' bounding box (and of the rays its corners extend pseudo-distances along) is farther from the tile
+	//than some other edge of the same channel is at worst. The edges kept for a tile are then evaluated a whole tile row at a time.
+	//Without Cull, every tile tests every edge (to check the culling against).
+	//Holds its scratch memory, so reuse one per thread
+	template<std::size_t Length, std::size_t TileLength = 4, bool Cull = true>
+	class glyph_distance_field {
+		static_assert(Length % TileLength == 0);
+
+	public:
+		constexpr static std::size_t channels = 4;
+		constexpr static std::size_t size = Length * Length * channels;
+
+	public:
+		//Writes the red, green, blue and true signed distances of each pixel (rows top to bottom, matching msdfgen with inverseYAxis),
+		//where pixel (x, y) is at ((x + .5, y + .5) / scale) + translate in outline coordinates
+		void evaluate(glyph_outline const& outline, double scale, pt2d translate, std::span<float, size> distances) noexcept;
+
+	private:
+		void prepare(glyph_outline const& outline) noexcept;
+		void select_edges(double min_x, double min_y, double max_x, double max_y) noexcept;
+		void evaluate_row(std::size_t first_x, std::size_t y, double scale, pt2d translate, std::span<float, size> distances) noexcept;
+
+	private:
+		std::vector<impl::prepared_edge> edges;
+		//Edge indices by contour, in the order msdfgen visits them (the last edge first)
+		std::vector<std::uint32_t> contour_edges;
+		std::vector<std::size_t> contour_offsets;
+		std::vector<int> windings;
+		//The distance of each of contour_edges from the current tile's center
+		std::vector<double> center_distances;
+		//The contour_edges kept for the current tile, with their offsets
+		std::vector<std::uint32_t> tile_edges;
+		std::vector<std::size_t> tile_offsets;
+		//A selector and its distance per contour per pixel of the tile row
+		std::vector<impl::pixel_selector> selectors;
+		std::vector<impl::multi_distance> contour_distances;
+	};
+}
+
+
+#include "sirius/graphics/core/glyph_distance_field.inl"
@@ -0,0 +1,645 @@
+#pragma once
+#include "sirius/graphics/core/glyph_distance_field.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+
+//Ported from msdfgen (the edge distances, the selectors and the overlapping contour combiner), so the results stay within its tolerance
+namespace acma::impl {
+	struct vec {
+		double x, y;
+	};
+
+	constexpr double dot  (vec a, vec b) noexcept { return a.x * b.x + a.y * b.y; }
+	constexpr double cross(vec a, vec b) noexcept { return a.x * b.y - a.y * b.x; }
+	constexpr double non_zero_sign(double n) noexcept { return n > 0 ? 1. : -1.; }
+	inline double length(vec v) noexcept { return std::sqrt(dot(v, v)); }
+	inline vec normalize(vec v, bool allow_zero = false) noexcept {
+		const double len = length(v);
+		if(len == 0) return {0, allow_zero ? 0. : 1.};
+		return {v.x / len, v.y / len};
+	}
+
+	constexpr bool operator<(signed_distance a, signed_distance b) noexcept {
+		return std::fabs(a.distance) < std::fabs(b.distance) || (std::fabs(a.distance) == std::fabs(b.distance) && a.dot < b.dot);
+	}
+
+	constexpr double median(double a, double b, double c) noexcept {
+		return std::max(std::min(a, b), std::min(std::max(a, b), c));
+	}
+	constexpr double resolve(multi_distance const& d) noexcept { return median(d[0], d[1], d[2]); }
+}
+
+namespace acma::impl {
+	inline int solve_quadratic(double x[2], double a, double b, double c) noexcept {
+		if(a == 0 || std::fabs(b) > 1e12 * std::fabs(a)) {
+			if(b == 0) return c == 0 ? -1 : 0;
+			x[0] = -c / b;
+			return 1;
+		}
+		double dscr = b * b - 4 * a * c;
+		if(dscr > 0) {
+			dscr = std::sqrt(dscr);
+			x[0] = (-b + dscr) / (2 * a);
+			x[1] = (-b - dscr) / (2 * a);
+			return 2;
+		}
+		if(dscr == 0) {
+			x[0] = -b / (2 * a);
+			return 1;
+		}
+		return 0;
+	}
+
+	inline int solve_cubic_normed(double x[3], double a, double b, double c) noexcept {
+		const double a2 = a * a;
+		double q = 1 / 9. * (a2 - 3 * b);
+		const double r = 1 / 54. * (a * (2 * a2 - 9 * b) + 27 * c);
+		const double r2 = r * r;
+		const double q3 = q * q * q;
+		a *= 1 / 3.;
+		if(r2 < q3) {
+			const double t = std::acos(std::clamp(r / std::sqrt(q3), -1., 1.));
+			q = -2 * std::sqrt(q);
+			x[0] = q * std::cos(1 / 3. * t) - a;
+			x[1] = q * std::cos(1 / 3. * (t + 2 * std::numbers::pi)) - a;
+			x[2] = q * std::cos(1 / 3. * (t - 2 * std::numbers::pi)) - a;
+			return 3;
+		}
+		const double u = (r < 0 ? 1 : -1) * std::pow(std::fabs(r) + std::sqrt(r2 - q3), 1 / 3.);
+		const double v = u == 0 ? 0 : q / u;
+		x[0] = (u + v) - a;
+		if(u == v || std::fabs(u - v) < 1e-12 * std::fabs(u + v)) {
+			x[1] = -.5 * (u + v) - a;
+			return 2;
+		}
+		return 1;
+	}
+
+	inline int solve_cubic(double x[3], double a, double b, double c, double d) noexcept {
+		if(a != 0) {
+			const double bn = b / a;
+			if(std::fabs(bn) < 1e6) return solve_cubic_normed(x, bn, c / a, d / a);
+		}
+		return solve_quadratic(x, b, c, d);
+	}
+}
+
+
+namespace acma::impl {
+	inline vec edge_point(glyph_edge const& e, double t) noexcept {
+		auto mix = [t](vec a, vec b) noexcept { return vec{a.x + t * (b.x - a.x), a.y + t * (b.y - a.y)}; };
+		const vec p0{e.points[0].x(), e.points[0].y()}, p1{e.points[1].x(), e.points[1].y()};
+		const vec p2{e.points[2].x(), e.points[2].y()}, p3{e.points[3].x(), e.points[3].y()};
+		switch(e.degree) {
+		case 1: return mix(p0, p1);
+		case 2: return mix(mix(p0, p1), mix(p1, p2));
+		default: {
+			const vec p12 = mix(p1, p2);
+			return mix(mix(mix(p0, p1), p12), mix(p12, mix(p2, p3)));
+		}
+		}
+	}
+
+	//msdfgen's Contour::winding
+	inline int winding(std::span<glyph_edge const> contour) noexcept {
+		auto shoelace = [](vec a, vec b) noexcept { return (b.x - a.x) * (a.y + b.y); };
+		double total = 0;
+		switch(contour.size()) {
+		case 0: return 0;
+		case 1: {
+			const vec a = edge_point(contour[0], 0), b = edge_point(contour[0], 1 / 3.), c = edge_point(contour[0], 2 / 3.);
+			total = shoelace(a, b) + shoelace(b, c) + shoelace(c, a);
+			break;
+		}
+		case 2: {
+			const vec a = edge_point(contour[0], 0), b = edge_point(contour[0], .5), c = edge_point(contour[1], 0), d = edge_point(contour[1], .5);
+			total = shoelace(a, b) + shoelace(b, c) + shoelace(c, d) + shoelace(d, a);
+			break;
+		}
+		default: {
+			vec prev = edge_point(contour.back(), 0);
+			for(glyph_edge const& e : contour) {
+				const vec cur = edge_point(e, 0);
+				total += shoelace(prev, cur);
+				prev = cur;
+			}
+		}
+		}
+		return (0 < total) - (total < 0);
+	}
+
+	inline prepared_edge prepare_edge(glyph_edge const& e) noexcept {
+		prepared_edge ret{};
+		ret.degree = e.degree;
+		ret.color = e.color;
+		ret.end = e.degree;
+		ret.min_x = ret.min_y = std::numeric_limits<double>::max();
+		ret.max_x = ret.max_y = -std::numeric_limits<double>::max();
+		for(unsigned int i = 0; i <= ret.end; ++i) {
+			ret.x[i] = e.points[i].x();
+			ret.y[i] = e.points[i].y();
+			ret.min_x = std::min(ret.min_x, ret.x[i]);
+			ret.min_y = std::min(ret.min_y, ret.y[i]);
+			ret.max_x = std::max(ret.max_x, ret.x[i]);
+			ret.max_y = std::max(ret.max_y, ret.y[i]);
+		}
+
+		auto diff = [&](unsigned int to, unsigned int from) noexcept { return vec{ret.x[to] - ret.x[from], ret.y[to] - ret.y[from]}; };
+		auto zero = [](vec v) noexcept { return v.x == 0 && v.y == 0; };
+		//msdfgen's EdgeSegment::direction(0) and direction(1), falling back to farther points for degenerate ends
+		vec dir0 = diff(1, 0), dir1 = diff(ret.end, ret.end - 1);
+		if(ret.degree >= 2 && zero(dir0)) dir0 = diff(2, 0);
+		if(ret.degree == 3 && zero(dir0)) dir0 = diff(3, 0);
+		if(ret.degree >= 2 && zero(dir1)) dir1 = diff(ret.end, ret.end - 2);
+		if(ret.degree == 3 && zero(dir1)) dir1 = diff(3, 0);
+		const vec a_dir = normalize(dir0, true), b_dir = normalize(dir1, true);
+		ret.dir0_x = dir0.x; ret.dir0_y = dir0.y;
+		ret.dir1_x = dir1.x; ret.dir1_y = dir1.y;
+		ret.a_dir_x = a_dir.x; ret.a_dir_y = a_dir.y;
+		ret.b_dir_x = b_dir.x; ret.b_dir_y = b_dir.y;
+
+		const vec ab = diff(1, 0);
+		ret.ab_x = ab.x; ret.ab_y = ab.y;
+		switch(ret.degree) {
+		case 1: {
+			const double len = length(ab);
+			//A zero-length line is just its point: t stays 0 (rather than NaN) and line_distance measures from the point
+			if(len == 0) {
+				ret.k = {0, 0, 0};
+				ret.normal_x = ret.normal_y = 0;
+				break;
+			}
+			ret.k = {1 / dot(ab, ab), len, 0};
+			ret.normal_x = ab.y / len;
+			ret.normal_y = -ab.x / len;
+			break;
+		}
+		case 2: {
+			const vec br{ret.x[2] - ret.x[1] - ab.x, ret.y[2] - ret.y[1] - ab.y};
+			ret.br_x = br.x; ret.br_y = br.y;
+			ret.k = {dot(br, br), 3 * dot(ab, br), 2 * dot(ab, ab)};
+			break;
+		}
+		default: {
+			const vec br{ret.x[2] - ret.x[1] - ab.x, ret.y[2] - ret.y[1] - ab.y};
+			ret.br_x = br.x; ret.br_y = br.y;
+			ret.as_x = (ret.x[3] - ret.x[2]) - (ret.x[2] - ret.x[1]) - br.x;
+			ret.as_y = (ret.y[3] - ret.y[2]) - (ret.y[2] - ret.y[1]) - br.y;
+		}
+		}
+		return ret;
+	}
+
+	//Appends the contour's edges, along with the bisectors of the corners between them
+	inline void prepare_contour(std::span<glyph_edge const> contour, std::vector<prepared_edge>& edges) noexcept {
+		const std::size_t first = edges.size();
+		const std::size_t count = contour.size();
+		for(glyph_edge const& e : contour) edges.push_back(prepare_edge(e));
+
+		for(std::size_t i = 0; i < count; ++i) {
+			prepared_edge& e = edges[first + i];
+			prepared_edge const& prev = edges[first + (i + count - 1) % count];
+			prepared_edge const& next = edges[first + (i + 1) % count];
+			const vec a_bisector = normalize({prev.b_dir_x + e.a_dir_x, prev.b_dir_y + e.a_dir_y}, true);
+			const vec b_bisector = normalize({e.b_dir_x + next.a_dir_x, e.b_dir_y + next.a_dir_y}, true);
+			e.a_bisector_x = a_bisector.x; e.a_bisector_y = a_bisector.y;
+			e.b_bisector_x = b_bisector.x; e.b_bisector_y = b_bisector.y;
+		}
+	}
+}
+
+
+namespace acma::impl {
+	inline signed_distance quadratic_distance(prepared_edge const& e, double ox, double oy, double& param) noexcept {
+		const vec qa{e.x[0] - ox, e.y[0] - oy}, ab{e.ab_x, e.ab_y}, br{e.br_x, e.br_y};
+		double t[3];
+		const int solutions = solve_cubic(t, e.k[0], e.k[1], e.k[2] + dot(qa, br), dot(qa, ab));
+
+		vec ep_dir{e.dir0_x, e.dir0_y};
+		double min_distance = non_zero_sign(cross(ep_dir, qa)) * length(qa);
+		param = -dot(qa, ep_dir) / dot(ep_dir, ep_dir);
+		{
+			ep_dir = {e.dir1_x, e.dir1_y};
+			const vec bq{e.x[2] - ox, e.y[2] - oy};
+			const double distance = length(bq);
+			if(distance < std::fabs(min_distance)) {
+				min_distance = non_zero_sign(cross(ep_dir, bq)) * distance;
+				param = dot(vec{ox - e.x[1], oy - e.y[1]}, ep_dir) / dot(ep_dir, ep_dir);
+			}
+		}
+		for(int i = 0; i < solutions; ++i) {
+			if(t[i] <= 0 || t[i] >= 1) continue;
+			const vec qe{qa.x + 2 * t[i] * ab.x + t[i] * t[i] * br.x, qa.y + 2 * t[i] * ab.y + t[i] * t[i] * br.y};
+			const double distance = length(qe);
+			if(distance <= std::fabs(min_distance)) {
+				min_distance = non_zero_sign(cross(vec{ab.x + t[i] * br.x, ab.y + t[i] * br.y}, qe)) * distance;
+				param = t[i];
+			}
+		}
+
+		if(param >= 0 && param <= 1) return {min_distance, 0};
+		if(param < .5) return {min_distance, std::fabs(dot(normalize({e.dir0_x, e.dir0_y}), normalize(qa)))};
+		return {min_distance, std::fabs(dot(normalize({e.dir1_x, e.dir1_y}), normalize({e.x[2] - ox, e.y[2] - oy})))};
+	}
+
+	inline signed_distance cubic_distance(prepared_edge const& e, double ox, double oy, double& param) noexcept {
+		constexpr int search_starts = 4;
+		constexpr int search_steps = 4;
+		const vec qa{e.x[0] - ox, e.y[0] - oy}, ab{e.ab_x, e.ab_y}, br{e.br_x, e.br_y}, as{e.as_x, e.as_y};
+		auto at = [&](vec v0, double c0, vec v1, double c1, vec v2, double c2, vec v3, double c3) noexcept {
+			return vec{c0 * v0.x + c1 * v1.x + c2 * v2.x + c3 * v3.x, c0 * v0.y + c1 * v1.y + c2 * v2.y + c3 * v3.y};
+		};
+
+		vec ep_dir{e.dir0_x, e.dir0_y};
+		double min_distance = non_zero_sign(cross(ep_dir, qa)) * length(qa);
+		param = -dot(qa, ep_dir) / dot(ep_dir, ep_dir);
+		{
+			ep_dir = {e.dir1_x, e.dir1_y};
+			const vec dq{e.x[3] - ox, e.y[3] - oy};
+			const double distance = length(dq);
+			if(distance < std::fabs(min_distance)) {
+				min_distance = non_zero_sign(cross(ep_dir, dq)) * distance;
+				param = dot(vec{ep_dir.x - dq.x, ep_dir.y - dq.y}, ep_dir) / dot(ep_dir, ep_dir);
+			}
+		}
+		for(int i = 0; i <= search_starts; ++i) {
+			double t = static_cast<double>(i) / search_starts;
+			vec qe = at(qa, 1, ab, 3 * t, br, 3 * t * t, as, t * t * t);
+			vec d1 = at(ab, 3, br, 6 * t, as, 3 * t * t, {}, 0);
+			vec d2 = at(br, 6, as, 6 * t, {}, 0, {}, 0);
+			double improved_t = t - dot(qe, d1) / (dot(d1, d1) + dot(qe, d2));
+			if(improved_t <= 0 || improved_t >= 1) continue;
+			int remaining_steps = search_steps;
+			do {
+				t = improved_t;
+				qe = at(qa, 1, ab, 3 * t, br, 3 * t * t, as, t * t * t);
+				d1 = at(ab, 3, br, 6 * t, as, 3 * t * t, {}, 0);
+				if(!--remaining_steps) break;
+				d2 = at(br, 6, as, 6 * t, {}, 0, {}, 0);
+				improved_t = t - dot(qe, d1) / (dot(d1, d1) + dot(qe, d2));
+			} while(improved_t > 0 && improved_t < 1);
+			const double distance = length(qe);
+			if(distance < std::fabs(min_distance)) {
+				min_distance = non_zero_sign(cross(d1, qe)) * distance;
+				param = t;
+			}
+		}
+
+		if(param >= 0 && param <= 1) return {min_distance, 0};
+		if(param < .5) return {min_distance, std::fabs(dot(normalize({e.dir0_x, e.dir0_y}), normalize(qa)))};
+		return {min_distance, std::fabs(dot(normalize({e.dir1_x, e.dir1_y}), normalize({e.x[3] - ox, e.y[3] - oy})))};
+	}
+
+	//Branchless, so that line_distances vectorizes
+	inline signed_distance line_distance(prepared_edge const& e, double ox, double oy, double& param) noexcept {
+		const double aq_x = ox - e.x[0], aq_y = oy - e.y[0];
+		const double t = (aq_x * e.ab_x + aq_y * e.ab_y) * e.k[0];
+		const double eq_x = (t > .5 ? e.x[1] : e.x[0]) - ox, eq_y = (t > .5 ? e.y[1] : e.y[0]) - oy;
+		const double endpoint_distance = std::sqrt(eq_x * eq_x + eq_y * eq_y);
+		const double ortho_distance = e.normal_x * aq_x + e.normal_y * aq_y;
+		const bool orthogonal = t > 0 && t < 1 && std::fabs(ortho_distance) < endpoint_distance;
+		const double side = (aq_x * e.ab_y - aq_y * e.ab_x) > 0 ? 1. : -1.;
+		//Like msdfgen, a zero-length direction (of the line or towards the endpoint) counts as (0, 1)
+		const double dir_x = e.k[1] > 0 ? e.ab_x / e.k[1] : 0, dir_y = e.k[1] > 0 ? e.ab_y / e.k[1] : 1;
+		const double endpoint_dot = endpoint_distance > 0 ?
+			std::fabs(dir_x * eq_x + dir_y * eq_y) / endpoint_distance :
+			std::fabs(dir_y);
+		param = t;
+		return {orthogonal ? ortho_distance : side * endpoint_distance, orthogonal ? 0 : endpoint_dot};
+	}
+
+	//A whole tile row against one line
+	template<std::size_t N>
+	void line_distances(prepared_edge const& e, std::array<double, N> const& px, double py, std::array<signed_distance, N>& out, std::array<double, N>& params) noexcept {
+		std::array<double, N> distances, dots;
+		#pragma omp simd
+		for(std::size_t i = 0; i < N; ++i) {
+			const signed_distance d = line_distance(e, px[i], py, params[i]);
+			distances[i] = d.distance;
+			dots[i] = d.dot;
+		}
+		for(std::size_t i = 0; i < N; ++i) out[i] = {distances[i], dots[i]};
+	}
+
+	inline double edge_distance(prepared_edge const& e, double ox, double oy) noexcept {
+		double param;
+		switch(e.degree) {
+		case 1:  return std::fabs(line_distance(e, ox, oy, param).distance);
+		case 2:  return std::fabs(quadratic_distance(e, ox, oy, param).distance);
+		default: return std::fabs(cubic_distance(e, ox, oy, param).distance);
+		}
+	}
+}
+
+
+namespace acma::impl {
+	inline bool perpendicular_distance(double& distance, vec ep, vec edge_dir) noexcept {
+		if(dot(ep, edge_dir) <= 0) return false;
+		const double perpendicular = cross(ep, edge_dir);
+		if(std::fabs(perpendicular) >= std::fabs(distance)) return false;
+		distance = perpendicular;
+		return true;
+	}
+
+	inline void add_perpendicular_distance(channel_selector& c, double distance) noexcept {
+		if(distance <= 0 && distance > c.min_negative) c.min_negative = distance;
+		if(distance >= 0 && distance < c.min_positive) c.min_positive = distance;
+	}
+
+	//msdfgen's MultiDistanceSelector::addEdge
+	inline void add_edge(pixel_selector& s, prepared_edge const& e, std::uint32_t edge_idx, double px, double py, signed_distance distance, double param) noexcept {
+		for(std::size_t ch = 0; ch < 3; ++ch) {
+			if(!(e.color & (1 << ch)) || !(distance < s[ch].min_true)) continue;
+			s[ch].min_true = distance;
+			s[ch].near_edge = static_cast<std::int32_t>(edge_idx);
+			s[ch].near_param = param;
+		}
+
+		const vec ap{px - e.x[0], py - e.y[0]}, bp{px - e.x[e.end], py - e.y[e.end]};
+		if(dot(ap, {e.a_bisector_x, e.a_bisector_y}) > 0) {
+			double pd = distance.distance;
+			if(perpendicular_distance(pd, ap, {-e.a_dir_x, -e.a_dir_y})) pd = -pd;
+			for(std::size_t ch = 0; ch < 3; ++ch) if(e.color & (1 << ch)) add_perpendicular_distance(s[ch], pd);
+		}
+		if(-dot(bp, {e.b_bisector_x, e.b_bisector_y}) > 0) {
+			double pd = distance.distance;
+			perpendicular_distance(pd, bp, {e.b_dir_x, e.b_dir_y});
+			for(std::size_t ch = 0; ch < 3; ++ch) if(e.color & (1 << ch)) add_perpendicular_distance(s[ch], pd);
+		}
+	}
+
+	inline void merge(pixel_selector& s, pixel_selector const& other) noexcept {
+		for(std::size_t ch = 0; ch < 3; ++ch) {
+			if(other[ch].min_true < s[ch].min_true) {
+				s[ch].min_true = other[ch].min_true;
+				s[ch].near_edge = other[ch].near_edge;
+				s[ch].near_param = other[ch].near_param;
+			}
+			s[ch].min_negative = std::max(s[ch].min_negative, other[ch].min_negative);
+			s[ch].min_positive = std::min(s[ch].min_positive, other[ch].min_positive);
+		}
+	}
+
+	//msdfgen's EdgeSegment::distanceToPerpendicularDistance
+	inline void distance_to_perpendicular_distance(signed_distance& distance, prepared_edge const& e, double px, double py, double param) noexcept {
+		if(param < 0) {
+			const vec dir = normalize({e.dir0_x, e.dir0_y});
+			const vec aq{px - e.x[0], py - e.y[0]};
+			if(dot(aq, dir) >= 0) return;
+			const double perpendicular = cross(aq, dir);
+			if(std::fabs(perpendicular) <= std::fabs(distance.distance)) distance = {perpendicular, 0};
+		}
+		else if(param > 1) {
+			const vec dir = normalize({e.dir1_x, e.dir1_y});
+			const vec bq{px - e.x[e.end], py - e.y[e.end]};
+			if(dot(bq, dir) <= 0) return;
+			const double perpendicular = cross(bq, dir);
+			if(std::fabs(perpendicular) <= std::fabs(distance.distance)) distance = {perpendicular, 0};
+		}
+	}
+
+	inline multi_distance selector_distance(pixel_selector const& s, std::span<prepared_edge const> edges, double px, double py) noexcept {
+		multi_distance ret;
+		signed_distance true_distance = s[0].min_true;
+		for(std::size_t ch = 0; ch < 3; ++ch) {
+			channel_selector const& c = s[ch];
+			double min_distance = c.min_true.distance < 0 ? c.min_negative : c.min_positive;
+			if(c.near_edge >= 0) {
+				signed_distance distance = c.min_true;
+				distance_to_perpendicular_distance(distance, edges[c.near_edge], px, py, c.near_param);
+				if(std::fabs(distance.distance) < std::fabs(min_distance)) min_distance = distance.distance;
+			}
+			ret[ch] = min_distance;
+			if(ch && c.min_true < true_distance) true_distance = c.min_true;
+		}
+		ret[3] = true_distance.distance;
+		return ret;
+	}
+}
+
+
+namespace acma::impl {
+	inline double box_distance(double min_x, double min_y, double max_x, double max_y, double x0, double y0, double x1, double y1) noexcept {
+		const double dx = std::max({0., x0 - max_x, min_x - x1});
+		const double dy = std::max({0., y0 - max_y, min_y - y1});
+		return std::sqrt(dx * dx + dy * dy);
+	}
+
+	//Distance between the box and the ray from o along the unit vector u
+	inline double ray_distance(double min_x, double min_y, double max_x, double max_y, vec o, vec u) noexcept {
+		if(u.x == 0 && u.y == 0) return std::numeric_limits<double>::infinity();
+		double t_min = 0, t_max = std::numeric_limits<double>::infinity();
+		bool hits = true;
+		auto clip = [&](double origin, double dir, double lo, double hi) noexcept {
+			if(dir == 0) {
+				hits &= origin >= lo && origin <= hi;
+				return;
+			}
+			double t0 = (lo - origin) / dir, t1 = (hi - origin) / dir;
+			if(t0 > t1) std::swap(t0, t1);
+			t_min = std::max(t_min, t0);
+			t_max = std::min(t_max, t1);
+		};
+		clip(o.x, u.x, min_x, max_x);
+		clip(o.y, u.y, min_y, max_y);
+		if(hits && t_min <= t_max) return 0;
+
+		//Otherwise the closest points are the ray's origin or one of the corners
+		double ret = box_distance(min_x, min_y, max_x, max_y, o.x, o.y, o.x, o.y);
+		for(vec c : {vec{min_x, min_y}, vec{max_x, min_y}, vec{min_x, max_y}, vec{max_x, max_y}}) {
+			const vec oc{c.x - o.x, c.y - o.y};
+			ret = std::min(ret, dot(oc, u) > 0 ? std::fabs(cross(oc, u)) : length(oc));
+		}
+		return ret;
+	}
+}
+
+
+
+namespace acma {
+	template<std::size_t Length, std::size_t TileLength, bool Cull>
+	void glyph_distance_field<Length, TileLength, Cull>::evaluate(glyph_outline const& outline, double scale, pt2d translate, std::span<float, size> distances) noexcept {
+		prepare(outline);
+		selectors.resize(contour_offsets.size() * TileLength);
+		contour_distances.resize(contour_offsets.size());
+
+		for(std::size_t tile_y = 0; tile_y < Length; tile_y += TileLength) {
+			for(std::size_t tile_x = 0; tile_x < Length; tile_x += TileLength) {
+				//The tile's pixel centers
+				select_edges(
+					(tile_x + .5) / scale + translate.x(), (tile_y + .5) / scale + translate.y(),
+					(tile_x + TileLength - .5) / scale + translate.x(), (tile_y + TileLength - .5) / scale + translate.y()
+				);
+				for(std::size_t y = tile_y; y < tile_y + TileLength; ++y)
+					evaluate_row(tile_x, y, scale, translate, distances);
+			}
+		}
+	}
+
+
+	template<std::size_t Length, std::size_t TileLength, bool Cull>
+	void glyph_distance_field<Length, TileLength, Cull>::prepare(glyph_outline const& outline) noexcept {
+		edges.clear();
+		contour_edges.clear();
+		contour_offsets.clear();
+		windings.clear();
+
+		for(std::size_t c = 0; c < outline.contour_count(); ++c) {
+			std::span<glyph_edge const> contour = outline.contour(c);
+			const std::uint32_t first = static_cast<std::uint32_t>(edges.size());
+			const std::uint32_t count = static_cast<std::uint32_t>(contour.size());
+			contour_offsets.push_back(contour_edges.size());
+			windings.push_back(impl::winding(contour));
+			impl::prepare_contour(contour, edges);
+
+			if(count == 0) continue;
+			contour_edges.push_back(first + count - 1);
+			for(std::uint32_t i = 0; i + 1 < count; ++i) contour_edges.push_back(first + i);
+		}
+	}
+
+
+	template<std::size_t Length, std::size_t TileLength, bool Cull>
+	void glyph_distance_field<Length, TileLength, Cull>::select_edges(double min_x, double min_y, double max_x, double max_y) noexcept {
+		if constexpr(!Cull) {
+			tile_edges.assign(contour_edges.begin(), contour_edges.end());
+			tile_offsets.assign(contour_offsets.begin(), contour_offsets.end());
+			tile_offsets.push_back(contour_edges.size());
+			return;
+		}
+
+		const double center_x = (min_x + max_x) / 2, center_y = (min_y + max_y) / 2;
+		const double half_diagonal = impl::length({max_x - center_x, max_y - center_y});
+		center_distances.resize(contour_edges.size());
+		tile_edges.clear();
+		tile_offsets.clear();
+		for(std::size_t c = 0; c < contour_offsets.size(); ++c) {
+			tile_offsets.push_back(tile_edges.size());
+			const std::size_t begin = contour_offsets[c];
+			const std::size_t end = c + 1 < contour_offsets.size() ? contour_offsets[c + 1] : contour_edges.size();
+
+			//Every pixel of the tile is within half_diagonal of its center, so an edge's distance from any of them is within half_diagonal of its
+			//distance from the center. That gives the farthest any pixel can be from the contour's closest edge of each channel (and of any channel).
+			//Per contour, since the overlapping contour combiner may pick a contour that's farther away than the closest edge of the glyph
+			std::array<double, 4> bounds;
+			bounds.fill(std::numeric_limits<double>::infinity());
+			for(std::size_t i = begin; i < end; ++i) {
+				impl::prepared_edge const& e = edges[contour_edges[i]];
+				center_distances[i] = impl::edge_distance(e, center_x, center_y);
+				const double bound = center_distances[i] + half_diagonal;
+				for(std::size_t ch = 0; ch < 3; ++ch) if(e.color & (1 << ch)) bounds[ch] = std::min(bounds[ch], bound);
+				bounds[3] = std::min(bounds[3], bound);
+			}
+			//Leeway for rounding, since culling an edge that ties would still change which one is picked
+			for(double& b : bounds) b = b * (1 + 1e-9) + 1e-12;
+
+			for(std::size_t i = begin; i < end; ++i) {
+				impl::prepared_edge const& e = edges[contour_edges[i]];
+				const double edge_distance = std::max(
+					center_distances[i] - half_diagonal,
+					impl::box_distance(min_x, min_y, max_x, max_y, e.min_x, e.min_y, e.max_x, e.max_y)
+				);
+				bool relevant = edge_distance <= bounds[3];
+				//Pseudo-distances extend past the edge's ends, along rays that may come much closer than the edge itself.
+				//They're only used on the far side of the corner's bisector though, where they're at least the distance to the corner
+				//times the cosine between the edge and the bisector (so never at smooth joints)
+				const double start_distance = impl::box_distance(min_x, min_y, max_x, max_y, e.x[0], e.y[0], e.x[0], e.y[0]);
+				const double end_distance = impl::box_distance(min_x, min_y, max_x, max_y, e.x[e.end], e.y[e.end], e.x[e.end], e.y[e.end]);
+				const double ray_distance = std::min(
+					std::max(
+						impl::ray_distance(min_x, min_y, max_x, max_y, {e.x[0], e.y[0]}, {-e.a_dir_x, -e.a_dir_y}),
+						start_distance * impl::dot({e.a_dir_x, e.a_dir_y}, {e.a_bisector_x, e.a_bisector_y})
+					),
+					std::max(
+						impl::ray_distance(min_x, min_y, max_x, max_y, {e.x[e.end], e.y[e.end]}, {e.b_dir_x, e.b_dir_y}),
+						end_distance * impl::dot({e.b_dir_x, e.b_dir_y}, {e.b_bisector_x, e.b_bisector_y})
+					)
+				);
+				for(std::size_t ch = 0; ch < 3; ++ch)
+					relevant |= (e.color & (1 << ch)) && (edge_distance <= bounds[ch] || ray_distance <= bounds[ch]);
+				if(relevant) tile_edges.push_back(contour_edges[i]);
+			}
+		}
+		tile_offsets.push_back(tile_edges.size());
+	}
+
+
+	template<std::size_t Length, std::size_t TileLength, bool Cull>
+	void glyph_distance_field<Length, TileLength, Cull>::evaluate_row(std::size_t first_x, std::size_t y, double scale, pt2d translate, std::span<float, size> distances) noexcept {
+		const double py = (y + .5) / scale + translate.y();
+		std::array<double, TileLength> px;
+		for(std::size_t i = 0; i < TileLength; ++i) px[i] = (first_x + i + .5) / scale + translate.x();
+
+		std::array<impl::signed_distance, TileLength> edge_distances;
+		std::array<double, TileLength> params;
+		for(std::size_t c = 0; c < contour_offsets.size(); ++c) {
+			impl::pixel_selector* const s = &selectors[c * TileLength];
+			std::fill_n(s, TileLength, impl::pixel_selector{});
+			for(std::size_t k = tile_offsets[c]; k < tile_offsets[c + 1]; ++k) {
+				const std::uint32_t edge_idx = tile_edges[k];
+				impl::prepared_edge const& e = edges[edge_idx];
+				switch(e.degree) {
+				case 1:
+					impl::line_distances(e, px, py, edge_distances, params);
+					break;
+				case 2:
+					for(std::size_t i = 0; i < TileLength; ++i) edge_distances[i] = impl::quadratic_distance(e, px[i], py, params[i]);
+					break;
+				default:
+					for(std::size_t i = 0; i < TileLength; ++i) edge_distances[i] = impl::cubic_distance(e, px[i], py, params[i]);
+				}
+				for(std::size_t i = 0; i < TileLength; ++i) impl::add_edge(s[i], e, edge_idx, px[i], py, edge_distances[i], params[i]);
+			}
+		}
+
+		//msdfgen's OverlappingContourCombiner
+		for(std::size_t i = 0; i < TileLength; ++i) {
+			impl::pixel_selector shape{}, inner{}, outer{};
+			for(std::size_t c = 0; c < contour_offsets.size(); ++c) {
+				impl::pixel_selector const& s = selectors[c * TileLength + i];
+				contour_distances[c] = impl::selector_distance(s, edges, px[i], py);
+				const double d = impl::resolve(contour_distances[c]);
+				impl::merge(shape, s);
+				if(windings[c] > 0 && d >= 0) impl::merge(inner, s);
+				if(windings[c] < 0 && d <= 0) impl::merge(outer, s);
+			}
+			const impl::multi_distance shape_distance = impl::selector_distance(shape, edges, px[i], py);
+			const impl::multi_distance inner_distance = impl::selector_distance(inner, edges, px[i], py);
+			const impl::multi_distance outer_distance = impl::selector_distance(outer, edges, px[i], py);
+			const double inner_scalar = impl::resolve(inner_distance);
+			const double outer_scalar = impl::resolve(outer_distance);
+
+			impl::multi_distance distance = shape_distance;
+			int winding = 0;
+			if(inner_scalar >= 0 && std::fabs(inner_scalar) <= std::fabs(outer_scalar)) {
+				distance = inner_distance;
+				winding = 1;
+				for(std::size_t c = 0; c < contour_offsets.size(); ++c) {
+					const double d = impl::resolve(contour_distances[c]);
+					if(windings[c] > 0 && std::fabs(d) < std::fabs(outer_scalar) && d > impl::resolve(distance)) distance = contour_distances[c];
+				}
+			}
+			else if(outer_scalar <= 0 && std::fabs(outer_scalar) < std::fabs(inner_scalar)) {
+				distance = outer_distance;
+				winding = -1;
+				for(std::size_t c = 0; c < contour_offsets.size(); ++c) {
+					const double d = impl::resolve(contour_distances[c]);
+					if(windings[c] < 0 && std::fabs(d) < std::fabs(inner_scalar) && d < impl::resolve(distance)) distance = contour_distances[c];
+				}
+			}
+			if(winding != 0) {
+				for(std::size_t c = 0; c < contour_offsets.size(); ++c) {
+					const double d = impl::resolve(contour_distances[c]);
+					if(windings[c] != winding && d * impl::resolve(distance) >= 0 && std::fabs(d) < std::fabs(impl::resolve(distance))) distance = contour_distances[c];
+				}
+				if(impl::resolve(distance) == impl::resolve(shape_distance)) distance = shape_distance;
+			}
+
+			float* const out = &distances[channels * (Length * (Length - y - 1) + first_x + i)];
+			for(std::size_t ch = 0; ch < channels; ++ch) out[ch] = static_cast<float>(distance[ch]);
+		}
+	}
+}
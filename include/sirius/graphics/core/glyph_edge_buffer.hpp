@@ -0,0 +1,112 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "sirius/arith/point.hpp"
+#include "sirius/arith/size.hpp"
+#include "sirius/core/buffer_config.hpp"
+#include "sirius/graphics/core/glyph_distance_field.hpp"
+
+
+namespace acma {
+	//The std430 layouts of shaders/generate_glyphs.comp's buffers
+	struct gpu_glyph {
+		std::uint32_t first_contour;
+		std::uint32_t contour_count;
+		//In the storage image array the shader writes to
+		std::uint32_t image_index;
+		std::uint32_t _padding;
+		//Where the top-left texel of the glyph's extent goes in its image, and the extent's size
+		std::array<std::uint32_t, 2> offset;
+		std::array<std::uint32_t, 2> size;
+		//Texel (x, y), counted from the bottom-left corner of the font_texture, is at ((x + .5, y + .5) / scale) + translate in outline coordinates
+		std::array<float, 2> translate;
+		float scale;
+		float distance_range;
+	};
+	static_assert(sizeof(gpu_glyph) == 48);
+
+	struct gpu_glyph_contour {
+		std::uint32_t first_edge;
+		std::uint32_t edge_count;
+		std::int32_t winding;
+		std::uint32_t _padding;
+	};
+	static_assert(sizeof(gpu_glyph_contour) == 16);
+
+	struct gpu_glyph_edge {
+		//Only the first degree + 1 are used
+		std::array<float, 8> points;
+		//Unnormalized directions at both ends, and the normalized bisectors of the corners with the previous and next edges
+		std::array<float, 2> start_direction;
+		std::array<float, 2> end_direction;
+		std::array<float, 2> start_bisector;
+		std::array<float, 2> end_bisector;
+		std::uint32_t degree;
+		std::uint32_t color;
+	};
+	static_assert(sizeof(gpu_glyph_edge) == 72);
+
+	//shaders/generate_glyphs.comp's push constants
+	struct glyph_generation_constants {
+		gpu_address_t glyphs;
+		gpu_address_t contours;
+		gpu_address_t edges;
+	};
+}
+
+
+namespace acma {
+	//Glyph outlines flattened for shaders/generate_glyphs.comp, which generates their MSDFs straight into storage images: the glyphs, their
+	//contours and their edges (already prepared like glyph_distance_field does, i.e. with their corners' bisectors) are laid out one after
+	//another, so a single generic buffer holds the whole batch (see decoder::flatten_glyphs).
+	//The shader skips msdfgen's error correction, and needs the RGBA8 target images to be storage images: on devices without
+	//vk::physical_device::supports_storage_image(VK_FORMAT_R8G8B8A8_UNORM), generate the glyphs with decoder::generate_glyphs instead
+	class glyph_edge_buffer {
+	public:
+		//The shader's font_texture length and workgroup size
+		constexpr static std::uint32_t texture_length_pixels = 32;
+		constexpr static std::uint32_t workgroup_length = 8;
+
+	public:
+		void add_glyph(glyph_outline const& outline, double scale, pt2d translate, double distance_range, std::uint32_t image_index, pt2u32 offset, sz2u32 size) noexcept;
+		//Moves the glyph_idx'th glyph's extent to offset and resizes it (an empty size writes nothing), e.g. once the glyph has been packed
+		void set_target(std::size_t glyph_idx, pt2u32 offset, sz2u32 size) noexcept;
+		void clear() noexcept;
+
+	public:
+		constexpr std::size_t glyph_count() const noexcept { return glyphs.size(); }
+		constexpr bool empty() const noexcept { return glyphs.empty(); }
+
+		constexpr std::size_t contours_offset() const noexcept { return align(glyphs.size() * sizeof(gpu_glyph)); }
+		constexpr std::size_t edges_offset() const noexcept { return contours_offset() + align(contours.size() * sizeof(gpu_glyph_contour)); }
+		constexpr std::size_t size_bytes() const noexcept { return edges_offset() + edges.size() * sizeof(gpu_glyph_edge); }
+
+		//dst must hold at least size_bytes()
+		void write(std::byte* dst) const noexcept;
+		//The push constants for a buffer that the batch was written to (at buffer_address)
+		constexpr glyph_generation_constants constants(gpu_address_t buffer_address) const noexcept {
+			return {buffer_address, buffer_address + contours_offset(), buffer_address + edges_offset()};
+		}
+		//One workgroup per workgroup_length x workgroup_length texels, with a z per glyph
+		constexpr dispatch_command_t dispatch_command() const noexcept {
+			return {texture_length_pixels / workgroup_length, texture_length_pixels / workgroup_length, static_cast<std::uint32_t>(glyphs.size())};
+		}
+
+	private:
+		constexpr static std::size_t align(std::size_t n) noexcept { return (n + 15) / 16 * 16; }
+
+	private:
+		std::vector<gpu_glyph> glyphs;
+		std::vector<gpu_glyph_contour> contours;
+		std::vector<gpu_glyph_edge> edges;
+		//Scratch memory for add_glyph
+		std::vector<impl::prepared_edge> prepared;
+	};
+}
+
+
+#include "sirius/graphics/core/glyph_edge_buffer.inl"
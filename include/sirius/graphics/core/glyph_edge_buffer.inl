@@ -0,0 +1,64 @@
+#pragma once
+#include "sirius/graphics/core/glyph_edge_buffer.hpp"
+#include <cstring>
+
+
+namespace acma {
+	inline void glyph_edge_buffer::add_glyph(glyph_outline const& outline, double scale, pt2d translate, double distance_range, std::uint32_t image_index, pt2u32 offset, sz2u32 size) noexcept {
+		glyphs.push_back(gpu_glyph{
+			.first_contour = static_cast<std::uint32_t>(contours.size()),
+			.contour_count = static_cast<std::uint32_t>(outline.contour_count()),
+			.image_index = image_index,
+			._padding = 0,
+			.offset = {offset.x(), offset.y()},
+			.size = {size.width(), size.height()},
+			.translate = {static_cast<float>(translate.x()), static_cast<float>(translate.y())},
+			.scale = static_cast<float>(scale),
+			.distance_range = static_cast<float>(distance_range),
+		});
+
+		for(std::size_t c = 0; c < outline.contour_count(); ++c) {
+			std::span<glyph_edge const> contour = outline.contour(c);
+			contours.push_back(gpu_glyph_contour{
+				.first_edge = static_cast<std::uint32_t>(edges.size()),
+				.edge_count = static_cast<std::uint32_t>(contour.size()),
+				.winding = impl::winding(contour),
+				._padding = 0,
+			});
+
+			prepared.clear();
+			impl::prepare_contour(contour, prepared);
+			for(impl::prepared_edge const& e : prepared) {
+				gpu_glyph_edge& out = edges.emplace_back();
+				for(std::size_t i = 0; i < 4; ++i) {
+					out.points[2 * i] = static_cast<float>(e.x[i]);
+					out.points[2 * i + 1] = static_cast<float>(e.y[i]);
+				}
+				out.start_direction = {static_cast<float>(e.dir0_x), static_cast<float>(e.dir0_y)};
+				out.end_direction = {static_cast<float>(e.dir1_x), static_cast<float>(e.dir1_y)};
+				out.start_bisector = {static_cast<float>(e.a_bisector_x), static_cast<float>(e.a_bisector_y)};
+				out.end_bisector = {static_cast<float>(e.b_bisector_x), static_cast<float>(e.b_bisector_y)};
+				out.degree = e.degree;
+				out.color = e.color;
+			}
+		}
+	}
+
+	inline void glyph_edge_buffer::set_target(std::size_t glyph_idx, pt2u32 offset, sz2u32 size) noexcept {
+		glyphs[glyph_idx].offset = {offset.x(), offset.y()};
+		glyphs[glyph_idx].size = {size.width(), size.height()};
+	}
+
+	inline void glyph_edge_buffer::clear() noexcept {
+		glyphs.clear();
+		contours.clear();
+		edges.clear();
+	}
+
+	inline void glyph_edge_buffer::write(std::byte* dst) const noexcept {
+		//Glyphs without an outline have no contours, so any of these may be empty
+		if(!glyphs.empty())   std::memcpy(dst, glyphs.data(), glyphs.size() * sizeof(gpu_glyph));
+		if(!contours.empty()) std::memcpy(dst + contours_offset(), contours.data(), contours.size() * sizeof(gpu_glyph_contour));
+		if(!edges.empty())    std::memcpy(dst + edges_offset(), edges.data(), edges.size() * sizeof(gpu_glyph_edge));
+	}
+}
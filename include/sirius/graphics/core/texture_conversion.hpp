@@ -0,0 +1,159 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <streamline/numeric/int.hpp>
+#include <vulkan/vulkan.h>
+
+#include "sirius/core/error.hpp"
+#include "sirius/graphics/core/color_conversion.hpp"
+#include "sirius/graphics/core/texture.hpp"
+#include "sirius/graphics/core/texture_view.hpp"
+
+
+namespace acma::impl {
+	struct texture_color_layout {
+		sl::uint32_t channels;
+		bool is_16_bit;
+		VkFormat linear_format;
+		VkFormat srgb_format;
+	};
+
+	//Only uncompressed unorm formats with 8 or 16 bits per component can be converted.
+	//A channel count of 0 means the format isn't supported
+	constexpr texture_color_layout color_layout(VkFormat format) noexcept {
+		switch(format) {
+		case VK_FORMAT_R8_UNORM:
+		case VK_FORMAT_R8_SRGB:
+			return {1, false, VK_FORMAT_R8_UNORM, VK_FORMAT_R8_SRGB};
+		case VK_FORMAT_R8G8B8_UNORM:
+		case VK_FORMAT_R8G8B8_SRGB:
+			return {3, false, VK_FORMAT_R8G8B8_UNORM, VK_FORMAT_R8G8B8_SRGB};
+		case VK_FORMAT_B8G8R8_UNORM:
+		case VK_FORMAT_B8G8R8_SRGB:
+			return {3, false, VK_FORMAT_B8G8R8_UNORM, VK_FORMAT_B8G8R8_SRGB};
+		case VK_FORMAT_R8G8B8A8_UNORM:
+		case VK_FORMAT_R8G8B8A8_SRGB:
+			return {4, false, VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R8G8B8A8_SRGB};
+		case VK_FORMAT_B8G8R8A8_UNORM:
+		case VK_FORMAT_B8G8R8A8_SRGB:
+			return {4, false, VK_FORMAT_B8G8R8A8_UNORM, VK_FORMAT_B8G8R8A8_SRGB};
+		//Packed in a little endian uint32, so the bytes are in RGBA order
+		case VK_FORMAT_A8B8G8R8_UNORM_PACK32:
+		case VK_FORMAT_A8B8G8R8_SRGB_PACK32:
+			return {4, false, VK_FORMAT_A8B8G8R8_UNORM_PACK32, VK_FORMAT_A8B8G8R8_SRGB_PACK32};
+		//There are no 16-bit sRGB formats, so these can only be premultiplied
+		case VK_FORMAT_R16G16B16A16_UNORM:
+			return {4, true, VK_FORMAT_R16G16B16A16_UNORM, VK_FORMAT_UNDEFINED};
+		default:
+			return {0, false, VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED};
+		}
+	}
+
+	template<typename T>
+	std::span<T> texture_components(std::span<sl::byte> bytes) noexcept {
+		return {reinterpret_cast<T*>(bytes.data()), bytes.size() / sizeof(T)};
+	}
+
+	template<typename T, typename Fn>
+	void for_channel_count(sl::uint32_t channels, std::span<sl::byte> bytes, Fn&& fn) noexcept {
+		switch(channels) {
+		case 1: fn.template operator()<1>(texture_components<T>(bytes)); break;
+		case 3: fn.template operator()<3>(texture_components<T>(bytes)); break;
+		case 4: fn.template operator()<4>(texture_components<T>(bytes)); break;
+		default: break;
+		}
+	}
+
+	//Copies src's data into dst and converts it there, returning a view of dst with src's info and the converted format
+	template<typename Fn>
+	result<texture_view> convert_copy(texture_view src, std::span<sl::byte> dst, Fn&& convert_in_place) noexcept {
+		if(dst.size() < src.bytes.size()) return error::invalid_argument;
+		std::copy(src.bytes.begin(), src.bytes.end(), dst.begin());
+		RESULT_TRY_COPY_UNSCOPED(const VkFormat format, convert_in_place(src.format_id, dst.first(src.bytes.size())), format_result);
+		texture_view ret{src};
+		ret.format_id = format;
+		ret.bytes = dst.first(src.bytes.size());
+		return ret;
+	}
+}
+
+
+//Converts every mip level and layer of a texture's data, which is either converted in place (a texture, or raw bytes such as mapped
+//staging memory, given with their format) or copied from a texture_view into a destination span at least as large as its data.
+//The raw byte overloads return the format the data has afterwards, and the texture_view overloads return a view of the destination.
+//Each of these fails with texture_type_not_supported if the format can't be converted
+namespace acma {
+	//sRGB to linear, changing the format to its unorm counterpart
+	inline result<VkFormat> convert_to_linear(VkFormat format, std::span<sl::byte> bytes) noexcept {
+		const impl::texture_color_layout layout = impl::color_layout(format);
+		if(format != layout.srgb_format || layout.channels == 0) return error::texture_type_not_supported;
+
+		impl::for_channel_count<std::uint8_t>(layout.channels, bytes, []<std::size_t Channels>(std::span<std::uint8_t> components) noexcept {
+			srgb_to_linear<Channels>(components);
+		});
+		return layout.linear_format;
+	}
+
+	//Linear to sRGB, changing the format to its sRGB counterpart
+	inline result<VkFormat> convert_to_srgb(VkFormat format, std::span<sl::byte> bytes) noexcept {
+		const impl::texture_color_layout layout = impl::color_layout(format);
+		if(format != layout.linear_format || layout.srgb_format == VK_FORMAT_UNDEFINED || layout.channels == 0) return error::texture_type_not_supported;
+
+		impl::for_channel_count<std::uint8_t>(layout.channels, bytes, []<std::size_t Channels>(std::span<std::uint8_t> components) noexcept {
+			linear_to_srgb<Channels>(components);
+		});
+		return layout.srgb_format;
+	}
+
+
+	inline result<VkFormat> premultiply_alpha(VkFormat format, std::span<sl::byte> bytes) noexcept {
+		const impl::texture_color_layout layout = impl::color_layout(format);
+		if(layout.channels != 4) return error::texture_type_not_supported;
+
+		if(layout.is_16_bit) premultiply_alpha<4>(impl::texture_components<std::uint16_t>(bytes));
+		else premultiply_alpha<4>(impl::texture_components<std::uint8_t>(bytes));
+		return format;
+	}
+
+	inline result<VkFormat> unpremultiply_alpha(VkFormat format, std::span<sl::byte> bytes) noexcept {
+		const impl::texture_color_layout layout = impl::color_layout(format);
+		if(layout.channels != 4) return error::texture_type_not_supported;
+
+		if(layout.is_16_bit) unpremultiply_alpha<4>(impl::texture_components<std::uint16_t>(bytes));
+		else unpremultiply_alpha<4>(impl::texture_components<std::uint8_t>(bytes));
+		return format;
+	}
+}
+
+namespace acma {
+	inline result<void> convert_to_linear(texture& t) noexcept {
+		RESULT_TRY_COPY_UNSCOPED(t.format_id, convert_to_linear(t.format_id, t.bytes), format_result);
+		return {};
+	}
+	inline result<void> convert_to_srgb(texture& t) noexcept {
+		RESULT_TRY_COPY_UNSCOPED(t.format_id, convert_to_srgb(t.format_id, t.bytes), format_result);
+		return {};
+	}
+	inline result<void> premultiply_alpha(texture& t) noexcept {
+		RESULT_VERIFY(premultiply_alpha(t.format_id, t.bytes));
+		return {};
+	}
+	inline result<void> unpremultiply_alpha(texture& t) noexcept {
+		RESULT_VERIFY(unpremultiply_alpha(t.format_id, t.bytes));
+		return {};
+	}
+
+	inline result<texture_view> convert_to_linear(texture_view src, std::span<sl::byte> dst) noexcept {
+		return impl::convert_copy(src, dst, [](VkFormat format, std::span<sl::byte> bytes) noexcept { return convert_to_linear(format, bytes); });
+	}
+	inline result<texture_view> convert_to_srgb(texture_view src, std::span<sl::byte> dst) noexcept {
+		return impl::convert_copy(src, dst, [](VkFormat format, std::span<sl::byte> bytes) noexcept { return convert_to_srgb(format, bytes); });
+	}
+	inline result<texture_view> premultiply_alpha(texture_view src, std::span<sl::byte> dst) noexcept {
+		return impl::convert_copy(src, dst, [](VkFormat format, std::span<sl::byte> bytes) noexcept { return premultiply_alpha(format, bytes); });
+	}
+	inline result<texture_view> unpremultiply_alpha(texture_view src, std::span<sl::byte> dst) noexcept {
+		return impl::convert_copy(src, dst, [](VkFormat format, std::span<sl::byte> bytes) noexcept { return unpremultiply_alpha(format, bytes); });
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "sirius/input/combination.hpp"
+#include "sirius/input/event_set.hpp"
+
+
+namespace acma::input {
+    //Open-addressing hash map from combination to event_set, replacing std::unordered_map on the process_input path.
+    //Entries are stored densely and the table only holds 8 byte slots (32 bits of the hash and the entry index), so a lookup reads
+    //a slot, then compares one key with memcmp, instead of walking a bucket's node list.
+    //Like other flat maps, inserting or erasing invalidates iterators and references to entries
+    class binding_map {
+    public:
+        using key_type = combination;
+        using mapped_type = event_set;
+        using value_type = std::pair<combination, event_set>;
+        using iterator = std::vector<value_type>::iterator;
+        using const_iterator = std::vector<value_type>::const_iterator;
+
+    public:
+        binding_map() noexcept = default;
+        binding_map(std::initializer_list<value_type> bindings) noexcept;
+
+    public:
+        iterator       find(combination const& key)       noexcept;
+        const_iterator find(combination const& key) const noexcept;
+        bool contains(combination const& key) const noexcept { return find(key) != end(); }
+
+        event_set& operator[](combination const& key) noexcept { return try_emplace(key).first->second; }
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(combination const& key, Args&&... args) noexcept;
+        std::pair<iterator, bool> insert(value_type const& binding) noexcept { return try_emplace(binding.first, binding.second); }
+        std::pair<iterator, bool> insert_or_assign(combination const& key, event_set const& events) noexcept;
+
+        //Moves the last entry into the erased one's place
+        std::size_t erase(combination const& key) noexcept;
+        void clear() noexcept;
+        void reserve(std::size_t count) noexcept;
+
+    public:
+        //Rebuilds the table as a perfect hash of the current bindings, so that every lookup reads exactly one slot, with no probing.
+        //Meant for bindings that are fixed at startup: erasing keeps the map frozen, but inserting a new combination goes back to
+        //the open-addressing table (and freeze has to be called again)
+        void freeze() noexcept;
+        bool frozen() const noexcept { return !pilots.empty(); }
+
+    public:
+        std::size_t size() const noexcept { return entries.size(); }
+        bool empty() const noexcept { return entries.empty(); }
+
+        iterator       begin()       noexcept { return entries.begin(); }
+        const_iterator begin() const noexcept { return entries.begin(); }
+        iterator       end()       noexcept { return entries.end(); }
+        const_iterator end() const noexcept { return entries.end(); }
+
+    private:
+        struct slot {
+            std::uint32_t hash;
+            //Entry index + 1, or 0 if the slot is empty
+            std::uint32_t index;
+        };
+        constexpr static std::size_t npos = std::numeric_limits<std::size_t>::max();
+        constexpr static std::size_t min_slots = 16;
+
+    private:
+        std::size_t frozen_slot(std::uint64_t hash) const noexcept;
+        std::size_t find_slot(combination const& key, std::uint64_t hash) const noexcept;
+        void insert_slot(std::uint64_t hash, std::uint32_t index) noexcept;
+        void erase_slot(std::size_t pos) noexcept;
+        void rehash(std::size_t slot_count) noexcept;
+        bool try_freeze(std::size_t slot_count, std::size_t bucket_count) noexcept;
+
+    private:
+        std::vector<value_type> entries;
+        std::vector<slot> slots;
+        //Per-bucket displacement of the perfect hash (empty unless frozen)
+        std::vector<std::uint32_t> pilots;
+    };
+}
+
+
+#include "sirius/input/binding_map.inl"
@@ -0,0 +1,183 @@
+#pragma once
+#include "sirius/input/binding_map.hpp"
+#include <algorithm>
+#include <bit>
+#include <numeric>
+
+
+namespace acma::input {
+    inline binding_map::binding_map(std::initializer_list<value_type> bindings) noexcept {
+        reserve(bindings.size());
+        for(value_type const& binding : bindings) insert(binding);
+    }
+}
+
+
+namespace acma::input {
+    inline binding_map::iterator binding_map::find(combination const& key) noexcept {
+        const std::size_t pos = find_slot(key, impl::hash_combination(key));
+        return pos == npos ? end() : begin() + (slots[pos].index - 1);
+    }
+
+    inline binding_map::const_iterator binding_map::find(combination const& key) const noexcept {
+        const std::size_t pos = find_slot(key, impl::hash_combination(key));
+        return pos == npos ? end() : begin() + (slots[pos].index - 1);
+    }
+
+
+    template<typename... Args>
+    std::pair<binding_map::iterator, bool> binding_map::try_emplace(combination const& key, Args&&... args) noexcept {
+        const std::uint64_t hash = impl::hash_combination(key);
+        if(const std::size_t pos = find_slot(key, hash); pos != npos)
+            return {begin() + (slots[pos].index - 1), false};
+
+        if(frozen()) {
+            pilots.clear();
+            rehash(slots.size());
+        }
+        if((entries.size() + 1) * 2 > slots.size()) rehash(std::max(min_slots, slots.size() * 2));
+
+        entries.emplace_back(key, event_set{std::forward<Args>(args)...});
+        insert_slot(hash, static_cast<std::uint32_t>(entries.size()));
+        return {end() - 1, true};
+    }
+
+    inline std::pair<binding_map::iterator, bool> binding_map::insert_or_assign(combination const& key, event_set const& events) noexcept {
+        auto ret = try_emplace(key, events);
+        if(!ret.second) ret.first->second = events;
+        return ret;
+    }
+
+
+    inline std::size_t binding_map::erase(combination const& key) noexcept {
+        const std::size_t pos = find_slot(key, impl::hash_combination(key));
+        if(pos == npos) return 0;
+
+        const std::size_t index = slots[pos].index - 1, last = entries.size() - 1;
+        erase_slot(pos);
+        if(index != last) {
+            combination const& moved_key = entries[last].first;
+            slots[find_slot(moved_key, impl::hash_combination(moved_key))].index = static_cast<std::uint32_t>(index + 1);
+            entries[index] = std::move(entries[last]);
+        }
+        entries.pop_back();
+        return 1;
+    }
+
+    inline void binding_map::clear() noexcept {
+        entries.clear();
+        slots.clear();
+        pilots.clear();
+    }
+
+    inline void binding_map::reserve(std::size_t count) noexcept {
+        entries.reserve(count);
+        if(!frozen() && count * 2 > slots.size()) rehash(std::bit_ceil(std::max(min_slots, count * 2)));
+    }
+}
+
+
+namespace acma::input {
+    //Frozen tables are a PTHash-style perfect hash: the upper half of the hash picks a bucket, and the bucket's pilot (found by
+    //freeze) displaces the lower half so that no two keys share a slot
+    inline std::size_t binding_map::frozen_slot(std::uint64_t hash) const noexcept {
+        const std::uint64_t pilot = pilots[(hash >> 32) & (pilots.size() - 1)];
+        return (hash ^ impl::mum(pilot ^ 0x9e3779b97f4a7c15ull, 0xbf58476d1ce4e5b9ull)) & (slots.size() - 1);
+    }
+
+    inline std::size_t binding_map::find_slot(combination const& key, std::uint64_t hash) const noexcept {
+        if(slots.empty()) return npos;
+        const std::uint32_t fragment = static_cast<std::uint32_t>(hash);
+        const auto matches = [&](slot s) noexcept { return s.hash == fragment && entries[s.index - 1].first == key; };
+
+        if(frozen()) {
+            const std::size_t pos = frozen_slot(hash);
+            return slots[pos].index != 0 && matches(slots[pos]) ? pos : npos;
+        }
+
+        const std::size_t mask = slots.size() - 1;
+        for(std::size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+            if(slots[pos].index == 0) return npos;
+            if(matches(slots[pos])) return pos;
+        }
+    }
+
+    inline void binding_map::insert_slot(std::uint64_t hash, std::uint32_t index) noexcept {
+        const std::size_t mask = slots.size() - 1;
+        std::size_t pos = hash & mask;
+        while(slots[pos].index != 0) pos = (pos + 1) & mask;
+        slots[pos] = {static_cast<std::uint32_t>(hash), index};
+    }
+
+    inline void binding_map::erase_slot(std::size_t pos) noexcept {
+        if(!frozen()) {
+            //Backward-shift deletion: pull later slots of the same probe run into the hole, so that no tombstones are needed
+            const std::size_t mask = slots.size() - 1;
+            for(std::size_t next = (pos + 1) & mask; slots[next].index != 0; next = (next + 1) & mask) {
+                const std::size_t home = slots[next].hash & mask;
+                if(((next - home) & mask) < ((next - pos) & mask)) continue;
+                slots[pos] = slots[next];
+                pos = next;
+            }
+        }
+        slots[pos] = {};
+    }
+
+    inline void binding_map::rehash(std::size_t slot_count) noexcept {
+        slots.assign(slot_count, slot{});
+        for(std::size_t i = 0; i < entries.size(); ++i)
+            insert_slot(impl::hash_combination(entries[i].first), static_cast<std::uint32_t>(i + 1));
+    }
+}
+
+
+namespace acma::input {
+    inline void binding_map::freeze() noexcept {
+        if(entries.empty()) return;
+
+        //At most half full, with 4 keys per bucket on average
+        std::size_t slot_count = std::bit_ceil(std::max(min_slots, entries.size() * 2));
+        while(!try_freeze(slot_count, std::max<std::size_t>(1, slot_count / 8))) slot_count *= 2;
+    }
+
+    inline bool binding_map::try_freeze(std::size_t slot_count, std::size_t bucket_count) noexcept {
+        std::vector<std::uint64_t> hashes(entries.size());
+        std::vector<std::vector<std::uint32_t>> buckets(bucket_count);
+        for(std::size_t i = 0; i < entries.size(); ++i) {
+            hashes[i] = impl::hash_combination(entries[i].first);
+            buckets[(hashes[i] >> 32) & (bucket_count - 1)].push_back(static_cast<std::uint32_t>(i));
+        }
+
+        //Placing the largest buckets first, while the table is still mostly empty, keeps the pilot search short
+        std::vector<std::size_t> order(bucket_count);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) noexcept { return buckets[a].size() > buckets[b].size(); });
+
+        slots.assign(slot_count, slot{});
+        pilots.assign(bucket_count, 0);
+        std::vector<std::size_t> positions;
+        for(std::size_t b : order) {
+            if(buckets[b].empty()) break;
+
+            bool placed = false;
+            for(std::uint32_t pilot = 0; pilot < (1u << 16) && !placed; ++pilot) {
+                pilots[b] = pilot;
+                positions.clear();
+                placed = true;
+                for(std::uint32_t i : buckets[b]) {
+                    const std::size_t pos = frozen_slot(hashes[i]);
+                    if(slots[pos].index != 0 || std::find(positions.begin(), positions.end(), pos) != positions.end()) {
+                        placed = false;
+                        break;
+                    }
+                    positions.push_back(pos);
+                }
+            }
+            if(!placed) return false;
+
+            for(std::size_t k = 0; k < positions.size(); ++k)
+                slots[positions[k]] = {static_cast<std::uint32_t>(hashes[buckets[b][k]]), buckets[b][k] + 1};
+        }
+        return true;
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "sirius/arith/point.hpp"
+#include "sirius/arith/vector.hpp"
+#include "sirius/input/event_queue.hpp"
+
+
+namespace acma::input {
+    enum class coalesce_mode : std::uint8_t {
+        //Every cursor motion and scroll is processed
+        off,
+        //Merged until the end of the frame (window::end_input_frame, called by render_instance::render).
+        //Nothing is processed for a frame that never ends, so only use this while rendering
+        per_frame,
+        //Merged while they arrive within `interval` of the first merged event, and never held past the drain that popped them
+        per_interval,
+    };
+
+    struct coalesce_policy {
+        //Off by default, so that every motion reaches the event functions unless merging is asked for
+        coalesce_mode mode = coalesce_mode::off;
+        std::chrono::microseconds interval{1000};
+    };
+
+
+    //The merged motion behind the mouse move or scroll event being processed (see window::input_pointer_motion).
+    //For scrolls, position is the accumulated delta (like the event's mouse_aux)
+    struct pointer_motion {
+        acma::pt2d position;
+        acma::vec2<double> delta;
+        //Every sample merged into this event, oldest first. Only valid while the event is being processed
+        std::span<event_record const> raw_history;
+    };
+}
+
+
+namespace acma::input::impl {
+    //Merges consecutive move or scroll records. Only used by the (single) consumer of the window's event_queue
+    class coalescer {
+    public:
+        //Returns true if the pending records have to be flushed before adding the record
+        constexpr bool splits(event_record const& record, coalesce_policy policy) const noexcept {
+            if(history.empty()) return false;
+            switch(policy.mode) {
+            case coalesce_mode::off:       return true;
+            case coalesce_mode::per_frame: return false;
+            default:                       return std::chrono::microseconds{record.time_us - history.front().time_us} >= policy.interval;
+            }
+        }
+        constexpr void add(event_record const& record) noexcept { history.push_back(record); }
+        constexpr bool pending() const noexcept { return !history.empty(); }
+
+        //Moves report the latest position and the distance covered since the last flush, scrolls the sum of their deltas
+        constexpr pointer_motion merged(bool accumulate) noexcept {
+            pointer_motion ret{history.back().aux, {}, history};
+            if(accumulate) {
+                ret.position = {};
+                for(event_record const& r : history) ret.position += r.aux;
+                ret.delta = ret.position;
+            }
+            else if(has_previous) ret.delta = ret.position - previous;
+            previous = history.back().aux;
+            has_previous = true;
+            return ret;
+        }
+        constexpr void clear() noexcept { history.clear(); }
+
+    private:
+        std::vector<event_record> history;
+        acma::pt2d previous;
+        bool has_previous = false;
+    };
+}
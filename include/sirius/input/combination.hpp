@@ -1,5 +1,6 @@
 #pragma once
 #include <array>
+#include <bit>
 #include <climits>
 #include <concepts>
 #include <cstring>
@@ -12,6 +13,7 @@
 
 #include <GLFW/glfw3.h>
 
+#include "sirius/core/hash.hpp"
 #include "sirius/input/code.hpp"
 
 
@@ -101,11 +103,25 @@ namespace acma::input {
 
 
 
+namespace acma::input::impl {
+    using acma::impl::mum;
+    using acma::impl::hash_secret;
+
+    //Reads the combination as 4 words (a single 256-bit load and xor with the secrets when vectorized), then folds them with 3 multiplies
+    constexpr std::uint64_t hash_combination(combination const& c, std::uint64_t seed = 0) noexcept {
+        const std::array<std::uint64_t, 4> w = std::bit_cast<std::array<std::uint64_t, 4>>(static_cast<combination_array const&>(c));
+        const std::uint64_t lo = mum(w[0] ^ hash_secret[0], w[1] ^ hash_secret[1] ^ seed);
+        const std::uint64_t hi = mum(w[2] ^ hash_secret[2], w[3] ^ hash_secret[3] ^ seed);
+        return mum(lo ^ hash_secret[1], hi ^ hash_secret[2]);
+    }
+}
+
+
 namespace std {
     template<>
     struct hash<acma::input::combination> {
-        constexpr std::size_t operator()(acma::input::combination input_combo) const noexcept {
-            return std::hash<acma::input::combination_bitset>{}(std::bit_cast<acma::input::combination_bitset>(input_combo));
+        constexpr std::size_t operator()(acma::input::combination const& input_combo) const noexcept {
+            return acma::input::impl::hash_combination(input_combo);
         }
     };
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "sirius/input/combination.hpp"
+
+
+namespace acma::input {
+    //The currently held inputs of a window, as a seqlock-protected combination.
+    //There is a single writer (the thread draining the window's event_queue, which processes events in order, so a press and its release
+    //are always applied in the order they happened), and any number of lock-free readers, which always see a combination the writer stored
+    //rather than a mix of two
+    class combination_state {
+    public:
+        constexpr static std::size_t word_count = combination_size / sizeof(std::uint64_t);
+
+    public:
+        combination_state() noexcept : sequence(0), words{}, written{} {}
+
+    public:
+        combination load() const noexcept {
+            std::array<std::uint64_t, word_count> snapshot;
+            for(;;) {
+                const std::uint32_t before = sequence.load(std::memory_order_acquire);
+                for(std::size_t i = 0; i < word_count; ++i) snapshot[i] = words[i].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                //Retry if the writer was storing (odd) or stored in between
+                if((before & 1) == 0 && sequence.load(std::memory_order_relaxed) == before) break;
+            }
+            return std::bit_cast<combination>(snapshot);
+        }
+
+        //The last stored combination, without going through the seqlock. Must only be called by the single writer
+        combination const& last_stored() const noexcept { return written; }
+
+        //Must only be called by the single writer
+        void store(combination const& c) noexcept {
+            written = c;
+            const std::array<std::uint64_t, word_count> w = std::bit_cast<std::array<std::uint64_t, word_count>>(static_cast<combination_array const&>(c));
+            const std::uint32_t s = sequence.load(std::memory_order_relaxed);
+            sequence.store(s + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for(std::size_t i = 0; i < word_count; ++i) words[i].store(w[i], std::memory_order_relaxed);
+            sequence.store(s + 2, std::memory_order_release);
+        }
+
+    private:
+        std::atomic<std::uint32_t> sequence;
+        std::array<std::atomic<std::uint64_t>, word_count> words;
+        //Writer-side copy, never read by readers
+        combination written;
+    };
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "sirius/input/category.hpp"
+#include "sirius/input/event_function.hpp"
+#include "sirius/input/event_int.hpp"
+
+
+namespace acma::input {
+    //Event ids in [0, dense_event_ids) (i.e. the ones an application declares as constants) are looked up by indexing,
+    //any others through a hash map
+    constexpr std::size_t dense_event_ids = 256;
+
+
+    //Non-owning reference to an event function: a single call through an invoker that takes the (large) arguments by reference.
+    //Lambdas and other function objects get an invoker of their own, which inlines them, rather than going through a function
+    //pointer taking the arguments by value (as a plain function pointer has to). Kept to 2 pointers, so that find returns it in registers
+    class event_function_ref {
+    public:
+        constexpr event_function_ref() noexcept = default;
+        constexpr event_function_ref(generic_event_function* fn) noexcept : target{.fn = fn}, call(fn ? &call_fn_ptr : nullptr) {}
+        //For captureless lambdas, which are called without an object
+        template<typename F> requires std::is_empty_v<F> && std::default_initializable<F>
+        constexpr event_function_ref(std::in_place_type_t<F>) noexcept : target{.object = nullptr}, call(&call_stateless<F>) {}
+        //For function objects owned by an event_fns_map
+        template<typename F>
+        constexpr event_function_ref(F* object) noexcept : target{.object = object}, call(&call_object<F>) {}
+
+    public:
+        constexpr explicit operator bool() const noexcept { return call; }
+
+        void operator()(void* win, combination combo, bool pressed, categorized_event_t event, mouse_aux_t mouse_aux, void* user_ptr) const noexcept {
+            call(target, win, combo, pressed, event, mouse_aux, user_ptr);
+        }
+
+    private:
+        union target_type {
+            generic_event_function* fn;
+            void* object;
+        };
+        using invoker = void(target_type, void*, combination const&, bool, categorized_event_t, mouse_aux_t const&, void*);
+
+        static void call_fn_ptr(target_type target, void* win, combination const& combo, bool pressed, categorized_event_t event, mouse_aux_t const& mouse_aux, void* user_ptr) {
+            target.fn(win, combo, pressed, event, mouse_aux, user_ptr);
+        }
+        template<typename F>
+        static void call_stateless(target_type, void* win, combination const& combo, bool pressed, categorized_event_t event, mouse_aux_t const& mouse_aux, void* user_ptr) {
+            F{}(win, combo, pressed, event, mouse_aux, user_ptr);
+        }
+        template<typename F>
+        static void call_object(target_type target, void* win, combination const& combo, bool pressed, categorized_event_t event, mouse_aux_t const& mouse_aux, void* user_ptr) {
+            (*static_cast<F*>(target.object))(win, combo, pressed, event, mouse_aux, user_ptr);
+        }
+
+    private:
+        target_type target{.fn = nullptr};
+        invoker* call = nullptr;
+    };
+}
+
+
+namespace acma::input {
+    //Event functions by categorized event, replacing std::unordered_map<categorized_event_t, std::function<generic_event_function>>.
+    //Each category has a dense row of event_function_refs for the ids below dense_event_ids, so process_input dispatching one event
+    //to several categories indexes a row per category instead of hashing. Captureless lambdas and function pointers are referred
+    //to directly; any other function object is moved onto the heap (at a stable address) and the row refers to it
+    class event_fns_map {
+    public:
+        event_fns_map() noexcept = default;
+        event_fns_map(event_fns_map&&) noexcept = default;
+        event_fns_map& operator=(event_fns_map&&) noexcept = default;
+        //The rows point into owned_fns
+        event_fns_map(event_fns_map const&) = delete;
+        event_fns_map& operator=(event_fns_map const&) = delete;
+
+    public:
+        //Returns a null event_function_ref if nothing is registered for the event
+        event_function_ref find(categorized_event_t event) const noexcept;
+        bool contains(categorized_event_t event) const noexcept { return static_cast<bool>(find(event)); }
+
+        //Returns false (and keeps the existing function) if the event already has one
+        template<typename F> requires std::invocable<F&, void*, combination, bool, categorized_event_t, mouse_aux_t, void*>
+        bool try_emplace(categorized_event_t event, F&& fn) noexcept;
+        template<typename F> requires std::invocable<F&, void*, combination, bool, categorized_event_t, mouse_aux_t, void*>
+        void insert_or_assign(categorized_event_t event, F&& fn) noexcept;
+
+        std::size_t erase(categorized_event_t event) noexcept;
+        void clear() noexcept;
+
+    public:
+        std::size_t size() const noexcept { return count; }
+        bool empty() const noexcept { return count == 0; }
+
+    private:
+        event_function_ref* dense_slot(categorized_event_t event) noexcept;
+        template<typename F>
+        event_function_ref make_ref(categorized_event_t event, F&& fn) noexcept;
+
+    private:
+        std::array<std::vector<event_function_ref>, num_categories> rows;
+        //Events outside of the dense rows
+        std::unordered_map<categorized_event_t, event_function_ref> sparse;
+        //Stateful function objects, referred to by the rows or sparse
+        using owned_function = std::unique_ptr<void, void(*)(void*) noexcept>;
+        std::unordered_map<categorized_event_t, owned_function> owned_fns;
+        std::size_t count = 0;
+    };
+}
+
+
+#include "sirius/input/event_fns_map.inl"
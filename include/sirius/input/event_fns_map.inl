@@ -0,0 +1,78 @@
+#pragma once
+#include "sirius/input/event_fns_map.hpp"
+#include <utility>
+
+
+namespace acma::input {
+    inline event_function_ref event_fns_map::find(categorized_event_t event) const noexcept {
+        if(event.category_id < num_categories && event.event_id >= 0 && static_cast<std::size_t>(event.event_id) < dense_event_ids) {
+            std::vector<event_function_ref> const& row = rows[event.category_id];
+            return static_cast<std::size_t>(event.event_id) < row.size() ? row[event.event_id] : event_function_ref{};
+        }
+        auto it = sparse.find(event);
+        return it == sparse.end() ? event_function_ref{} : it->second;
+    }
+
+
+    template<typename F> requires std::invocable<F&, void*, combination, bool, categorized_event_t, mouse_aux_t, void*>
+    bool event_fns_map::try_emplace(categorized_event_t event, F&& fn) noexcept {
+        if(contains(event)) return false;
+        insert_or_assign(event, std::forward<F>(fn));
+        return true;
+    }
+
+    template<typename F> requires std::invocable<F&, void*, combination, bool, categorized_event_t, mouse_aux_t, void*>
+    void event_fns_map::insert_or_assign(categorized_event_t event, F&& fn) noexcept {
+        erase(event);
+        const event_function_ref ref = make_ref(event, std::forward<F>(fn));
+        //Assigning an empty function only erases
+        if(!ref) return;
+        if(event_function_ref* slot = dense_slot(event)) *slot = ref;
+        else sparse.emplace(event, ref);
+        ++count;
+    }
+
+
+    inline std::size_t event_fns_map::erase(categorized_event_t event) noexcept {
+        if(!contains(event)) return 0;
+        if(event_function_ref* slot = dense_slot(event)) *slot = {};
+        else sparse.erase(event);
+        owned_fns.erase(event);
+        --count;
+        return 1;
+    }
+
+    inline void event_fns_map::clear() noexcept {
+        for(std::vector<event_function_ref>& row : rows) row.clear();
+        sparse.clear();
+        owned_fns.clear();
+        count = 0;
+    }
+}
+
+
+namespace acma::input {
+    inline event_function_ref* event_fns_map::dense_slot(categorized_event_t event) noexcept {
+        if(event.category_id >= num_categories || event.event_id < 0 || static_cast<std::size_t>(event.event_id) >= dense_event_ids) return nullptr;
+        std::vector<event_function_ref>& row = rows[event.category_id];
+        if(static_cast<std::size_t>(event.event_id) >= row.size()) row.resize(event.event_id + 1);
+        return &row[event.event_id];
+    }
+
+    template<typename F>
+    event_function_ref event_fns_map::make_ref(categorized_event_t event, F&& fn) noexcept {
+        using fn_type = std::remove_cvref_t<F>;
+        if constexpr(std::is_class_v<fn_type> && std::is_empty_v<fn_type> && std::default_initializable<fn_type> && std::is_convertible_v<fn_type, generic_event_function*>)
+            return std::in_place_type<fn_type>;
+        else if constexpr(std::is_convertible_v<fn_type, generic_event_function*>) return static_cast<generic_event_function*>(fn);
+        else {
+            //Assigning an empty std::function only erases
+            if constexpr(std::is_same_v<fn_type, std::function<generic_event_function>>) {
+                if(!fn) return {};
+            }
+            fn_type* const object = new fn_type(std::forward<F>(fn));
+            owned_fns.insert_or_assign(event, owned_function(object, [](void* p) noexcept { delete static_cast<fn_type*>(p); }));
+            return object;
+        }
+    }
+}
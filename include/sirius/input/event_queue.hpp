@@ -0,0 +1,95 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include "sirius/arith/point.hpp"
+#include "sirius/input/code.hpp"
+#include "sirius/input/event_function.hpp"
+
+
+namespace acma::input {
+    namespace input_action {
+    enum : std::uint8_t {
+        release,
+        press,
+        //Processed as a press followed by a release (mouse moves and scrolls, which have no release of their own)
+        press_release,
+        //Not an input: marks the end of a frame for coalesce_mode::per_frame
+        end_frame,
+    };
+    }
+
+    //One queued GLFW callback
+    struct event_record {
+        acma::pt2d aux;
+        //Microseconds on the steady clock when the callback ran (wraps around every ~71 minutes, so only compare differences)
+        std::uint32_t time_us;
+        code_t code;
+        std::uint8_t action;
+        bool has_aux;
+
+    public:
+        constexpr mouse_aux_t mouse_aux() const noexcept { return has_aux ? mouse_aux_t{aux} : std::nullopt; }
+
+        static std::uint32_t now_us() noexcept {
+            return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+    };
+}
+
+
+namespace acma::input {
+    //Bounded lock-free multi-producer single-consumer ring buffer of event_records (Vyukov's bounded queue, with a single consumer).
+    //Producers (GLFW callbacks) push without allocating, and count each push in `pending`: only the push that takes it from 0
+    //schedules a drain, so a flood of mouse moves costs one drain task rather than one task per event.
+    //The drain then keeps popping until `pending` can be reset to 0, which also makes it the only consumer until then
+    class event_queue {
+    public:
+        constexpr static std::size_t capacity = 2048;
+
+    public:
+        event_queue() noexcept;
+
+    public:
+        //Returns false if the queue is full
+        bool push(event_record const& record) noexcept;
+        //Must only be called by the current consumer
+        std::size_t pop(std::span<event_record> dst) noexcept;
+
+    public:
+        //Counts a push. Returns true if the caller has to schedule a drain (i.e. no drain is pending)
+        bool request_drain() noexcept { return pending.fetch_add(1, std::memory_order_acq_rel) == 0; }
+
+        //Pops every record in batches, calling f(std::span<event_record const>) on each batch, and idle() whenever the queue runs empty
+        //(while still the only consumer, e.g. to flush state built up from the batches).
+        //Must only be called after request_drain returned true, and returns once no push is left unprocessed
+        template<typename F, typename Idle>
+        void drain(F&& f, Idle&& idle) noexcept;
+        template<typename F>
+        void drain(F&& f) noexcept { drain(std::forward<F>(f), []() noexcept {}); }
+
+    private:
+        //Not std::hardware_destructive_interference_size, which GCC warns about using in headers
+        constexpr static std::size_t cache_line_size = 64;
+
+        struct cell {
+            std::atomic<std::size_t> sequence;
+            event_record record;
+        };
+
+    private:
+        alignas(cache_line_size) std::atomic<std::size_t> tail;
+        alignas(cache_line_size) std::atomic<std::uint64_t> pending;
+        alignas(cache_line_size) std::size_t head;
+        std::array<cell, capacity> cells;
+    };
+}
+
+
+#include "sirius/input/event_queue.inl"
@@ -0,0 +1,57 @@
+#pragma once
+#include "sirius/input/event_queue.hpp"
+#include <bit>
+
+
+namespace acma::input {
+    inline event_queue::event_queue() noexcept : tail(0), pending(0), head(0) {
+        static_assert(std::has_single_bit(capacity), "event_queue capacity must be a power of 2");
+        for(std::size_t i = 0; i < capacity; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+
+    inline bool event_queue::push(event_record const& record) noexcept {
+        std::size_t pos = tail.load(std::memory_order_relaxed);
+        for(;;) {
+            cell& c = cells[pos & (capacity - 1)];
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(c.sequence.load(std::memory_order_acquire)) - static_cast<std::ptrdiff_t>(pos);
+            //The cell is free for this lap: claim it
+            if(diff == 0) {
+                if(tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.record = record;
+                    c.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            //The cell still holds last lap's record
+            else if(diff < 0) return false;
+            //Another producer claimed it first
+            else pos = tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    inline std::size_t event_queue::pop(std::span<event_record> dst) noexcept {
+        std::size_t count = 0;
+        for(; count < dst.size(); ++count, ++head) {
+            cell& c = cells[head & (capacity - 1)];
+            if(c.sequence.load(std::memory_order_acquire) != head + 1) break;
+            dst[count] = c.record;
+            c.sequence.store(head + capacity, std::memory_order_release);
+        }
+        return count;
+    }
+
+
+    template<typename F, typename Idle>
+    void event_queue::drain(F&& f, Idle&& idle) noexcept {
+        std::array<event_record, 64> batch;
+        for(std::uint64_t requested = pending.load(std::memory_order_acquire);;) {
+            for(std::size_t n; (n = pop(batch)) > 0;) f(std::span<event_record const>{batch.data(), n});
+            idle();
+
+            //Every push counted in `requested` is visible to the pops above. If none came in since, the drain is done,
+            //and the next push will schedule a new one
+            if(pending.compare_exchange_strong(requested, 0, std::memory_order_acq_rel, std::memory_order_acquire)) return;
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "sirius/arith/point.hpp"
+#include "sirius/arith/vector.hpp"
+#include "sirius/input/code.hpp"
+#include "sirius/input/combination.hpp"
+#include "sirius/input/event_queue.hpp"
+
+
+namespace acma::input {
+    //The input of one frame, for polling from the render thread (see window::input_state)
+    struct input_snapshot {
+        //Keys and mouse buttons held at the end of the frame
+        combination_bitset held;
+        //Pressed or released during the frame, so that a tap shorter than a frame isn't missed
+        combination_bitset pressed;
+        combination_bitset released;
+        acma::pt2d cursor;
+        //Distance covered by the cursor during the frame
+        acma::vec2<double> cursor_delta;
+        //Sum of the frame's scroll deltas (with the same sign as the scroll event's mouse_aux)
+        acma::vec2<double> scroll;
+        //Codepoints typed during the frame, in order
+        std::vector<unsigned int> text;
+
+    public:
+        bool is_held     (code_t code) const noexcept { return held[code]; }
+        bool was_pressed (code_t code) const noexcept { return pressed[code]; }
+        bool was_released(code_t code) const noexcept { return released[code]; }
+    };
+}
+
+
+namespace acma::input {
+    //Double-buffered input_snapshot. Input is accumulated into the active frame buffer while the render thread owns the snapshot;
+    //swap makes the other buffer active, waits for any write still in progress on the old one (at most one event's worth),
+    //then merges it into the snapshot. Events written during the swap land in the new buffer, so none are lost between frames,
+    //and reading the snapshot is wait-free since nothing else touches it.
+    //There may be one writer per kind of input: the window's input drain (keys, buttons, cursor and scroll) and the GLFW thread (text)
+    class input_state {
+    public:
+        input_state() noexcept : active(0), writers{} {}
+        //Only moved before any input is written (i.e. by window::create)
+        input_state(input_state&& other) noexcept;
+        input_state& operator=(input_state&& other) noexcept;
+
+    public:
+        //Must only be called by one thread (the render thread), which is then the only one allowed to read the snapshot
+        input_snapshot const& swap() noexcept;
+        constexpr input_snapshot const& snapshot() const noexcept { return front; }
+
+    public:
+        //Called by the input drain for every record, before coalescing
+        void record(event_record const& r) noexcept;
+        //Called by the GLFW thread
+        void record_text(unsigned int codepoint) noexcept;
+
+    private:
+        struct frame {
+            combination_bitset held;
+            combination_bitset pressed;
+            combination_bitset released;
+            acma::pt2d cursor;
+            acma::vec2<double> cursor_delta;
+            acma::vec2<double> scroll;
+            std::vector<unsigned int> text;
+            bool held_changed = false;
+            bool cursor_moved = false;
+        };
+
+        template<typename F>
+        void write(F&& f) noexcept;
+
+    private:
+        //Not std::hardware_destructive_interference_size, which GCC warns about using in headers
+        constexpr static std::size_t cache_line_size = 64;
+
+    private:
+        alignas(cache_line_size) std::atomic<std::uint32_t> active;
+        alignas(cache_line_size) std::array<std::atomic<std::uint32_t>, 2> writers;
+        std::array<frame, 2> frames;
+        //The drain's running state (written to the active frame whole, so the snapshot never misses a change)
+        combination_bitset held;
+        acma::pt2d last_cursor;
+        bool has_cursor = false;
+        //Only touched by the thread calling swap
+        input_snapshot front;
+    };
+}
+
+
+#include "sirius/input/input_state.inl"
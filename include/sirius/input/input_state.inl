@@ -0,0 +1,104 @@
+#pragma once
+#include "sirius/input/input_state.hpp"
+#include <thread>
+#include <utility>
+
+
+namespace acma::input {
+    inline input_state::input_state(input_state&& other) noexcept :
+        active(0), writers{}, frames(std::move(other.frames)), held(other.held),
+        last_cursor(other.last_cursor), has_cursor(other.has_cursor), front(std::move(other.front)) {}
+
+    inline input_state& input_state::operator=(input_state&& other) noexcept {
+        active.store(0, std::memory_order_relaxed);
+        for(std::atomic<std::uint32_t>& w : writers) w.store(0, std::memory_order_relaxed);
+        frames = std::move(other.frames);
+        held = other.held;
+        last_cursor = other.last_cursor;
+        has_cursor = other.has_cursor;
+        front = std::move(other.front);
+        return *this;
+    }
+}
+
+
+namespace acma::input {
+    template<typename F>
+    void input_state::write(F&& f) noexcept {
+        for(;;) {
+            const std::uint32_t idx = active.load(std::memory_order_acquire);
+            writers[idx].fetch_add(1, std::memory_order_seq_cst);
+            //Announced before checking that the buffer is still active, so a swap either sees this writer or this writer sees the swap
+            if(active.load(std::memory_order_seq_cst) == idx) {
+                f(frames[idx]);
+                writers[idx].fetch_sub(1, std::memory_order_release);
+                return;
+            }
+            writers[idx].fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    inline input_snapshot const& input_state::swap() noexcept {
+        const std::uint32_t old = active.load(std::memory_order_relaxed);
+        active.store(old ^ 1, std::memory_order_seq_cst);
+        while(writers[old].load(std::memory_order_seq_cst) != 0) std::this_thread::yield();
+
+        frame& f = frames[old];
+        if(f.held_changed) front.held = f.held;
+        if(f.cursor_moved) front.cursor = f.cursor;
+        front.pressed = f.pressed;
+        front.released = f.released;
+        front.cursor_delta = f.cursor_delta;
+        front.scroll = f.scroll;
+        //Hands the last frame's (cleared) storage back, so typing doesn't allocate every frame
+        front.text.swap(f.text);
+
+        f.text.clear();
+        f.pressed.reset();
+        f.released.reset();
+        f.cursor_delta = {};
+        f.scroll = {};
+        f.held_changed = false;
+        f.cursor_moved = false;
+        return front;
+    }
+}
+
+
+namespace acma::input {
+    inline void input_state::record(event_record const& r) noexcept {
+        switch(r.action) {
+        case input_action::end_frame:
+            return;
+        case input_action::press_release:
+            if(r.code == mouse_code::move) {
+                const acma::vec2<double> delta = has_cursor ? acma::vec2<double>{r.aux - last_cursor} : acma::vec2<double>{};
+                last_cursor = r.aux;
+                has_cursor = true;
+                write([&](frame& f) noexcept {
+                    f.cursor = r.aux;
+                    f.cursor_delta += delta;
+                    f.cursor_moved = true;
+                });
+            }
+            else if(r.code == mouse_code::scroll) write([&](frame& f) noexcept { f.scroll += r.aux; });
+            else write([&](frame& f) noexcept {
+                f.pressed.set(r.code);
+                f.released.set(r.code);
+            });
+            return;
+        default:
+            held.set(r.code, r.action == input_action::press);
+            write([&](frame& f) noexcept {
+                (r.action == input_action::press ? f.pressed : f.released).set(r.code);
+                f.held = held;
+                f.held_changed = true;
+            });
+            return;
+        }
+    }
+
+    inline void input_state::record_text(unsigned int codepoint) noexcept {
+        write([&](frame& f) noexcept { f.text.push_back(codepoint); });
+    }
+}
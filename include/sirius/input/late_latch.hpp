@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+#include "sirius/arith/point.hpp"
+#include "sirius/input/code.hpp"
+#include "sirius/input/event_queue.hpp"
+
+
+namespace acma::input {
+    //The newest pointer state, as written into GPU memory by timeline::predefined_callbacks::late_latch_input.
+    //Laid out for std430/scalar block layout (i.e. `struct { vec2 cursor; uint buttons; uint padding; }`)
+    struct late_latch_data {
+        acma::pt2f cursor;
+        //Bit i is set while mouse_code::button_1 + i is held
+        std::uint32_t buttons;
+        std::uint32_t padding;
+    };
+    static_assert(sizeof(late_latch_data) == 16 && std::is_trivially_copyable_v<late_latch_data>);
+}
+
+
+namespace acma::input {
+    //The cursor position and mouse buttons as of the last GLFW callback, ahead of the (queued and coalesced) event processing.
+    //The cursor and the buttons are separate atomics: each event is seen whole, and since they are independent events,
+    //a reader seeing one updated before the other only looks like it read a moment earlier.
+    //There is a single writer (the thread polling events) and any number of lock-free readers (i.e. the render thread)
+    class late_latch_state {
+    public:
+        late_latch_state() noexcept : cursor_bits(0), buttons(0) {}
+        //Copies a snapshot (so windows stay movable)
+        late_latch_state(late_latch_state const& other) noexcept :
+            cursor_bits(other.cursor_bits.load(std::memory_order_relaxed)), buttons(other.buttons.load(std::memory_order_relaxed)) {}
+        late_latch_state& operator=(late_latch_state const& other) noexcept {
+            cursor_bits.store(other.cursor_bits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            buttons.store(other.buttons.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+
+    public:
+        late_latch_data load() const noexcept {
+            return late_latch_data{
+                std::bit_cast<acma::pt2f>(cursor_bits.load(std::memory_order_acquire)),
+                buttons.load(std::memory_order_acquire),
+                0
+            };
+        }
+
+        //Must only be called by the single writer. Ignores anything but cursor motion and mouse buttons
+        void record(event_record const& r) noexcept {
+            if(r.code == mouse_code::move) {
+                cursor_bits.store(std::bit_cast<std::uint64_t>(static_cast<acma::pt2f>(r.aux)), std::memory_order_release);
+                return;
+            }
+            if(r.code < mouse_code::button_1 || r.code > mouse_code::button_8) return;
+            const std::uint32_t bit = std::uint32_t{1} << (r.code - mouse_code::button_1);
+            if(r.action == input_action::press) buttons.fetch_or(bit, std::memory_order_release);
+            else if(r.action == input_action::release) buttons.fetch_and(~bit, std::memory_order_release);
+        }
+
+    private:
+        std::atomic<std::uint64_t> cursor_bits;
+        std::atomic<std::uint32_t> buttons;
+    };
+}
@@ -0,0 +1,154 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+
+#ifndef SIRIUS_INPUT_LATENCY_STATS
+#define SIRIUS_INPUT_LATENCY_STATS false
+#endif
+
+namespace acma::input::impl {
+    constexpr bool latency_stats_enabled = SIRIUS_INPUT_LATENCY_STATS;
+}
+
+
+namespace acma::input {
+    struct latency_summary {
+        std::uint64_t count;
+        std::chrono::nanoseconds p50;
+        std::chrono::nanoseconds p99;
+        std::chrono::nanoseconds max;
+    };
+
+
+    //Lock-free log-linear histogram of durations: 8 buckets per power of 2 (so percentiles are within 12.5%), from 1ns up to ~18 minutes.
+    //Recording is a relaxed fetch_add, and reading takes a snapshot that may be slightly behind concurrent records
+    class latency_histogram {
+    public:
+        constexpr static std::size_t sub_bucket_bits = 3;
+        constexpr static std::size_t max_shift = 36;
+        constexpr static std::size_t bucket_count = ((max_shift + 1) << sub_bucket_bits) + (1 << sub_bucket_bits);
+
+    public:
+        latency_histogram() noexcept = default;
+        //Copies a snapshot (so windows stay movable)
+        latency_histogram(latency_histogram const& other) noexcept { *this = other; }
+        latency_histogram& operator=(latency_histogram const& other) noexcept {
+            for(std::size_t i = 0; i < bucket_count; ++i) buckets[i].store(other.buckets[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            max_ns.store(other.max_ns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+
+    public:
+        void record(std::chrono::nanoseconds duration) noexcept {
+            const std::uint64_t ns = static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(duration.count(), 0));
+            buckets[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+            for(std::uint64_t current = max_ns.load(std::memory_order_relaxed); ns > current && !max_ns.compare_exchange_weak(current, ns, std::memory_order_relaxed););
+        }
+
+        latency_summary summary() const noexcept {
+            std::array<std::uint64_t, bucket_count> snapshot;
+            std::uint64_t count = 0;
+            for(std::size_t i = 0; i < bucket_count; ++i) count += (snapshot[i] = buckets[i].load(std::memory_order_relaxed));
+            const std::uint64_t max = max_ns.load(std::memory_order_relaxed);
+            return latency_summary{count, percentile(snapshot, count, 50, max), percentile(snapshot, count, 99, max), std::chrono::nanoseconds{max}};
+        }
+
+        //Not atomic with respect to concurrent records
+        void reset() noexcept {
+            for(std::atomic<std::uint64_t>& b : buckets) b.store(0, std::memory_order_relaxed);
+            max_ns.store(0, std::memory_order_relaxed);
+        }
+
+    public:
+        constexpr static std::size_t bucket_index(std::uint64_t ns) noexcept {
+            const std::size_t shift = std::min<std::size_t>(std::max<int>(std::bit_width(ns) - static_cast<int>(sub_bucket_bits + 1), 0), max_shift);
+            return std::min<std::size_t>((shift << sub_bucket_bits) + (ns >> shift), bucket_count - 1);
+        }
+        //Smallest duration counted in the bucket
+        constexpr static std::uint64_t bucket_floor(std::size_t index) noexcept {
+            if(index < (2 << sub_bucket_bits)) return index;
+            const std::size_t shift = (index >> sub_bucket_bits) - 1;
+            return static_cast<std::uint64_t>(index - (shift << sub_bucket_bits)) << shift;
+        }
+
+    private:
+        static std::chrono::nanoseconds percentile(std::array<std::uint64_t, bucket_count> const& counts, std::uint64_t count, std::uint64_t p, std::uint64_t max) noexcept {
+            if(count == 0) return {};
+            const std::uint64_t rank = (count * p + 99) / 100;
+            std::uint64_t seen = 0;
+            for(std::size_t i = 0; i < bucket_count; ++i) {
+                if((seen += counts[i]) < rank) continue;
+                //The bucket's largest duration, which never overstates the max
+                const std::uint64_t ceiling = i + 1 < bucket_count ? bucket_floor(i + 1) - 1 : max;
+                return std::chrono::nanoseconds{std::min(ceiling, max)};
+            }
+            return std::chrono::nanoseconds{max};
+        }
+
+    private:
+        std::array<std::atomic<std::uint64_t>, bucket_count> buckets{};
+        std::atomic<std::uint64_t> max_ns{0};
+    };
+
+
+    //Where input spends its time between the GLFW callback and the event function (see window::input_latency_stats).
+    //Only collected if SIRIUS_INPUT_LATENCY_STATS is defined as true
+    struct latency_stats {
+        //From the callback to the drain task popping the event (thread pool hop included)
+        latency_histogram queueing;
+        //Updating the held inputs and finding the event's bindings
+        latency_histogram lookup;
+        //Each event function invoked
+        latency_histogram handler;
+
+    public:
+        void reset() noexcept {
+            queueing.reset();
+            lookup.reset();
+            handler.reset();
+        }
+    };
+}
+
+
+namespace acma::input::impl {
+    //Stand-ins for when the stats are compiled out, so that recording still compiles (to nothing).
+    //Distinct types so that no_latency_stats stays empty
+    template<std::size_t>
+    struct no_latency_histogram {
+        constexpr void record(std::chrono::nanoseconds) const noexcept {}
+    };
+    struct no_latency_stats {
+        [[no_unique_address]] no_latency_histogram<0> queueing;
+        [[no_unique_address]] no_latency_histogram<1> lookup;
+        [[no_unique_address]] no_latency_histogram<2> handler;
+    };
+    using latency_stats_t = std::conditional_t<latency_stats_enabled, latency_stats, no_latency_stats>;
+
+
+    //Doesn't even read the clock when the stats are compiled out
+    class latency_timer {
+    public:
+        latency_timer() noexcept : start(now()) {}
+
+    public:
+        template<typename Histogram>
+        void stop(Histogram& h) const noexcept { h.record(now() - start); }
+
+    private:
+        static std::chrono::steady_clock::time_point now() noexcept {
+            if constexpr(latency_stats_enabled) return std::chrono::steady_clock::now();
+            else return {};
+        }
+
+    private:
+        std::chrono::steady_clock::time_point start;
+    };
+}
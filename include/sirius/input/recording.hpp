@@ -0,0 +1,63 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "sirius/core/error.hpp"
+#include "sirius/input/event_queue.hpp"
+
+
+namespace acma::input {
+    enum class replay_speed : std::uint8_t {
+        //Every record is processed right away, as if they all arrived in a single drain
+        full,
+        //Records are processed at the pace they were recorded at
+        real_time,
+    };
+}
+
+
+namespace acma::input {
+    //Binary recording format (little-endian):
+    //  header: magic, format version (uint32), record count (uint32)
+    //  record: time_us delta from the previous record (LEB128, the first one is absolute), code (uint8),
+    //          action with has_aux in the high bit (uint8), then aux.x() and aux.y() (IEEE double bits) only if has_aux
+    //So a key press takes ~4 bytes and a mouse move ~20, instead of sizeof(event_record)
+    namespace recording_format {
+        constexpr std::array<char, 8> magic = {'S', 'I', 'R', 'I', 'N', 'P', 'U', 'T'};
+        constexpr std::uint32_t version = 1;
+        constexpr std::size_t header_size = magic.size() + 2 * sizeof(std::uint32_t);
+        constexpr std::uint8_t has_aux_bit = 0x80;
+    }
+
+    std::vector<std::byte> encode_recording(std::span<event_record const> records) noexcept;
+    result<std::vector<event_record>> decode_recording(std::span<std::byte const> bytes) noexcept;
+
+    result<void> save_recording(char const* path, std::span<event_record const> records) noexcept;
+    result<std::vector<event_record>> load_recording(char const* path) noexcept;
+}
+
+
+namespace acma::input {
+    //Collects the events arriving from a window's GLFW callbacks (see window::record_input).
+    //Not synchronized: only records from the thread polling events
+    class recorder {
+    public:
+        constexpr void record(event_record const& r) noexcept { recorded.push_back(r); }
+        constexpr void clear() noexcept { recorded.clear(); }
+
+        constexpr std::span<event_record const> records() const noexcept { return recorded; }
+        constexpr std::size_t size() const noexcept { return recorded.size(); }
+        constexpr bool empty() const noexcept { return recorded.empty(); }
+
+        result<void> save(char const* path) const noexcept { return save_recording(path, recorded); }
+
+    private:
+        std::vector<event_record> recorded;
+    };
+}
+
+
+#include "sirius/input/recording.inl"
@@ -0,0 +1,130 @@
+#pragma once
+#include "sirius/input/recording.hpp"
+#include <bit>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+
+namespace acma::input::impl {
+    inline void put_le(std::vector<std::byte>& out, std::uint64_t value, std::size_t size) noexcept {
+        for(std::size_t i = 0; i < size; ++i) out.push_back(static_cast<std::byte>(value >> (8 * i)));
+    }
+
+    inline void put_varint(std::vector<std::byte>& out, std::uint32_t value) noexcept {
+        for(; value >= 0x80; value >>= 7) out.push_back(static_cast<std::byte>((value & 0x7f) | 0x80));
+        out.push_back(static_cast<std::byte>(value));
+    }
+
+
+    //Reads from the front of the remaining bytes, failing (rather than reading past the end) on truncated input
+    struct recording_reader {
+        std::span<std::byte const> bytes;
+
+    public:
+        constexpr bool get_le(std::uint64_t& value, std::size_t size) noexcept {
+            if(bytes.size() < size) return false;
+            value = 0;
+            for(std::size_t i = 0; i < size; ++i) value |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+            bytes = bytes.subspan(size);
+            return true;
+        }
+
+        constexpr bool get_varint(std::uint32_t& value) noexcept {
+            value = 0;
+            for(std::size_t shift = 0; shift < 35; shift += 7) {
+                if(bytes.empty()) return false;
+                const std::uint8_t b = static_cast<std::uint8_t>(bytes.front());
+                bytes = bytes.subspan(1);
+                value |= static_cast<std::uint32_t>(b & 0x7f) << shift;
+                if(!(b & 0x80)) return true;
+            }
+            return false;
+        }
+    };
+
+
+    struct file_closer {
+        void operator()(std::FILE* f) const noexcept { std::fclose(f); }
+    };
+    using unique_file = std::unique_ptr<std::FILE, file_closer>;
+}
+
+
+namespace acma::input {
+    inline std::vector<std::byte> encode_recording(std::span<event_record const> records) noexcept {
+        std::vector<std::byte> ret;
+        ret.reserve(recording_format::header_size + records.size() * 8);
+        for(char c : recording_format::magic) ret.push_back(static_cast<std::byte>(c));
+        impl::put_le(ret, recording_format::version, sizeof(std::uint32_t));
+        impl::put_le(ret, records.size(), sizeof(std::uint32_t));
+
+        std::uint32_t previous_us = 0;
+        for(event_record const& r : records) {
+            //Unsigned wrap-around keeps the deltas small across the time_us wrap too
+            impl::put_varint(ret, r.time_us - previous_us);
+            previous_us = r.time_us;
+            ret.push_back(static_cast<std::byte>(r.code));
+            ret.push_back(static_cast<std::byte>(r.action | (r.has_aux ? recording_format::has_aux_bit : 0)));
+            if(!r.has_aux) continue;
+            impl::put_le(ret, std::bit_cast<std::uint64_t>(r.aux.x()), sizeof(std::uint64_t));
+            impl::put_le(ret, std::bit_cast<std::uint64_t>(r.aux.y()), sizeof(std::uint64_t));
+        }
+        return ret;
+    }
+
+    inline result<std::vector<event_record>> decode_recording(std::span<std::byte const> bytes) noexcept {
+        if(bytes.size() < recording_format::header_size || std::memcmp(bytes.data(), recording_format::magic.data(), recording_format::magic.size()) != 0)
+            return errc::invalid_argument;
+        impl::recording_reader reader{bytes.subspan(recording_format::magic.size())};
+        std::uint64_t version, count;
+        reader.get_le(version, sizeof(std::uint32_t));
+        reader.get_le(count, sizeof(std::uint32_t));
+        if(version != recording_format::version) return errc::operation_not_supported;
+        //Every record takes at least 3 bytes, so a bad count can't make this allocate much more than the file
+        if(count > reader.bytes.size() / 3) return errc::invalid_argument;
+
+        std::vector<event_record> ret(count);
+        std::uint32_t time_us = 0;
+        for(event_record& r : ret) {
+            std::uint32_t delta;
+            std::uint64_t code, flags;
+            if(!reader.get_varint(delta) || !reader.get_le(code, 1) || !reader.get_le(flags, 1)) return errc::invalid_argument;
+            time_us += delta;
+            r.time_us = time_us;
+            r.code = static_cast<code_t>(code);
+            r.action = static_cast<std::uint8_t>(flags & ~recording_format::has_aux_bit);
+            r.has_aux = flags & recording_format::has_aux_bit;
+            if(r.action > input_action::end_frame) return errc::invalid_argument;
+            if(!r.has_aux) continue;
+
+            std::uint64_t x, y;
+            if(!reader.get_le(x, sizeof(std::uint64_t)) || !reader.get_le(y, sizeof(std::uint64_t))) return errc::invalid_argument;
+            r.aux = acma::pt2d{std::bit_cast<double>(x), std::bit_cast<double>(y)};
+        }
+        return ret;
+    }
+
+
+    inline result<void> save_recording(char const* path, std::span<event_record const> records) noexcept {
+        const std::vector<std::byte> bytes = encode_recording(records);
+        impl::unique_file file(std::fopen(path, "wb"));
+        if(!file) return static_cast<errc>(errno);
+        if(std::fwrite(bytes.data(), 1, bytes.size(), file.get()) != bytes.size()) return errc::io_error;
+        if(std::fclose(file.release()) != 0) return errc::io_error;
+        return {};
+    }
+
+    inline result<std::vector<event_record>> load_recording(char const* path) noexcept {
+        impl::unique_file file(std::fopen(path, "rb"));
+        if(!file) return static_cast<errc>(errno);
+
+        std::vector<std::byte> bytes;
+        std::array<std::byte, 4096> chunk;
+        for(std::size_t n; (n = std::fread(chunk.data(), 1, chunk.size(), file.get())) > 0;)
+            bytes.insert(bytes.end(), chunk.begin(), chunk.begin() + n);
+        if(std::ferror(file.get())) return errc::io_error;
+        return decode_recording(bytes);
+    }
+}
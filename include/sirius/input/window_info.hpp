@@ -1,17 +1,27 @@
 #pragma once 
-#include <mutex>
+#include <atomic>
 #include <unordered_map>
+#include <vector>
 
 #include <GLFW/glfw3.h>
 
 #include "sirius/input/combination.hpp"
+#include "sirius/input/combination_state.hpp"
+#include "sirius/input/event_queue.hpp"
 
 
 namespace acma::input::impl {
     struct window_info {
-        combination current_combo;
+        combination_state current_combo;
         void* window_ptr;
-        std::mutex combo_mutex;
+        //Filled by the GLFW callbacks, drained by a thread_pool task
+        event_queue queued_input;
+        //Records that arrived while queued_input was full, in order, waiting to be moved into it. Only touched by the thread polling
+        //events, so the GLFW callbacks never have to wait for the drain to free up space
+        std::vector<event_record> overflow_input;
+        //Set by window::end_input_frame (on the render thread), and turned into an end_frame record by the thread polling events,
+        //so that the recorder and the late latch keep a single writer
+        std::atomic<bool> frame_ended = false;
     };
 }
 
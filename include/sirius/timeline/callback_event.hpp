@@ -8,6 +8,9 @@ namespace acma::timeline {
 
 		on_swap_chain_updated,
 
+		//Right before a graphics command group is submitted, after its commands are recorded
+		on_graphics_submit,
+
 		
 		num_callback_events
 	};
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstring>
+#include <type_traits>
+#include <streamline/numeric/int.hpp>
+#include <streamline/universal/get.hpp>
+
+#include "sirius/core/error.hpp"
+#include "sirius/core/memory_policy.hpp"
+#include "sirius/core/buffer_config_table.hpp"
+#include "sirius/core/asset_heap_config_table.hpp"
+#include "sirius/input/late_latch.hpp"
+
+
+namespace acma::timeline::predefined_callbacks {
+	//Writes the window's newest cursor position and mouse buttons (as an input::late_latch_data) into the buffer, 
+	//for shaders to read through its gpu_address. Meant for on_graphics_submit, which runs right before vkQueueSubmit2,
+	//so the GPU sees input that arrived after the frame's commands were recorded. The buffer should be memory_policy::shared
+	//and coupling_policy::coupled, so that a frame still in flight doesn't see the next frame's input
+	template<typename InstanceT, buffer_key_t LateLatchBufferKey, sl::uoffset_t BufferOffsetBytes = 0>
+	result<void> late_latch_input(typename InstanceT::render_process_type& proc, typename InstanceT::window_type& win, auto&) noexcept {
+		auto& buff = sl::universal::get<LateLatchBufferKey>(proc);
+		static_assert(std::remove_cvref_t<decltype(buff)>::config.memory == memory_policy::shared, "late-latched input must be written to GPU-visible memory the CPU can write to directly");
+
+		const input::late_latch_data latched = win.latest_pointer_input();
+		std::memcpy(buff.data() + BufferOffsetBytes, &latched, sizeof(input::late_latch_data));
+		return {};
+	}
+}
@@ -60,7 +60,7 @@ namespace acma::timeline {
 	template<typename RenderProcessT, sl::index_t CommandGroupIdx>
 	result<void> command<::acma::impl::submit_base<CommandFamily, signal_completion_at<CompleteStages>, wait_for<WaitStages>>>::operator()(
 		RenderProcessT& proc, 
-		window&, 
+		window& win, 
 		timeline::state& timeline_state, 
 		sl::empty_t,
 		sl::index_constant_type<CommandGroupIdx>
@@ -96,6 +96,9 @@ namespace acma::timeline {
 		
 		vk::command_buffer const& cmd_buff = proc.command_buffers()[frame_idx][CommandGroupIdx];
 		RESULT_VERIFY(cmd_buff.end());
+		//As late as possible, so that anything written here (e.g. late-latched input) is as fresh as it can be for the GPU
+		if constexpr(CommandFamily == command_family::graphics)
+			D2D_INVOKE_ALL(proc.timeline_callbacks(), on_graphics_submit, proc, win, timeline_state);
 		return cmd_buff.submit(
 			CommandFamily,
 			{wait_semaphore_infos.data(), wait_seamphore_count},
@@ -0,0 +1,77 @@
+#pragma once
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vulkan/vulkan.h>
+#include <vulkan/vulkan_core.h>
+
+#include "sirius/traits/vector_traits.hpp"
+
+namespace acma {
+    struct half;
+    template<typename T> struct unorm;
+    template<typename T> struct snorm;
+    template<std::size_t Dims, typename ComponentT> struct packed_vector;
+    struct a2b10g10r10;
+    template<typename ComponentT> struct oct_normal;
+}
+
+namespace acma::impl {
+    //The VkFormat of a packed_vector with 1, 2, 3 or 4 of these components, and the type each component unpacks to
+    template<typename ComponentT>
+    struct packed_component_traits {
+        static_assert(!std::is_same_v<ComponentT, ComponentT>, "packed_component_traits<ComponentT> specialization has not been defined for the given ComponentT!");
+    };
+
+    template<> struct packed_component_traits<half> {
+        using unpacked_type = float;
+        constexpr static std::array<VkFormat, 4> formats = {VK_FORMAT_R16_SFLOAT, VK_FORMAT_R16G16_SFLOAT, VK_FORMAT_R16G16B16_SFLOAT, VK_FORMAT_R16G16B16A16_SFLOAT};
+    };
+    template<> struct packed_component_traits<unorm<std::uint8_t>> {
+        using unpacked_type = float;
+        constexpr static std::array<VkFormat, 4> formats = {VK_FORMAT_R8_UNORM, VK_FORMAT_R8G8_UNORM, VK_FORMAT_R8G8B8_UNORM, VK_FORMAT_R8G8B8A8_UNORM};
+    };
+    template<> struct packed_component_traits<unorm<std::uint16_t>> {
+        using unpacked_type = float;
+        constexpr static std::array<VkFormat, 4> formats = {VK_FORMAT_R16_UNORM, VK_FORMAT_R16G16_UNORM, VK_FORMAT_R16G16B16_UNORM, VK_FORMAT_R16G16B16A16_UNORM};
+    };
+    template<> struct packed_component_traits<snorm<std::int8_t>> {
+        using unpacked_type = float;
+        constexpr static std::array<VkFormat, 4> formats = {VK_FORMAT_R8_SNORM, VK_FORMAT_R8G8_SNORM, VK_FORMAT_R8G8B8_SNORM, VK_FORMAT_R8G8B8A8_SNORM};
+    };
+    template<> struct packed_component_traits<snorm<std::int16_t>> {
+        using unpacked_type = float;
+        constexpr static std::array<VkFormat, 4> formats = {VK_FORMAT_R16_SNORM, VK_FORMAT_R16G16_SNORM, VK_FORMAT_R16G16B16_SNORM, VK_FORMAT_R16G16B16A16_SNORM};
+    };
+
+    //Left empty (rather than static_asserting) so that packed_type can be used as a constraint
+    template<typename PackedT>
+    struct packed_traits {};
+
+    template<std::size_t Dims, typename ComponentT>
+    struct packed_traits<packed_vector<Dims, ComponentT>> {
+        using unpacked_type = vector<Dims, typename packed_component_traits<ComponentT>::unpacked_type, vec_data_type::point, 0>;
+        constexpr static VkFormat format = packed_component_traits<ComponentT>::formats[Dims - 1];
+    };
+
+    template<>
+    struct packed_traits<a2b10g10r10> {
+        using unpacked_type = vector<4, float, vec_data_type::point, 0>;
+        constexpr static VkFormat format = VK_FORMAT_A2B10G10R10_UNORM_PACK32;
+    };
+
+    template<typename ComponentT>
+    struct packed_traits<oct_normal<ComponentT>> {
+        using unpacked_type = vector<3, float, vec_data_type::point, 0>;
+        constexpr static VkFormat format = packed_component_traits<ComponentT>::formats[1];
+    };
+
+
+    template<typename T>
+    concept packed_type = requires {
+        typename packed_traits<T>::unpacked_type;
+        { packed_traits<T>::format } -> std::convertible_to<VkFormat>;
+    };
+}
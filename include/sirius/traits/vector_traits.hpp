@@ -52,8 +52,13 @@ namespace acma::impl {
     struct is_vector_specialization : std::false_type {};
     template<std::size_t Dims, typename UnitTy, vec_data_type HoldsData, std::uint8_t TransformFlags>
     struct is_vector_specialization<vector<Dims, UnitTy, HoldsData, TransformFlags>> : std::true_type{};
+    //Base of every lazily evaluated expression (see arith/expression.hpp)
+    struct expression_base {};
     template<typename T>
-    concept non_vector = !is_vector_specialization<T>::value;
+    concept lazy_expression = std::is_base_of_v<expression_base, std::remove_cvref_t<T>>;
+
+    template<typename T>
+    concept non_vector = !is_vector_specialization<T>::value && !lazy_expression<T>;
 }
 
 namespace acma::impl {
@@ -49,6 +49,9 @@ namespace acma::vk {
         template<> typename device_query_traits<device_query::display_formats    >::return_type query<device_query::display_formats    >(surface const& s) const noexcept;
         template<> typename device_query_traits<device_query::present_modes      >::return_type query<device_query::present_modes      >(surface const& s) const noexcept;
 
+		//Whether compute shaders can write to optimally tiled images of the format (e.g. to generate glyphs with shaders/generate_glyphs.comp)
+		bool supports_storage_image(VkFormat format) const noexcept;
+
         
     public:
         std::string_view name;
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <span>
 #include <vulkan/vulkan.h>
 
+#include "sirius/arith/rect.hpp"
 #include "sirius/core/asset_heap_config.hpp"
 #include "sirius/vulkan/core/vulkan_ptr.hpp"
 #include "sirius/vulkan/device/logical_device.hpp"
@@ -51,6 +53,9 @@ namespace acma::vk {
 
 	public:
 		constexpr sl::size_t total_size() const noexcept { return _images.size() + _sampler_infos.size(); }
+		constexpr sl::size_t image_count() const& noexcept { return _images[allocation_index()].size(); }
+		//The number of images made from textures of the given usage, i.e. the index in its descriptor array of the next one emplaced
+		constexpr sl::size_t image_count(texture_usage usage) const& noexcept;
 		//constexpr sl::size_t capacity() const noexcept { return allocated_bytes; }
 
 	public:
@@ -85,6 +90,30 @@ namespace acma::vk {
 		constexpr result<void> try_emplace_back(buffer_segment<J, N, BufferConfigs> const& texture_data_buffer) noexcept
 		requires((buffer_segment<J, N, BufferConfigs>::config.usage & buffer_usage_policy::texture_data) == buffer_usage_policy::texture_data);
 
+	public:
+		//Copies only the given regions (in pixels) of the texture_idx'th texture in texture_data_buffer into the image_idx'th image,
+		//which must have been made from that texture by emplace_back. The rest of the image is kept as is. Only for single mip level textures,
+		//and every region has to fit in both. Waits for the timeline commands submitted so far, which may still be sampling the image
+	 	template<sl::index_t J, sl::size_t N, auto BufferConfigs>
+		result<void> update(
+			buffer_segment<J, N, BufferConfigs> const& texture_data_buffer,
+			sl::index_t texture_idx,
+			sl::index_t image_idx,
+			std::span<const rect<sl::uint32_t>> regions,
+			sl::uint64_t timeout = std::numeric_limits<sl::uint64_t>::max()
+		) noexcept
+		requires((buffer_segment<J, N, BufferConfigs>::config.usage & buffer_usage_policy::texture_data) == buffer_usage_policy::texture_data);
+
+		//Copies the first mip level of the image_idx'th image (with its rows, then its layers, tightly packed) into dst, which is resized to
+		//fit it. Waits for the timeline commands submitted so far, which may still be writing to the image, and for the copy itself
+	 	template<sl::index_t J, sl::size_t N, auto BufferConfigs>
+		result<void> download(
+			buffer_segment<J, N, BufferConfigs>& dst,
+			sl::index_t image_idx,
+			sl::uint64_t timeout = std::numeric_limits<sl::uint64_t>::max()
+		) noexcept
+		requires(memory_policy::is_cpu_visible(buffer_segment<J, N, BufferConfigs>::config.memory));
+
 	public:
 		constexpr result<void> reserve(sl::size_t image_capacity_bytes) noexcept;
 		constexpr result<void> reserve(sl::array<asset_usage_policy::num_usage_policies, sl::uint32_t> asset_counts) noexcept;
@@ -124,6 +153,9 @@ namespace acma::vk {
 			sl::uint64_t timeout = std::numeric_limits<sl::uint64_t>::max()
 		) noexcept;
 
+		//Waits on every timeline command submitted so far (by any frame in flight), for dedicated copies of images they may be using
+		static auto timeline_wait_infos(RenderProcessT const& proc) noexcept;
+
 	protected:
 		template<sl::index_t J>
 		result<void> realloc(sl::index_constant_type<J>, sl::uint64_t timeout = std::numeric_limits<sl::uint64_t>::max()) noexcept
@@ -1,6 +1,8 @@
 #pragma once
 #include "sirius/vulkan/memory/asset_heap_allocation.hpp"
 
+#include <algorithm>
+#include <array>
 #include <streamline/algorithm/aligned_to.hpp>
 #include <streamline/functional/functor/forward_construct.hpp>
 
@@ -266,6 +268,16 @@ namespace acma::vk {
 }
 
 
+namespace acma::vk {
+	template<sl::index_t I, asset_heap_config Config, typename RenderProcessT>
+	constexpr sl::size_t   asset_heap_allocation<I, Config, RenderProcessT>::
+	image_count(texture_usage usage) const& noexcept {
+		const asset_usage_policy_t usage_policy = asset_usage_policy::sampled_image + static_cast<asset_usage_policy_t>(usage);
+		return static_cast<sl::size_t>(std::ranges::count(_image_usages[allocation_index()], usage_policy));
+	}
+}
+
+
 namespace acma::vk {
 	template<sl::index_t I, asset_heap_config Config, typename RenderProcessT>
 	constexpr result<void>    asset_heap_allocation<I, Config, RenderProcessT>::
@@ -474,6 +486,24 @@ namespace acma::vk {
 	}
 
 
+	template<sl::index_t I, asset_heap_config Config, typename RenderProcessT>
+	auto   asset_heap_allocation<I, Config, RenderProcessT>::
+	timeline_wait_infos(RenderProcessT const& proc) noexcept {
+		constexpr sl::size_t timeline_group_count = RenderProcessT::command_buffer_count - timeline::impl::dedicated_command_group::num_dedicated_command_groups;
+		std::array<vk::semaphore_submit_info, RenderProcessT::frames_in_flight * timeline_group_count> ret;
+		for(sl::index_t i = 0; i < RenderProcessT::frames_in_flight; ++i)
+			for(sl::index_t j = 0; j < timeline_group_count; ++j) {
+				const sl::index_t group_idx = timeline::impl::dedicated_command_group::num_dedicated_command_groups + j;
+				ret[i * timeline_group_count + j] = {
+					proc.command_buffer_semaphores()[i][group_idx],
+					render_stage::group::all_transfer,
+					proc.command_buffer_semaphore_values()[i][group_idx],
+				};
+			}
+		return ret;
+	}
+
+
 	template<sl::index_t I, asset_heap_config Config, typename RenderProcessT>
 	template<sl::index_t J, sl::size_t N, auto BufferIs>
 	result<void>   asset_heap_allocation<I, Config, RenderProcessT>::
@@ -492,6 +522,8 @@ namespace acma::vk {
 		std::vector<texture_data_info> const& texture_data_infos = texture_data_buffer.texture_data_infos;
 		for(sl::index_t i = 0; i < texture_data_infos.size(); ++i) {
 			if(texture_data_infos[i].size == 0) continue;
+			//Storage images are left in the general layout, so that compute shaders can write to them afterwards
+			const VkImageLayout final_layout = texture_data_infos[i].usage == texture_usage::storage ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL;
 			
 
 			//VkBufferMemoryBarrier2 pre_copy_buffer_barrier{
@@ -558,7 +590,7 @@ namespace acma::vk {
 					.dstStageMask = VK_PIPELINE_STAGE_2_NONE,
 					.dstAccessMask = VK_ACCESS_2_NONE,
 				    .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-				    .newLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL,
+				    .newLayout = final_layout,
 				    .image = _images[alloc_idx][image_start_idx + i],
 				    .subresourceRange = {
 				        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
@@ -571,11 +603,217 @@ namespace acma::vk {
 			}};
 			transfer_command_buffer.pipeline_barrier({}, {}, post_copy_barriers);
 
-			_images[alloc_idx][image_start_idx + i].current_layout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL;
+			_images[alloc_idx][image_start_idx + i].current_layout = final_layout;
 		}
 		
 		return proc.end_dedicated_copy(post_copy_wait_value, timeline::impl::dedicated_command_group::image_data_upload, timeout);
 	}
+
+
+	template<sl::index_t I, asset_heap_config Config, typename RenderProcessT>
+	template<sl::index_t J, sl::size_t N, auto BufferIs>
+	result<void>   asset_heap_allocation<I, Config, RenderProcessT>::
+ 	update(
+		buffer_segment<J, N, BufferIs> const& texture_data_buffer,
+		sl::index_t texture_idx,
+		sl::index_t image_idx,
+		std::span<const rect<sl::uint32_t>> regions,
+		sl::uint64_t timeout
+	) noexcept 
+	requires((buffer_segment<J, N, BufferIs>::config.usage & buffer_usage_policy::texture_data) == buffer_usage_policy::texture_data) {
+		if(regions.empty()) return {};
+
+		const sl::index_t alloc_idx = allocation_index();
+		if(texture_idx >= texture_data_buffer.texture_data_infos.size() || image_idx >= _images[alloc_idx].size())
+			return errc::element_not_found;
+		texture_data_info const& info = texture_data_buffer.texture_data_infos[texture_idx];
+		if(info.mip_level_count != 1)
+			return errc::invalid_argument;
+		image& img = _images[alloc_idx][image_idx];
+		//Each region has to lie within both the texture (so the copy doesn't read past it) and the image
+		const sl::uint32_t max_width = std::min(info.extent.width(), img.size().width), max_height = std::min(info.extent.height(), img.size().height);
+		for(rect<sl::uint32_t> const& region : regions)
+			if(region.x() > max_width || region.width() > max_width - region.x() || region.y() > max_height || region.height() > max_height - region.y())
+				return errc::invalid_argument;
+		const VkImageLayout final_layout = _image_usages[alloc_idx][image_idx] == asset_usage_policy::storage_image ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL;
+
+		RenderProcessT& proc = static_cast<RenderProcessT&>(*this);
+		const sl::index_t frame_idx = proc.frame_index();
+		auto const& transfer_command_buffer = proc.command_buffers()[frame_idx][timeline::impl::dedicated_command_group::image_data_upload];
+
+		//The image may still be sampled by any frame in flight
+		const auto wait_infos = timeline_wait_infos(proc);
+
+		RESULT_TRY_COPY_UNSCOPED(const sl::uint64_t post_copy_wait_value, proc.begin_dedicated_copy(timeline::impl::dedicated_command_group::image_data_upload, timeout), pcwv_result);
+
+		const VkImageSubresourceRange mip_range{
+		    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+		    .baseMipLevel = 0,
+		    .levelCount = 1,
+		    .baseArrayLayer = 0,
+		    .layerCount = img.layer_count(),
+		};
+		//Transitioning from the current layout (instead of undefined) keeps the image's contents outside of the regions.
+		//Starting after the transfer stages chains it to the wait on the timeline, so it can't overtake the reads (a write-after-read
+		//hazard, so no access has to be made available)
+		VkImageMemoryBarrier2 pre_copy_image_barrier{
+		    .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+			.srcStageMask = VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT,
+			.srcAccessMask = VK_ACCESS_2_NONE,
+			.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+			.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+		    .oldLayout = img.layout(),
+		    .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		    .image = img,
+		    .subresourceRange = mip_range,
+		};
+		transfer_command_buffer.pipeline_barrier({}, {}, {&pre_copy_image_barrier, 1});
+
+		//The texture's rows are tightly packed, so each region starts at its first texel and keeps the texture's row length
+		const sl::size_t texel_bytes = info.size / (static_cast<sl::size_t>(info.extent.width()) * info.extent.height() * info.extent.depth());
+		std::unique_ptr<VkBufferImageCopy[]> copy_regions = std::make_unique_for_overwrite<VkBufferImageCopy[]>(regions.size());
+		for(sl::index_t i = 0; i < regions.size(); ++i) {
+			new (&copy_regions[i]) VkBufferImageCopy{
+				info.offset + (static_cast<sl::size_t>(regions[i].y()) * info.extent.width() + regions[i].x()) * texel_bytes,
+				info.extent.width(), info.extent.height(),
+				VkImageSubresourceLayers{
+				    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+				    .mipLevel = 0,
+				    .baseArrayLayer = 0,
+				    .layerCount = img.layer_count(),
+				},
+				VkOffset3D{static_cast<sl::int32_t>(regions[i].x()), static_cast<sl::int32_t>(regions[i].y()), 0},
+				VkExtent3D{
+					.width = regions[i].width(),
+					.height = regions[i].height(),
+					.depth = 1
+				}
+			};
+		}
+
+		vkCmdCopyBufferToImage(transfer_command_buffer, 
+			static_cast<VkBuffer>(texture_data_buffer),
+			img, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			static_cast<sl::uint32_t>(regions.size()), copy_regions.get()
+		);
+
+		sl::array<1, VkImageMemoryBarrier2> post_copy_barriers{{
+			VkImageMemoryBarrier2{
+			    .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+				.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+				.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+				.dstStageMask = VK_PIPELINE_STAGE_2_NONE,
+				.dstAccessMask = VK_ACCESS_2_NONE,
+			    .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			    .newLayout = final_layout,
+			    .image = img,
+			    .subresourceRange = mip_range,
+			},
+		}};
+		transfer_command_buffer.pipeline_barrier({}, {}, post_copy_barriers);
+
+		img.current_layout = final_layout;
+		
+		return proc.end_dedicated_copy(post_copy_wait_value, timeline::impl::dedicated_command_group::image_data_upload, timeout, wait_infos);
+	}
+
+
+	template<sl::index_t I, asset_heap_config Config, typename RenderProcessT>
+	template<sl::index_t J, sl::size_t N, auto BufferIs>
+	result<void>   asset_heap_allocation<I, Config, RenderProcessT>::
+ 	download(
+		buffer_segment<J, N, BufferIs>& dst,
+		sl::index_t image_idx,
+		sl::uint64_t timeout
+	) noexcept 
+	requires(memory_policy::is_cpu_visible(buffer_segment<J, N, BufferIs>::config.memory)) {
+		const sl::index_t alloc_idx = allocation_index();
+		if(image_idx >= _images[alloc_idx].size())
+			return errc::element_not_found;
+		image& img = _images[alloc_idx][image_idx];
+		const VkExtent3D extent = img.size();
+		//Only uncompressed formats, whose texels can be counted
+		const auto format_it = vk::pixel_formats.find(img.format_id());
+		if(format_it == vk::pixel_formats.end() || format_it->second.compression != pixel_format_info::none)
+			return errc::invalid_argument;
+		const sl::size_t texel_bytes = format_it->second.total_size_bytes;
+		RESULT_VERIFY(dst.resize(texel_bytes * extent.width * extent.height * extent.depth * img.layer_count()));
+
+		RenderProcessT& proc = static_cast<RenderProcessT&>(*this);
+		const sl::index_t frame_idx = proc.frame_index();
+		auto const& transfer_command_buffer = proc.command_buffers()[frame_idx][timeline::impl::dedicated_command_group::image_data_upload];
+
+		//The image may still be written to by any frame in flight
+		const auto wait_infos = timeline_wait_infos(proc);
+
+		RESULT_TRY_COPY_UNSCOPED(const sl::uint64_t post_copy_wait_value, proc.begin_dedicated_copy(timeline::impl::dedicated_command_group::image_data_upload, timeout), pcwv_result);
+
+		const VkImageSubresourceRange mip_range{
+		    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+		    .baseMipLevel = 0,
+		    .levelCount = 1,
+		    .baseArrayLayer = 0,
+		    .layerCount = img.layer_count(),
+		};
+		//The waits on the timeline make its writes available, and starting after the transfer stages chains this barrier to them
+		VkImageMemoryBarrier2 pre_copy_image_barrier{
+		    .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+			.srcStageMask = VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT,
+			.srcAccessMask = VK_ACCESS_2_NONE,
+			.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+			.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT,
+		    .oldLayout = img.layout(),
+		    .newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		    .image = img,
+		    .subresourceRange = mip_range,
+		};
+		transfer_command_buffer.pipeline_barrier({}, {}, {&pre_copy_image_barrier, 1});
+
+		const VkBufferImageCopy copy_region{
+			0,
+			0, 0,
+			VkImageSubresourceLayers{
+			    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+			    .mipLevel = 0,
+			    .baseArrayLayer = 0,
+			    .layerCount = img.layer_count(),
+			},
+			VkOffset3D{},
+			extent
+		};
+		vkCmdCopyImageToBuffer(transfer_command_buffer, 
+			img, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			static_cast<VkBuffer>(dst),
+			1, &copy_region
+		);
+
+		//The image goes back to the layout the rest of the heap expects, and the copy's writes are made visible to the host
+		const sl::array<1, VkMemoryBarrier2> post_copy_memory_barriers{{
+			VkMemoryBarrier2{
+			    .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+				.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+				.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+				.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT,
+				.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT,
+			},
+		}};
+		const sl::array<1, VkImageMemoryBarrier2> post_copy_image_barriers{{
+			VkImageMemoryBarrier2{
+			    .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+				.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+				.srcAccessMask = VK_ACCESS_2_NONE,
+				.dstStageMask = VK_PIPELINE_STAGE_2_NONE,
+				.dstAccessMask = VK_ACCESS_2_NONE,
+			    .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			    .newLayout = img.layout(),
+			    .image = img,
+			    .subresourceRange = mip_range,
+			},
+		}};
+		transfer_command_buffer.pipeline_barrier(post_copy_memory_barriers, {}, post_copy_image_barriers);
+
+		return proc.end_dedicated_copy(post_copy_wait_value, timeline::impl::dedicated_command_group::image_data_upload, timeout, wait_infos);
+	}
 }
 
 namespace acma::vk {
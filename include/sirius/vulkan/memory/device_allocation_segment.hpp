@@ -218,6 +218,10 @@ namespace acma::vk {
 
 		constexpr result<void> try_push_back(texture_view t) noexcept;
 
+	public:
+		//Where each pushed texture's data is in the segment
+		constexpr std::span<const texture_data_info> textures() const noexcept { return texture_data_infos; }
+
 	private:
 		template<sl::index_t, asset_heap_config, typename>
 		friend class asset_heap_allocation;
@@ -0,0 +1,33 @@
+//Unpack helpers matching the types in sirius/arith/packed.hpp, for data read from buffers
+//(vertex attributes in one of the packed formats are unpacked by the fixed function hardware instead).
+//Include-only: this file is not compiled on its own
+
+#ifndef SIRIUS_PACKING_GLSL
+#define SIRIUS_PACKING_GLSL
+
+//half2/half4 (a half4 spans two uints)
+vec2 unpack_half2(uint v) { return unpackHalf2x16(v); }
+vec4 unpack_half4(uvec2 v) { return vec4(unpackHalf2x16(v.x), unpackHalf2x16(v.y)); }
+
+//unorm8x4/snorm8x4 and unorm16x2/snorm16x2
+vec4 unpack_unorm8x4(uint v) { return unpackUnorm4x8(v); }
+vec4 unpack_snorm8x4(uint v) { return unpackSnorm4x8(v); }
+vec2 unpack_unorm16x2(uint v) { return unpackUnorm2x16(v); }
+vec2 unpack_snorm16x2(uint v) { return unpackSnorm2x16(v); }
+
+//a2b10g10r10 (x in the bottom 10 bits, w in the top 2)
+vec4 unpack_a2b10g10r10(uint v) {
+	return vec4(uvec4(v, v >> 10, v >> 20, v >> 30) & uvec4(0x3ffu, 0x3ffu, 0x3ffu, 0x3u)) / vec4(1023.0, 1023.0, 1023.0, 3.0);
+}
+
+//oct_normal: e is the unfolded octahedron in [-1, 1]^2 (i.e. after one of the snorm unpacks above)
+vec3 unpack_oct_normal(vec2 e) {
+	vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	const float t = max(-n.z, 0.0);
+	n.xy += mix(vec2(-t), vec2(t), lessThan(n.xy, vec2(0.0)));
+	return normalize(n);
+}
+vec3 unpack_oct_normal8(uint v) { return unpack_oct_normal(unpackSnorm4x8(v).xy); }
+vec3 unpack_oct_normal16(uint v) { return unpack_oct_normal(unpackSnorm2x16(v)); }
+
+#endif
@@ -2,11 +2,12 @@
 
 layout(location = 0) in vec2 uv_in;
 layout(location = 1) in float blue_in;
+layout(location = 2) flat in vec4 tint_in;
 
 layout(location = 0) out vec4 color_out;
 
 
 
 void main() {
-    color_out = vec4(uv_in, blue_in, 1.0);
+    color_out = vec4(uv_in, blue_in, 1.0) * tint_in;
 }
\ No newline at end of file
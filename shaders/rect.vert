@@ -1,5 +1,8 @@
 #version 460
 #extension GL_EXT_buffer_reference : require
+#extension GL_GOOGLE_include_directive : require
+
+#include "packing.glsl"
 
 
 
@@ -11,10 +14,12 @@ layout(buffer_reference, std430) readonly buffer PositionsBuffer{
 layout(std430, push_constant) uniform PushConstants {
 	uvec2 swap_extent;
     PositionsBuffer buff;
+	uint rect_tint; //unorm8x4
 } push_constants;
 
 layout(location = 0) out vec2 uv_out;
 layout(location = 1) out float blue_out;
+layout(location = 2) flat out vec4 tint_out;
 
 
 void main() {
@@ -29,6 +34,7 @@ void main() {
     gl_Position = vec4(((pos * 2)/push_constants.swap_extent) - 1, 0.0, 1.0);
 	uv_out = uv_base;
 	blue_out = i/(16.0 * 16.0);
+	tint_out = unpack_unorm8x4(push_constants.rect_tint);
     //color_out = color_in/255.0;
 
     //background_texture_idx_out = background_texture_idx_in;
@@ -0,0 +1,180 @@
+#include "sirius/core/font.hpp"
+
+#include <cstring>
+#include <utility>
+
+
+namespace acma {
+	result<font> font::create(llfio::mapped_file_handle const& handle, std::uint32_t atlas_length_pixels) noexcept {
+		font ret{};
+		std::span<const std::byte> font_file_bytes(reinterpret_cast<std::byte const*>(handle.address()), handle.maximum_extent().assume_value());
+		ret.blob_ptr = hb_blob_ptr(hb_blob_create(reinterpret_cast<char const*>(font_file_bytes.data()), font_file_bytes.size(), HB_MEMORY_MODE_DUPLICATE, nullptr, nullptr));
+		ret.face_ptr = hb_face_ptr(hb_face_create(ret.blob_ptr.get(), 0));
+		ret.font_ptr = hb_font_ptr(hb_font_create(ret.face_ptr.get()));
+		//Shared (read-only) by every worker generating glyphs
+		hb_font_make_immutable(ret.font_ptr.get());
+
+		const unsigned int glyph_count = hb_face_get_glyph_count(ret.face_ptr.get());
+		if(glyph_count == 0) return errc::invalid_font_file_format;
+		ret.em_scale = 1./hb_face_get_upem(ret.face_ptr.get());
+		ret.glyph_slots.assign(glyph_count, not_requested);
+
+		ret.atlas_length = atlas_length_pixels;
+		ret.atlas_bytes.resize(static_cast<std::size_t>(atlas_length_pixels) * atlas_length_pixels * decoder::font_texture::channels);
+		ret.atlas_pack = atlas_packer(sz2u32{atlas_length_pixels, atlas_length_pixels});
+		return ret;
+	}
+}
+
+
+namespace acma {
+	result<void> font::use_cache(llfio::path_view directory) noexcept {
+		unsigned int length = 0;
+		const char* const data = hb_blob_get_data(blob_ptr.get(), &length);
+		std::span<const std::byte> font_file_bytes(reinterpret_cast<std::byte const*>(data), length);
+		RESULT_TRY_MOVE_UNSCOPED(glyph_cache c, glyph_cache::create(directory, font_file_bytes, static_cast<std::uint32_t>(glyph_slots.size())), cc);
+		cache.emplace(std::move(c));
+		return {};
+	}
+
+	bool font::use_gpu(vk::physical_device const& device) noexcept {
+		//The atlas' usage can't change once it's in an asset heap
+		if(!uploaded)
+			gpu_generation = device.supports_storage_image(VK_FORMAT_R8G8B8A8_UNORM);
+		return gpu_generation;
+	}
+}
+
+
+namespace acma {
+	std::uint32_t font::glyph_id(char32_t codepoint) const noexcept {
+		hb_codepoint_t id = 0;
+		if(!hb_font_get_nominal_glyph(font_ptr.get(), codepoint, &id)) return 0;
+		return id;
+	}
+
+	font_glyph const* font::find(std::uint32_t glyph_id) noexcept {
+		if(glyph_id >= glyph_slots.size()) [[unlikely]] return nullptr;
+
+		std::uint32_t& slot = glyph_slots[glyph_id];
+		if(slot == not_requested) {
+			slot = requested;
+			pending.push_back(glyph_id);
+		}
+		return slot < glyphs.size() ? &glyphs[slot] : nullptr;
+	}
+}
+
+
+namespace acma {
+	result<void> font::generate_pending() noexcept {
+		//Each batch is only dispatched once
+		gpu_edges.clear();
+		if(pending.empty()) return {};
+		namespace font_texture = decoder::font_texture;
+
+		generated.resize(pending.size());
+		extents.resize(pending.size());
+		//The atlas has to be in an asset heap for the shader to write to it, so until the first upload glyphs are generated on the CPU
+		const bool on_gpu = gpu_generation && uploaded;
+
+		//Cached glyphs are moved behind the ones that still need generating
+		std::size_t miss_count = pending.size();
+		if(cache) {
+			for(std::size_t i = 0; i < miss_count;) {
+				const std::size_t back = miss_count - 1;
+				if(!cache->load(pending[i], generated[back], extents[back])) {
+					++i;
+					continue;
+				}
+				std::swap(pending[i], pending[back]);
+				--miss_count;
+			}
+		}
+
+		if(miss_count != 0) {
+			const std::span<const unsigned int> misses = std::span<const unsigned int>(pending).first(miss_count);
+			//Where each glyph goes in the atlas is only known once it's packed below
+			if(on_gpu) gpu_targets.assign(miss_count, decoder::glyph_target{atlas_descriptor_idx, {}});
+			result<void> r = on_gpu ?
+				decoder::flatten_glyphs(font_ptr.get(), misses, gpu_targets, gpu_edges, std::span(extents).first(miss_count)) :
+				decoder::generate_glyphs(font_ptr.get(), misses, std::span(generated).first(miss_count), std::span(extents).first(miss_count));
+			if(!r.has_value()) [[unlikely]] {
+				for(unsigned int id : pending) glyph_slots[id] = not_requested;
+				pending.clear();
+				gpu_edges.clear();
+				return r;
+			}
+			if(cache && !on_gpu)
+				for(std::size_t i = 0; i < miss_count; ++i)
+					cache->store(misses[i], generated[i], extents[i]);
+		}
+
+		bool atlas_full = false;
+		for(std::size_t i = 0; i < pending.size(); ++i) {
+			const unsigned int id = pending[i];
+			const decoder::glyph_extent extent = extents[i];
+			font_glyph glyph{
+				.atlas_rect = {},
+				.origin = extent.origin,
+				.size = {
+					static_cast<float>(extent.size.width()) / font_texture::glyph_scale,
+					static_cast<float>(extent.size.height()) / font_texture::glyph_scale,
+				},
+				.advance = static_cast<float>(hb_font_get_glyph_h_advance(font_ptr.get(), id) * em_scale),
+			};
+
+			//Misses come first, and are left for the shader on the GPU
+			const bool gpu_glyph = on_gpu && i < miss_count;
+			if(extent.size.width() != 0 && extent.size.height() != 0) {
+				const std::optional<pt2u32> pos = atlas_pack.insert(sz2u32{extent.size.width() + atlas_gutter_pixels, extent.size.height() + atlas_gutter_pixels});
+				if(!pos) {
+					if(gpu_glyph) gpu_edges.set_target(i, {}, {});
+					//Packed rects are never freed, so it won't fit next frame either
+					glyph_slots[id] = no_space;
+					atlas_full = true;
+					continue;
+				}
+				glyph.atlas_rect = rect<std::uint32_t>{*pos, extent.size};
+
+				if(gpu_glyph) gpu_edges.set_target(i, *pos, extent.size);
+				else {
+					//The glyph covers the bottom-left corner of its font_texture
+					constexpr std::size_t channels = font_texture::channels;
+					const std::size_t first_row = font_texture::length_pixels - extent.size.height();
+					for(std::uint32_t row = 0; row < extent.size.height(); ++row)
+						std::memcpy(
+							atlas_bytes.data() + ((static_cast<std::size_t>(pos->y()) + row) * atlas_length + pos->x()) * channels,
+							generated[i].data() + (first_row + row) * font_texture::length_pixels * channels,
+							extent.size.width() * channels
+						);
+					dirty.push_back(glyph.atlas_rect);
+				}
+			}
+
+			glyph_slots[id] = static_cast<std::uint32_t>(glyphs.size());
+			glyphs.push_back(glyph);
+		}
+		pending.clear();
+
+		if(atlas_full) return errc::atlas_full;
+		return {};
+	}
+
+	texture_view font::atlas() const noexcept {
+		return texture_view{
+			texture_info{
+				.dimensions = 2,
+				.format_id = VK_FORMAT_R8G8B8A8_UNORM,
+				.extent = {atlas_length, atlas_length, 1},
+				.mip_level_count = 1,
+				.layer_count = 1,
+				.sample_count = VK_SAMPLE_COUNT_1_BIT,
+				.tiling = VK_IMAGE_TILING_OPTIMAL,
+				.usage = gpu_generation ? texture_usage::storage : texture_usage::sampled,
+				.mip_offsets = {},
+			},
+			{atlas_bytes.data(), atlas_bytes.size()}
+		};
+	}
+}
@@ -0,0 +1,209 @@
+#include "sirius/core/glyph_cache.hpp"
+
+#include <atomic>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+
+#include "sirius/core/hash.hpp"
+
+
+namespace acma::impl {
+	struct glyph_cache_header {
+		std::uint64_t magic;
+		std::uint32_t version;
+		std::uint32_t page_size;
+		std::uint64_t params_hash;
+		std::uint64_t font_hash;
+		std::uint64_t font_size;
+		std::uint32_t glyph_count;
+		std::uint32_t glyph_bytes;
+		std::uint64_t entries_offset;
+		std::uint64_t glyphs_offset;
+		std::uint64_t glyph_stride;
+		std::uint64_t file_size;
+		//Of everything above
+		std::uint64_t checksum;
+	};
+
+	struct glyph_cache_entry {
+		std::uint32_t state;
+		std::uint32_t glyph_id;
+		std::uint32_t width;
+		std::uint32_t height;
+		float origin_x;
+		float origin_y;
+		//Of the glyph's bitmap and every field above but state
+		std::uint64_t checksum;
+	};
+	static_assert(sizeof(glyph_cache_entry) == 32 && alignof(glyph_cache_entry) <= 32);
+
+	//"SIRMSDF" plus the format's endianness, so a file from a machine with the other one doesn't match
+	constexpr std::uint64_t glyph_cache_magic = 0x0046'4453'4d52'4953ull;
+
+	//An entry's state is a sequence number, odd while the entry is being rewritten. 0 (what a new, zero-filled file reads as)
+	//is never published
+	constexpr bool entry_published(std::uint32_t state) noexcept { return state != 0 && state % 2 == 0; }
+
+
+	//Everything the generated glyphs depend on besides the font
+	std::uint64_t glyph_params_hash() noexcept {
+		namespace font_texture = decoder::font_texture;
+		const std::array<std::uint64_t, 7> params{
+			glyph_cache::format_version,
+			font_texture::length_pixels,
+			font_texture::channels,
+			font_texture::size_bytes,
+			font_texture::glyph_scale,
+			std::bit_cast<std::uint64_t>(font_texture::padding_em),
+			std::bit_cast<std::uint64_t>(font_texture::distance_range),
+		};
+		return hash_object(params);
+	}
+
+	std::uint64_t entry_checksum(glyph_cache_entry const& entry, std::span<const std::byte> glyph) noexcept {
+		glyph_cache_entry key = entry;
+		key.state = 0;
+		key.checksum = 0;
+		return hash_bytes(glyph, hash_object(key));
+	}
+}
+
+
+namespace acma {
+	result<glyph_cache> glyph_cache::create(llfio::path_view directory, std::span<const std::byte> font_file_bytes, std::uint32_t glyph_count) noexcept {
+		auto dir = llfio::path(directory);
+		if(dir.has_error())
+			return static_cast<errc>(dir.assume_error().value());
+
+		const std::uint64_t page_size = llfio::utils::page_size();
+		auto page_align = [page_size](std::uint64_t n) noexcept { return (n + page_size - 1) / page_size * page_size; };
+		impl::glyph_cache_header header{
+			.magic = impl::glyph_cache_magic,
+			.version = format_version,
+			.page_size = static_cast<std::uint32_t>(page_size),
+			.params_hash = impl::glyph_params_hash(),
+			.font_hash = impl::hash_bytes(font_file_bytes),
+			.font_size = font_file_bytes.size(),
+			.glyph_count = glyph_count,
+			.glyph_bytes = decoder::font_texture::size_bytes,
+			.entries_offset = page_align(sizeof(impl::glyph_cache_header)),
+			.glyphs_offset = 0,
+			.glyph_stride = page_align(decoder::font_texture::size_bytes),
+			.file_size = 0,
+			.checksum = 0,
+		};
+		header.glyphs_offset = header.entries_offset + page_align(std::uint64_t{glyph_count} * sizeof(impl::glyph_cache_entry));
+		header.file_size = header.glyphs_offset + glyph_count * header.glyph_stride;
+		header.checksum = impl::hash_bytes(std::as_bytes(std::span{&header, 1}).first(offsetof(impl::glyph_cache_header, checksum)));
+
+		glyph_cache ret{};
+		ret.glyphs = glyph_count;
+		ret.entries_offset = header.entries_offset;
+		ret.glyphs_offset = header.glyphs_offset;
+		ret.glyph_stride = header.glyph_stride;
+
+		std::array<char, 64> name;
+		std::snprintf(name.data(), name.size(), "%016llx-%016llx.msdf",
+			static_cast<unsigned long long>(header.font_hash), static_cast<unsigned long long>(header.params_hash));
+
+		auto existing = llfio::mapped_file(dir.assume_value(), name.data(), llfio::mapped_file_handle::mode::write, llfio::mapped_file_handle::creation::open_existing);
+		if(existing.has_value()) {
+			llfio::mapped_file_handle mh = std::move(existing).assume_value();
+			auto extent = mh.maximum_extent();
+			if(extent.has_value() && extent.assume_value() >= header.file_size && std::memcmp(mh.address(), &header, sizeof(header)) == 0) {
+				ret.handle = std::move(mh);
+				return ret;
+			}
+		}
+
+		//Built under a unique name and only then linked in place (replacing any stale file), so that another process never maps
+		//a file without a complete header. If several processes rebuild it at once, the last one linked wins and the others'
+		//files are just unlinked copies, which still work as caches for the processes that made them
+		auto created = llfio::mapped_file_handle::mapped_uniquely_named_file(header.file_size, dir.assume_value(), llfio::mapped_file_handle::mode::write, llfio::mapped_file_handle::caching::all);
+		if(created.has_error())
+			return static_cast<errc>(created.assume_error().value());
+		llfio::mapped_file_handle mh = std::move(created).assume_value();
+
+		//Grown sparsely and zero-filled, so every entry starts out empty
+		if(auto truncated = mh.truncate(header.file_size); truncated.has_error()) {
+			(void)mh.unlink();
+			return static_cast<errc>(truncated.assume_error().value());
+		}
+		std::memcpy(mh.address(), &header, sizeof(header));
+		if(auto relinked = mh.relink(dir.assume_value(), name.data()); relinked.has_error()) {
+			(void)mh.unlink();
+			return static_cast<errc>(relinked.assume_error().value());
+		}
+
+		ret.handle = std::move(mh);
+		return ret;
+	}
+}
+
+
+namespace acma {
+	std::byte* glyph_cache::entry_address(std::uint32_t glyph_id) const noexcept {
+		return reinterpret_cast<std::byte*>(handle.address()) + entries_offset + std::uint64_t{glyph_id} * sizeof(impl::glyph_cache_entry);
+	}
+
+	std::byte* glyph_cache::glyph_address(std::uint32_t glyph_id) const noexcept {
+		return reinterpret_cast<std::byte*>(handle.address()) + glyphs_offset + glyph_id * glyph_stride;
+	}
+
+
+	bool glyph_cache::load(std::uint32_t glyph_id, std::array<std::byte, decoder::font_texture::size_bytes>& glyph, decoder::glyph_extent& extent) const noexcept {
+		if(glyph_id >= glyphs) return false;
+		impl::glyph_cache_entry* const entry_ptr = reinterpret_cast<impl::glyph_cache_entry*>(entry_address(glyph_id));
+		const std::atomic_ref<std::uint32_t> state(entry_ptr->state);
+		const std::uint32_t sequence = state.load(std::memory_order_acquire);
+		if(!impl::entry_published(sequence))
+			return false;
+
+		//Copied before checking, since another process may be rewriting it. If it was (the state moved on while copying), the copy
+		//may be torn. The checksum still catches concurrent stores that both publish the same sequence number
+		impl::glyph_cache_entry entry;
+		std::memcpy(&entry, entry_ptr, sizeof(entry));
+		std::memcpy(glyph.data(), glyph_address(glyph_id), glyph.size());
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if(state.load(std::memory_order_relaxed) != sequence)
+			return false;
+		if(entry.glyph_id != glyph_id || entry.checksum != impl::entry_checksum(entry, glyph)) [[unlikely]]
+			return false;
+		if(entry.width > decoder::font_texture::length_pixels || entry.height > decoder::font_texture::length_pixels) [[unlikely]]
+			return false;
+
+		extent = decoder::glyph_extent{
+			.size = {entry.width, entry.height},
+			.origin = {entry.origin_x, entry.origin_y},
+		};
+		return true;
+	}
+
+	void glyph_cache::store(std::uint32_t glyph_id, std::array<std::byte, decoder::font_texture::size_bytes> const& glyph, decoder::glyph_extent extent) noexcept {
+		if(glyph_id >= glyphs) return;
+		impl::glyph_cache_entry* const entry_ptr = reinterpret_cast<impl::glyph_cache_entry*>(entry_address(glyph_id));
+		std::atomic_ref<std::uint32_t> state(entry_ptr->state);
+
+		//Unpublished (odd) while it's rewritten, even if a crashed store left it odd already. The fence pairs with the acquire fence in
+		//load: a load that copies any of the writes below reads this state (or a later one) when it checks again, so it misses
+		const std::uint32_t sequence = state.load(std::memory_order_relaxed) | 1;
+		state.store(sequence, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		impl::glyph_cache_entry entry{
+			.state = 0,
+			.glyph_id = glyph_id,
+			.width = extent.size.width(),
+			.height = extent.size.height(),
+			.origin_x = extent.origin.x(),
+			.origin_y = extent.origin.y(),
+			.checksum = 0,
+		};
+		entry.checksum = impl::entry_checksum(entry, glyph);
+		std::memcpy(glyph_address(glyph_id), glyph.data(), glyph.size());
+		std::memcpy(reinterpret_cast<std::byte*>(entry_ptr) + sizeof(entry.state), reinterpret_cast<std::byte const*>(&entry) + sizeof(entry.state), sizeof(entry) - sizeof(entry.state));
+
+		state.store(sequence + 1, std::memory_order_release);
+	}
+}
@@ -4,11 +4,14 @@
 #include <ktx.h>
 #include <ktxvulkan.h>
 #include <msdfgen.h>
-#include <msdfgen/core/DistanceMapping.h>
-#include <msdfgen/core/ShapeDistanceFinder.h>
-#include <msdfgen/core/edge-selectors.h>
+
+#include <atomic>
+#include <cmath>
+#include <numeric>
 
 #include "sirius/arith/rect.hpp"
+#include "sirius/core/thread_pool.hpp"
+#include "sirius/graphics/core/glyph_distance_field.hpp"
 
 
 namespace acma::decoder {
@@ -26,6 +29,79 @@ namespace acma::decoder {
 	}
 }
 
+namespace acma::impl {
+    using glyph_distance_field = ::acma::glyph_distance_field<decoder::font_texture::length_pixels>;
+
+    //Normalizes and edge-colors the glyph's shape into outline, and returns the part of its font_texture it covers.
+    //Shared by the CPU and GPU paths, so both evaluate the same edges over the same texels
+    decoder::glyph_extent outline_glyph(msdfgen::Shape& shape, glyph_outline& outline) noexcept {
+        namespace font_texture = decoder::font_texture;
+
+        if (!shape.contours.empty() && shape.contours.back().edges.empty())
+            shape.contours.pop_back();
+        shape.inverseYAxis = true;
+        shape.normalize();
+        msdfgen::edgeColoringSimple(shape, 3.0);
+        msdfgen::Shape::Bounds b = shape.getBounds();
+        constexpr static double font_texture_length_em = font_texture::length_pixels / 16.0;
+        pt2f top_left{
+            static_cast<float>(std::clamp(b.l, -font_texture_length_em, font_texture_length_em)), 
+            static_cast<float>(std::clamp(b.t, -font_texture_length_em, font_texture_length_em))
+        };
+        pt2f bottom_right{
+            static_cast<float>(std::clamp(b.r, -font_texture_length_em, font_texture_length_em)),
+            static_cast<float>(std::clamp(b.b, -font_texture_length_em, font_texture_length_em)),
+        };
+
+        outline.clear();
+        for(msdfgen::Contour const& contour : shape.contours) {
+            outline.add_contour();
+            for(msdfgen::EdgeHolder const& edge : contour.edges) {
+                glyph_edge e{
+                    .points = {},
+                    .degree = static_cast<std::uint8_t>(edge->type()),
+                    .color = static_cast<std::uint8_t>(edge->color),
+                };
+                msdfgen::Point2 const* const control_points = edge->controlPoints();
+                for(std::size_t i = 0; i <= e.degree; ++i)
+                    e.points[i] = std::bit_cast<pt2d>(control_points[i]);
+                outline.add_edge(e);
+            }
+        }
+
+        pt2f msdf_padding = static_cast<float>(font_texture::padding_em) - pt2f{top_left.x(), bottom_right.y()};
+        auto to_pixels = [](double length_em) noexcept {
+            const double length = std::ceil((length_em + 2 * font_texture::padding_em) * font_texture::glyph_scale);
+            return static_cast<std::uint32_t>(std::clamp(length, 0., static_cast<double>(font_texture::length_pixels)));
+        };
+        return decoder::glyph_extent{
+            .size = {to_pixels(bottom_right.x() - top_left.x()), to_pixels(top_left.y() - bottom_right.y())},
+            .origin = {-msdf_padding.x(), -msdf_padding.y()},
+        };
+    }
+
+    //Renders one glyph's outline into its MSDF texture. Only touches its arguments, so glyphs can be generated concurrently
+    //(outline and distance_field are just scratch memory, reused across a worker's glyphs)
+    decoder::glyph_extent generate_glyph(msdfgen::Shape& shape, glyph_outline& outline, glyph_distance_field& distance_field, std::array<std::byte, decoder::font_texture::size_bytes>& glyph) noexcept {
+        namespace font_texture = decoder::font_texture;
+
+        const decoder::glyph_extent extent = outline_glyph(shape, outline);
+        const pt2f translate = extent.origin;
+
+        std::array<float, font_texture::size_bytes> bitmap;
+        distance_field.evaluate(outline, font_texture::glyph_scale, pt2d{translate.x(), translate.y()}, bitmap);
+        #pragma omp simd
+        for(std::size_t i = 0; i < font_texture::size_bytes; ++i)
+            bitmap[i] = static_cast<float>(bitmap[i] / font_texture::distance_range + .5);
+
+        msdfErrorCorrection(msdfgen::BitmapRef<float, 4>{bitmap.data(), font_texture::length_pixels, font_texture::length_pixels}, shape, msdfgen::Projection(font_texture::glyph_scale, msdfgen::Vector2(-translate.x(), -translate.y())), msdfgen::Range(font_texture::distance_range));
+
+        for(std::size_t i = 0; i < font_texture::size_bytes; ++i)
+            glyph[i] = static_cast<std::byte>(msdfgen::pixelFloatToByte(bitmap[i]));
+        return extent;
+    }
+}
+
 namespace acma::decoder { 
 	result<texture>
 	decode_texture(llfio::mapped_file_handle const& handle, texture_usage usage) noexcept {
@@ -68,84 +144,100 @@ namespace acma::decoder {
         sl::unique_ptr<hb_blob_t, sl::functor::generic_stateless<hb_blob_destroy>> blob_ptr(hb_blob_create(reinterpret_cast<char const*>(font_file_bytes.data()), font_file_bytes.size(), HB_MEMORY_MODE_DUPLICATE, nullptr, nullptr));
         sl::unique_ptr<hb_face_t, sl::functor::generic_stateless<hb_face_destroy>> face_ptr(hb_face_create(blob_ptr.get(), 0));
         sl::unique_ptr<hb_font_t, sl::functor::generic_stateless<hb_font_destroy>> font_ptr(hb_font_create(face_ptr.get()));
-
-        const unsigned int units_per_em = hb_face_get_upem(face_ptr.get());
-        const double scale = 1./units_per_em;
-        impl::glyph_context glyph_ctx{
-            .pos = {},
-            .scale = scale,
-        };
-
-        hb_draw_funcs_t* draw_funcs = hb_draw_funcs_create();
-        hb_draw_funcs_set_move_to_func     (draw_funcs, ::acma::impl::move_to,  &glyph_ctx, nullptr);
-        hb_draw_funcs_set_line_to_func     (draw_funcs, ::acma::impl::line_to,  &glyph_ctx, nullptr);
-        hb_draw_funcs_set_quadratic_to_func(draw_funcs, ::acma::impl::quad_to,  &glyph_ctx, nullptr);
-        hb_draw_funcs_set_cubic_to_func    (draw_funcs, ::acma::impl::cubic_to, &glyph_ctx, nullptr);
+        hb_font_make_immutable(font_ptr.get());
 
         const unsigned int glyph_count = hb_face_get_glyph_count(face_ptr.get());
+        std::vector<unsigned int> glyph_ids(glyph_count);
+        std::iota(glyph_ids.begin(), glyph_ids.end(), 0u);
         std::vector<std::array<std::byte, font_texture::size_bytes>> glyphs(glyph_count);
-        std::vector<rect<float>> glyph_bounds(glyph_count);
-        std::vector<pt2f> glyph_padding(glyph_count);
-        errc ret = errc::unknown;
+        std::vector<glyph_extent> extents(glyph_count);
+        RESULT_VERIFY(generate_glyphs(font_ptr.get(), glyph_ids, glyphs, extents));
 
-        //#pragma omp taskloop 
-        for(unsigned int glyph_id = 0; glyph_id < glyph_count; ++glyph_id){
-            msdfgen::Shape shape;
-            if(!hb_font_draw_glyph_or_fail(font_ptr.get(), glyph_id, draw_funcs, &shape)) [[unlikely]] {
-                //#pragma omp atomic write
-                ret = errc::invalid_font_file_format;
-                break;
-                //#pragma omp cancel taskgroup
-            }
-            //#pragma omp cancellation point taskgroup
-
-            if (!shape.contours.empty() && shape.contours.back().edges.empty())
-                shape.contours.pop_back();
-            shape.inverseYAxis = true;
-            shape.normalize();
-            msdfgen::edgeColoringSimple(shape, 3.0);
-            msdfgen::Shape::Bounds b = shape.getBounds();
-            constexpr static double font_texture_length_em = font_texture::length_pixels / 16.0;
-            pt2f top_left{
-                static_cast<float>(std::clamp(b.l, -font_texture_length_em, font_texture_length_em)), 
-                static_cast<float>(std::clamp(b.t, -font_texture_length_em, font_texture_length_em))
-            };
-            pt2f bottom_right{
-                static_cast<float>(std::clamp(b.r, -font_texture_length_em, font_texture_length_em)),
-                static_cast<float>(std::clamp(b.b, -font_texture_length_em, font_texture_length_em)),
-            };
-            glyph_bounds[glyph_id] = {
-                top_left.x(), top_left.y(), 
-                bottom_right.x() - top_left.x(), bottom_right.y() - top_left.y()
+		return sl::move(glyphs);
+	}
+
+	result<void> generate_glyphs(
+		hb_font_t* font,
+		std::span<const unsigned int> glyph_ids,
+		std::span<std::array<std::byte, font_texture::size_bytes>> glyphs,
+		std::span<glyph_extent> extents
+	) noexcept {
+        if(glyphs.size() < glyph_ids.size() || extents.size() < glyph_ids.size()) return errc::invalid_argument;
+
+        const double scale = 1./hb_face_get_upem(hb_font_get_face(font));
+        std::atomic<bool> invalid_glyph = false;
+
+        //Each block gets its own draw context (the draw functions track the pen position in it), and writes only its own glyphs,
+        //so the output doesn't depend on the scheduling
+        auto generate_block = [&](std::size_t first_glyph, std::size_t last_glyph) noexcept {
+            impl::glyph_context glyph_ctx{
+                .pos = {},
+                .scale = scale,
             };
+            sl::unique_ptr<hb_draw_funcs_t, sl::functor::generic_stateless<hb_draw_funcs_destroy>> draw_funcs_ptr(hb_draw_funcs_create());
+            hb_draw_funcs_set_move_to_func     (draw_funcs_ptr.get(), ::acma::impl::move_to,  &glyph_ctx, nullptr);
+            hb_draw_funcs_set_line_to_func     (draw_funcs_ptr.get(), ::acma::impl::line_to,  &glyph_ctx, nullptr);
+            hb_draw_funcs_set_quadratic_to_func(draw_funcs_ptr.get(), ::acma::impl::quad_to,  &glyph_ctx, nullptr);
+            hb_draw_funcs_set_cubic_to_func    (draw_funcs_ptr.get(), ::acma::impl::cubic_to, &glyph_ctx, nullptr);
+            glyph_outline outline;
+            impl::glyph_distance_field distance_field;
+
+            for(std::size_t i = first_glyph; i < last_glyph; ++i) {
+                //Cancelled by another block
+                if(invalid_glyph.load(std::memory_order_relaxed)) [[unlikely]] return;
 
-            std::array<float, font_texture::size_bytes> bitmap;
-
-            //msdfgen::DistanceMapping mapping((msdfgen::Range(font_texture_distance_range)));
-            //TODO: true SIMD
-            glyph_padding[glyph_id] = static_cast<float>(font_texture::padding_em) - pt2f{top_left.x(), bottom_right.y()};
-            pt2f msdf_padding = glyph_padding[glyph_id];//font_texture_padding_em - pt2d{top_left.x(), bottom_right.y()};
-            #pragma omp parallel for collapse(2)
-            for (std::size_t y = 0; y < font_texture::length_pixels; ++y) {
-                for (std::size_t col = 0; col < font_texture::length_pixels; ++col) {
-                    std::size_t x = (y % 2) ? font_texture::length_pixels - col - 1 : col;
-                    pt2d p = pt2d{x + .5, y + .5} / font_texture::glyph_scale - msdf_padding;//pt2d{bitmap_padding_em, ((bitmap_pixel_length)/ static_cast<double>(glyph_scale)) - (b.t - b.b) - bitmap_padding_em};
-                    msdfgen::ShapeDistanceFinder<msdfgen::OverlappingContourCombiner<msdfgen::MultiAndTrueDistanceSelector>> distanceFinder(shape);
-                    std::array<double, font_texture::channels> distance = std::bit_cast<std::array<double, font_texture::channels>>(distanceFinder.distance(std::bit_cast<msdfgen::Point2>(p)));
-                    float* const bitmap_begin = &bitmap[font_texture::channels * (font_texture::length_pixels * (font_texture::length_pixels - y - 1) + x)];
-                    for(std::size_t channel = 0; channel < font_texture::channels; ++channel)
-                        bitmap_begin[channel] = static_cast<float>(distance[channel] / font_texture::distance_range + .5);
+                msdfgen::Shape shape;
+                if(!hb_font_draw_glyph_or_fail(font, glyph_ids[i], draw_funcs_ptr.get(), &shape)) [[unlikely]] {
+                    invalid_glyph.store(true, std::memory_order_relaxed);
+                    return;
                 }
+                extents[i] = impl::generate_glyph(shape, outline, distance_field, glyphs[i]);
             }
+        };
 
-            msdfErrorCorrection(msdfgen::BitmapRef<float, 4>{bitmap.data(), font_texture::length_pixels, font_texture::length_pixels}, shape, msdfgen::Projection(font_texture::glyph_scale, msdfgen::Vector2(msdf_padding.x(), msdf_padding.y())), msdfgen::Range(font_texture::distance_range));
+        //Waiting on the pool from one of its own threads could deadlock, so generate serially there instead
+        if(BS::this_thread::get_pool().has_value()) generate_block(0, glyph_ids.size());
+        else {
+            //Several blocks per thread, since glyphs vary a lot in complexity
+            const std::size_t block_count = thread_pool().get_thread_count() * 4;
+            thread_pool().submit_blocks(std::size_t{0}, glyph_ids.size(), generate_block, block_count).wait();
+        }
+        if(invalid_glyph.load(std::memory_order_relaxed)) return errc::invalid_font_file_format;
+
+        return {};
+	}
 
-            for(std::size_t i = 0; i < font_texture::size_bytes; ++i)
-                glyphs[glyph_id][i] = static_cast<std::byte>(msdfgen::pixelFloatToByte(bitmap[i]));
+	result<void> flatten_glyphs(
+		hb_font_t* font,
+		std::span<const unsigned int> glyph_ids,
+		std::span<const glyph_target> targets,
+		glyph_edge_buffer& edges,
+		std::span<glyph_extent> extents
+	) noexcept {
+        static_assert(glyph_edge_buffer::texture_length_pixels == font_texture::length_pixels);
+        if(targets.size() < glyph_ids.size() || extents.size() < glyph_ids.size()) return errc::invalid_argument;
+
+        impl::glyph_context glyph_ctx{
+            .pos = {},
+            .scale = 1./hb_face_get_upem(hb_font_get_face(font)),
+        };
+        sl::unique_ptr<hb_draw_funcs_t, sl::functor::generic_stateless<hb_draw_funcs_destroy>> draw_funcs_ptr(hb_draw_funcs_create());
+        hb_draw_funcs_set_move_to_func     (draw_funcs_ptr.get(), ::acma::impl::move_to,  &glyph_ctx, nullptr);
+        hb_draw_funcs_set_line_to_func     (draw_funcs_ptr.get(), ::acma::impl::line_to,  &glyph_ctx, nullptr);
+        hb_draw_funcs_set_quadratic_to_func(draw_funcs_ptr.get(), ::acma::impl::quad_to,  &glyph_ctx, nullptr);
+        hb_draw_funcs_set_cubic_to_func    (draw_funcs_ptr.get(), ::acma::impl::cubic_to, &glyph_ctx, nullptr);
+        glyph_outline outline;
+
+        for(std::size_t i = 0; i < glyph_ids.size(); ++i) {
+            msdfgen::Shape shape;
+            if(!hb_font_draw_glyph_or_fail(font, glyph_ids[i], draw_funcs_ptr.get(), &shape)) [[unlikely]]
+                return errc::invalid_font_file_format;
+
+            extents[i] = impl::outline_glyph(shape, outline);
+            edges.add_glyph(outline, font_texture::glyph_scale, pt2d{extents[i].origin.x(), extents[i].origin.y()}, font_texture::distance_range, targets[i].image_index, targets[i].offset, extents[i].size);
         }
-        if(ret != errc::unknown) return ret;
 
-		return sl::move(glyphs);
+        return {};
 	}
 }
 
@@ -146,6 +146,16 @@ namespace acma::vk {
 		queue_family_infos = device_queue_family_infos;
 		return {};
 	}
+
+
+	bool physical_device::supports_storage_image(VkFormat format) const noexcept {
+		if(per_stage_descriptor_count_limits[asset_usage_policy::storage_image] == 0) 
+			return false;
+
+		VkFormatProperties format_properties;
+		vkGetPhysicalDeviceFormatProperties(handle, format, &format_properties);
+		return format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT;
+	}
 }
 
 
@@ -2,6 +2,7 @@
 #include <sirius/arith/point.hpp>
 #include <sirius/core/buffer_config_table.hpp>
 #include <sirius/core/buffer_config.hpp>
+#include <sirius/graphics/core/glyph_edge_buffer.hpp>
 
 #include "./push_constants.hpp"
 
@@ -23,6 +24,10 @@ enum : acma::buffer_key_t {
 	draw_constants,
 	compute_constants,
 
+	glyph_edges,
+	glyph_dispatch_commands,
+	glyph_constants,
+	glyph_readback,
 
 	num_buffer_ids
 };
@@ -44,5 +49,10 @@ constexpr acma::buffer_config_table<buffer_id::num_buffer_ids> buffer_configs{{{
 	{buffer_id::compute_buffer_addresses, {acma::memory_policy::shared, acma::coupling_policy::decoupled, acma::buffer_usage_policy::generic, 0, 3 * sizeof(acma::gpu_address_t)}}, //uniform
 	{buffer_id::draw_constants, {acma::memory_policy::push_constant, acma::coupling_policy::decoupled, acma::buffer_usage_policy::push_constant, acma::shader_stage::all_graphics, sizeof(draw_constants)}},
 	{buffer_id::compute_constants, {acma::memory_policy::push_constant, acma::coupling_policy::decoupled, acma::buffer_usage_policy::push_constant, acma::shader_stage::compute, sizeof(compute_constants)}},
+
+	{buffer_id::glyph_edges, {acma::memory_policy::shared, acma::coupling_policy::coupled, acma::buffer_usage_policy::generic, 0, 0}},
+	{buffer_id::glyph_dispatch_commands, {acma::memory_policy::shared, acma::coupling_policy::coupled, acma::buffer_usage_policy::dispatch_commands, 0, sizeof(acma::dispatch_command_t)}},
+	{buffer_id::glyph_constants, {acma::memory_policy::push_constant, acma::coupling_policy::decoupled, acma::buffer_usage_policy::push_constant, acma::shader_stage::compute, sizeof(acma::glyph_generation_constants)}},
+	{buffer_id::glyph_readback, {acma::memory_policy::shared, acma::coupling_policy::coupled, acma::buffer_usage_policy::generic, 0, 0}},
 	
 }}};
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+#include <array>
+
+#include <streamline/metaprogramming/integer_sequence.hpp>
+
+#include "sirius/core/dispatchable.hpp"
+#include "sirius/shaders/generate_glyphs.hpp"
+
+#include "./buffer_config_table.hpp"
+#include "./asset_heap_config_table.hpp"
+
+namespace acma::test {
+	//Writes the glyphs in glyph_edges (see acma::glyph_edge_buffer) into the compute asset heap's storage images
+	struct generate_glyphs : public acma::dispatchable {
+        constexpr static auto comp_shader_data = std::to_array(acma::shaders::generate_glyphs::comp);
+	public:
+		constexpr static auto buffers = acma::buffer_key_sequence<
+			::buffer_id::glyph_constants,
+			::buffer_id::glyph_dispatch_commands,
+
+			::buffer_id::glyph_edges
+		>;
+		constexpr static auto asset_heaps = acma::asset_heap_key_sequence<
+			::asset_heap_id::compute
+		>;
+	public:
+		constexpr static sl::array<1, buffer_key_t> dispatch_buffers{{
+			::buffer_id::glyph_dispatch_commands
+		}};
+	};
+}
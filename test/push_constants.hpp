@@ -1,10 +1,13 @@
 #pragma once
 #include <vulkan/vulkan.h>
+#include <sirius/arith/packed.hpp>
 #include <sirius/arith/size.hpp>
 
 struct draw_constants {
 	acma::extent2 swap_extent;
 	VkDeviceAddress position_buff_addr;
+	//Packed on the CPU and unpacked in rect.vert with shaders/packing.glsl
+	acma::unorm8x4 rect_tint;
 };
 
 struct compute_constants {
@@ -91,7 +91,8 @@ int main(){
 		{
 		draw_constants constants {
 			.swap_extent = win.swap_chain().extent(),
-			.position_buff_addr = sl::universal::get<buffer_id::positions>(proc).gpu_address()
+			.position_buff_addr = sl::universal::get<buffer_id::positions>(proc).gpu_address(),
+			.rect_tint = acma::unorm8x4{acma::unorm8x4::unpacked_type{1.f, .85f, .7f, 1.f}},
 		};
 		std::memcpy(
 			sl::universal::get<buffer_id::draw_constants>(proc).data(),
@@ -1,14 +1,125 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <numbers>
+#include <type_traits>
+#include <vector>
 
+#include <sirius/arith/affine2.hpp>
 #include <sirius/arith/axis.hpp>
 #include <sirius/arith/vector.hpp>
 #include <sirius/arith/point.hpp>
+#include <sirius/arith/math.hpp>
 #include <sirius/arith/matrix.hpp>
+#include <sirius/arith/simd.hpp>
+#include <sirius/arith/expression.hpp>
+#include <sirius/arith/rect.hpp>
+#include <sirius/arith/quaternion_batch.hpp>
+#include <sirius/arith/rect_batch.hpp>
+#include <sirius/arith/rect_tree.hpp>
+#include <sirius/arith/vector_batch.hpp>
+#include <sirius/arith/packed.hpp>
 
 
 constexpr double sqrt_newton (double x, double curr, double prev) { return curr == prev ? curr : sqrt_newton(x, 0.5 * (curr + x / curr), curr); }
 
 
+template<typename T>
+constexpr std::array<T, 8> simd_test_values = std::is_integral_v<T> ?
+    std::array<T, 8>{0, -1, 3, -7, 12, 30000, -4096, 255} :
+    std::array<T, 8>{static_cast<T>(0), -1, 3, -7, static_cast<T>(1) / 3, static_cast<T>(1e18), static_cast<T>(-2.5e-10), static_cast<T>(12345.678)};
+
+template<typename T>
+bool simd_lane_matches(T scalar_lane, T simd_lane) {
+#ifdef __FAST_MATH__
+    //-ffast-math allows vectorized division to use a reciprocal approximation, so only require the results to be within a few ulps
+    if constexpr(std::is_floating_point_v<T>) {
+        const T diff = scalar_lane > simd_lane ? scalar_lane - simd_lane : simd_lane - scalar_lane;
+        const T magnitude = scalar_lane < 0 ? -scalar_lane : scalar_lane;
+        return diff <= magnitude * std::numeric_limits<T>::epsilon() * 4;
+    }
+#endif
+    return std::memcmp(&scalar_lane, &simd_lane, sizeof(T)) == 0;
+}
+
+template<std::size_t Dims, typename T>
+bool simd_matches(acma::vector<Dims, T> const& scalar_ret, acma::vector<Dims, T> const& simd_ret) {
+    for(std::size_t i = 0; i < Dims; ++i)
+        if(!simd_lane_matches(scalar_ret[i], simd_ret[i])) return false;
+    return true;
+}
+
+//Normalized coordinates are in [-1, 1], so an absolute tolerance is used under -ffast-math
+bool batch_point_matches(acma::pt2f batch_pt, acma::pt2f pt) {
+#ifdef __FAST_MATH__
+    for(std::size_t i = 0; i < 2; ++i)
+        if(batch_pt[i] - pt[i] > 1e-6f || pt[i] - batch_pt[i] > 1e-6f) return false;
+    return true;
+#else
+    return batch_pt == pt;
+#endif
+}
+
+//Interpolates a single pair through the batch slerp and compares it with the expected quaternion, up to the q/-q ambiguity
+bool slerp_matches(acma::quatf a, acma::quatf b, float t, acma::quatf expected) {
+    acma::quaternion_batch<float> ba{std::span<acma::quatf const>{&a, 1}}, bb{std::span<acma::quatf const>{&b, 1}}, dst(1);
+    acma::slerp(ba, bb, t, dst.view());
+    const acma::quatf got = dst[0];
+    float same = 0, flipped = 0;
+    for(std::size_t c = 0; c < 4; ++c) {
+        same = std::max(same, std::abs(got[c] - expected[c]));
+        flipped = std::max(flipped, std::abs(got[c] + expected[c]));
+    }
+    return std::min(same, flipped) <= 2e-6f;
+}
+
+template<std::size_t Dims, typename T, typename Op>
+bool simd_matches_scalar() {
+    for(std::size_t offset = 0; offset < simd_test_values<T>.size(); ++offset) {
+        acma::vector<Dims, T> lhs, rhs;
+        for(std::size_t i = 0; i < Dims; ++i) {
+            lhs[i] = simd_test_values<T>[(offset + i) % simd_test_values<T>.size()];
+            rhs[i] = simd_test_values<T>[(offset + i + 3) % simd_test_values<T>.size()];
+            if(rhs[i] == 0) rhs[i] = 2;
+        }
+
+        acma::vector<Dims, T> scalar_ret, simd_ret;
+        acma::impl::scalar_elementwise<Dims, Op>(scalar_ret, lhs, rhs);
+        acma::impl::simd_elementwise<Dims, Op>(simd_ret, lhs, rhs);
+        if(!simd_matches(scalar_ret, simd_ret)) return false;
+
+        acma::impl::scalar_elementwise<Dims, Op>(scalar_ret, lhs, rhs[0]);
+        acma::impl::simd_elementwise<Dims, Op>(simd_ret, lhs, rhs[0]);
+        if(!simd_matches(scalar_ret, simd_ret)) return false;
+
+        acma::impl::scalar_elementwise<Dims, Op>(scalar_ret, lhs[0], rhs);
+        acma::impl::simd_elementwise<Dims, Op>(simd_ret, lhs[0], rhs);
+        if(!simd_matches(scalar_ret, simd_ret)) return false;
+    }
+    return true;
+}
+
+template<std::size_t Dims, typename T>
+bool simd_matches_scalar_all_ops() {
+    //Vectors that don't fill a register never take the simd path
+    if constexpr(!acma::impl::simd_fills_register<T, Dims>)
+        return true;
+    else if constexpr(std::is_integral_v<T>)
+        return simd_matches_scalar<Dims, T, std::plus<>>() && simd_matches_scalar<Dims, T, std::minus<>>() && simd_matches_scalar<Dims, T, std::multiplies<>>();
+    else
+        return simd_matches_scalar<Dims, T, std::plus<>>() && simd_matches_scalar<Dims, T, std::minus<>>() && simd_matches_scalar<Dims, T, std::multiplies<>>() && simd_matches_scalar<Dims, T, std::divides<>>();
+}
+
+template<typename T>
+bool simd_matches_scalar_all_dims() {
+    return simd_matches_scalar_all_ops<2, T>() && simd_matches_scalar_all_ops<3, T>() && simd_matches_scalar_all_ops<4, T>();
+}
+
+
 int main(){
     constexpr acma::vector3<std::size_t> x{5, 13, 7};
     constexpr acma::pt2<float> x2 = static_cast<acma::pt2<float>>(x);
@@ -56,6 +167,35 @@ int main(){
     static_assert(la[3][0] == 0 && la[3][1] == 0 && la[3][2] == 0 && la[3][3] == 1);
 
 
+    constexpr acma::vk_mat4 st = acma::vk_mat4::translating({1.f, 2.f, 3.f}) * acma::vk_mat4::scaling({2.f, 4.f, 8.f});
+    static_assert(st.determinant() == 64);
+    static_assert(st.inverse() == acma::vk_mat4::scaling({.5f, .25f, .125f}) * acma::vk_mat4::translating({-1.f, -2.f, -3.f}));
+    static_assert(st.affine_inverse() == st.inverse());
+    constexpr acma::matrix<3, 4, float> st34 = {{{ {{2, 0, 0, 1}}, {{0, 4, 0, 2}}, {{0, 0, 8, 3}} }}};
+    static_assert(acma::matrix<3, 4, float>::composed(st34, st34.affine_inverse()) == acma::matrix<3, 4, float>{{{ {{1, 0, 0, 0}}, {{0, 1, 0, 0}}, {{0, 0, 1, 0}} }}});
+    static_assert(acma::mat3<float>{{{ {{2, 1, 0}}, {{1, 3, 1}}, {{0, 1, 4}} }}}.determinant() == 18);
+    //affine_inverse only reads the linear block and translation, so it must agree with inverse() on any affine matrix
+    constexpr acma::mat4<float> sheared = {{{ {{2, 1, .5f, 7}}, {{-1, 3, 0, -2}}, {{.25f, 0, 4, 5}}, {{0, 0, 0, 1}} }}};
+    constexpr acma::mat3<float> sheared2 = {{{ {{2, 1, 7}}, {{-1, 3, -2}}, {{0, 0, 1}} }}};
+    for(std::size_t r = 0; r < 4; ++r)
+        for(std::size_t c = 0; c < 4; ++c)
+            if(std::abs(sheared.affine_inverse()[r][c] - sheared.inverse()[r][c]) > 1e-6f || (r < 3 && c < 3 && std::abs(sheared2.affine_inverse()[r][c] - sheared2.inverse()[r][c]) > 1e-6f)) return 1;
+    //runtime (SIMD) multiplication must match compile time (generic) multiplication
+    acma::vk_mat4 runtime_la = la, runtime_psp = psp;
+    if(runtime_la * runtime_psp != la * psp) return 1;
+    std::array<acma::vec4<float>, 2> batch_src = {x4, x4st}, batch_dst;
+    acma::transform<4, float>(std::span{&runtime_la, 1}, batch_src, batch_dst);
+    if(batch_dst[0] != la * x4 || batch_dst[1] != la * x4st) return 1;
+    //Mismatched spans stop at the shortest one instead of reading or writing past it
+    const std::array<acma::vec4<float>, 2> untouched = batch_dst;
+    acma::transform<4, float>(std::span<acma::vk_mat4 const>{}, batch_src, batch_dst);
+    acma::transform<4, float>(std::span{&runtime_psp, 1}, batch_src, std::span{batch_dst}.first(0));
+    if(batch_dst != untouched) return 1;
+    const std::array<acma::vk_mat4, 2> batch_mats = {runtime_psp, runtime_la};
+    acma::transform<4, float>(batch_mats, std::span{batch_src}.first(1), batch_dst);
+    if(batch_dst[0] != psp * x4 || batch_dst[1] != untouched[1]) return 1;
+
+
     //test quaternions
     //TODO
 
@@ -75,6 +215,246 @@ int main(){
     static_assert(vd == 32);
 
 
+    //test SIMD against scalar operations
+    static_assert(acma::impl::simd_fills_register<float, 4> && acma::impl::simd_fills_register<double, 2> && !acma::impl::simd_fills_register<float, 2> && !acma::impl::simd_fills_register<float, 3>);
+    if(!simd_matches_scalar_all_dims<float>()) return 1;
+    if(!simd_matches_scalar_all_dims<double>()) return 1;
+    if(!simd_matches_scalar_all_dims<std::int32_t>()) return 1;
+    constexpr acma::vec4<float> v4 = {1.5f, -2.f, 3.25f, 8.f};
+    if((v4 * v4) != acma::vec4<float>{2.25f, 4.f, 10.5625f, 64.f}) return 1;
+
+
+    //test expression templates against eager operations
+    constexpr acma::vec3<float> ve = (acma::lazy(v1) * 2.f - v2) / v1 + 1.f;
+    static_assert(ve == (v1 * 2.f - v2) / v1 + 1.f);
+    static_assert(std::is_same_v<decltype(acma::lazy(v1) + v2)::result_type, decltype(v1 + v2)>);
+    constexpr acma::vec3<float> vn = -acma::lazy(v1) + v2;
+    static_assert(vn[0] == 3 && vn[1] == 3 && vn[2] == 3);
+    constexpr acma::vk_mat4 mp = acma::lazy(la) * psp;
+    static_assert(mp == la * psp);
+    constexpr acma::vk_mat4 ms = acma::lazy(la) * 2.f - la;
+    static_assert(ms == la);
+    constexpr acma::vec4<float> mv = acma::lazy(psp) * (acma::lazy(x4) + x4);
+    static_assert(mv == psp * (x4 + x4));
+    constexpr acma::rect<float> r{10, 20, 30, 40};
+    constexpr std::array<acma::pt2f, 4> rp = r.points({100, 100});
+    constexpr acma::pt2f twos = {2, 2}, ones = {1, 1};
+    static_assert(rp[0] == (twos * (r.top_left() / acma::pt2f{100, 100})) - ones && rp[2] == (twos * (r.bottom_right() / acma::pt2f{100, 100})) - ones);
+
+
+    //test SoA batches against their AoS counterparts
+    const std::array<acma::rect<float>, 3> rects = {r, acma::rect<float>{-5, 7, 1, 2}, acma::rect<float>{50, 60, 70, 80}};
+    acma::rect_batch<float> rb{std::span<acma::rect<float> const>{rects}};
+    const acma::point_batch<2, float> rbp = rb.points({100, 100});
+    for(std::size_t i = 0; i < rects.size(); ++i)
+        for(std::size_t k = 0; k < 4; ++k)
+            if(!batch_point_matches(rbp[k * rects.size() + i], rects[i].points({100, 100})[k])) return 1;
+    //A dst too short for every rect only gets the rects whose 4 corners fit
+    acma::point_batch<2, float> rbp_short(7);
+    rbp_short.set(4, acma::pt2f{9, 9});
+    rb.points({100, 100}, rbp_short.view());
+    for(std::size_t k = 0; k < 4; ++k)
+        if(!batch_point_matches(rbp_short[k], rects[0].points({100, 100})[k])) return 1;
+    if(rbp_short[4] != acma::pt2f{9, 9}) return 1;
+    if(rb.bounds().pos != acma::pt2f{-5, 7} || rb.bounds().size != acma::size2f{125, 133}) return 1;
+    acma::point_batch<2, float> pb = rb.pos;
+    pb.transform(acma::matrix<3, 3, float>::translating({1.f, 2.f})).scale({2.f, 2.f});
+    for(std::size_t i = 0; i < rects.size(); ++i)
+        if(pb[i] != (rects[i].pos + acma::pt2f{1, 2}) * 2.f) return 1;
+    alignas(float) std::array<std::byte, 6 * sizeof(float)> view_bytes{};
+    if(acma::point_batch_view<2, float>::from_bytes(view_bytes).value_or(acma::point_batch_view<2, float>{}).size() != 3) return 1;
+    if(acma::point_batch_view<2, float>::from_bytes(std::span{view_bytes}.first(5 * sizeof(float)))) return 1;
+    if(acma::point_batch_view<2, float>::from_bytes(view_bytes, 2, 4).value_or(acma::point_batch_view<2, float>{}).stride() != 4) return 1;
+    if(acma::point_batch_view<2, float>::from_bytes(view_bytes, 3, 4) || acma::point_batch_view<2, float>::from_bytes(view_bytes, 3, 2)) return 1;
+    if(acma::point_batch_view<2, float>::from_bytes(std::span{view_bytes}.subspan(1, 4 * sizeof(float)))) return 1;
+    const std::array<acma::quatf, 2> qa = {acma::quatf{1, 2, 3, 4}, acma::quatf{0.5f, -0.5f, 0.5f, -0.5f}}, qb = {acma::quatf{5, -6, 7, 8}, acma::quatf{1, 0, 0, 0}};
+    acma::quaternion_batch<float> qba{std::span<acma::quatf const>{qa}}, qbb{std::span<acma::quatf const>{qb}}, qbd(qa.size());
+    acma::multiply(qba, qbb, qbd.view());
+    for(std::size_t i = 0; i < qa.size(); ++i) {
+        const acma::quatf l = qa[i], r = qb[i];
+        if(qbd[i] != acma::quatf{l[0]*r[0] - l[1]*r[1] - l[2]*r[2] - l[3]*r[3], l[0]*r[1] + l[1]*r[0] + l[2]*r[3] - l[3]*r[2], l[0]*r[2] - l[1]*r[3] + l[2]*r[0] + l[3]*r[1], l[0]*r[3] + l[1]*r[2] - l[2]*r[1] + l[3]*r[0]}) return 1;
+    }
+    std::array<acma::mat4<float>, 2> qm;
+    acma::to_matrix<4>(qba.view(), std::span{qm});
+    for(std::size_t i = 0; i < qa.size(); ++i)
+        if(qm[i] != acma::to_matrix<4>(qa[i])) return 1;
+    acma::normalize(qba, qba.view());
+    acma::slerp(qba, qba, 0.5f, qbd.view());
+    for(std::size_t i = 0; i < qa.size(); ++i)
+        for(std::size_t c = 0; c < 4; ++c)
+            if(qbd[i][c] - qba[i][c] > 1e-6f || qba[i][c] - qbd[i][c] > 1e-6f) return 1;
+    //Large angles take the spherical path, where nlerp would be visibly off (e.g. 18.4 instead of 22.5 degrees at t = .25 below)
+    constexpr acma::quatf identity{1, 0, 0, 0};
+    const auto about_z = [](double angle) { return acma::quatf{static_cast<float>(std::cos(angle / 2)), 0, 0, static_cast<float>(std::sin(angle / 2))}; };
+    const auto about_x = [](double angle) { return acma::quatf{static_cast<float>(std::cos(angle / 2)), static_cast<float>(std::sin(angle / 2)), 0, 0}; };
+    constexpr double pi = std::numbers::pi;
+    if(!slerp_matches(identity, about_x(pi), .25f, about_x(pi / 4))) return 1;
+    if(!slerp_matches(identity, about_z(2 * pi / 3), 1.f / 3, about_z(2 * pi / 9))) return 1;
+    if(!slerp_matches(about_z(-pi / 2), about_z(pi / 2), .75f, about_z(pi / 4))) return 1;
+    if(!slerp_matches(identity, about_x(pi), 0.f, identity) || !slerp_matches(identity, about_x(pi), 1.f, about_x(pi))) return 1;
+    //b on the other hemisphere is the same rotation as -b, so the shorter path is taken
+    const acma::quatf far_z = about_z(2 * pi / 3);
+    if(!slerp_matches(identity, acma::quatf{-far_z[0], -far_z[1], -far_z[2], -far_z[3]}, .5f, about_z(pi / 3))) return 1;
+    //Antipodal quaternions are the same rotation, so every t stays on it
+    const acma::quatf tilted = acma::normalized(acma::quatf{.5f, .3f, -.2f, .7f}, acma::math::sqrt);
+    if(!slerp_matches(tilted, acma::quatf{-tilted[0], -tilted[1], -tilted[2], -tilted[3]}, .3f, tilted)) return 1;
+    //Just past the nlerp threshold (about 3.6 degrees) the spherical path must not lose precision to the small sin(theta)
+    if(!slerp_matches(identity, about_x(.07), .5f, about_x(.035))) return 1;
+    //Near identity takes the nlerp path, which is indistinguishable from slerp there
+    if(!slerp_matches(identity, about_x(1e-4), .5f, about_x(5e-5)) || !slerp_matches(tilted, tilted, .7f, tilted)) return 1;
+    //Mismatched sizes only process the quaternions every view holds, leaving the rest of a longer dst as is
+    acma::quaternion_batch<float> qshort(1), qlong(3);
+    qlong.set(2, identity);
+    acma::multiply(qba, qshort, qlong.view());
+    acma::slerp(qba, qbb, std::span<float const>{}, qlong.view());
+    acma::nlerp(qshort, qbb, .5f, qlong.view());
+    if(qlong[2] != identity) return 1;
+    acma::normalize(qlong, qshort.view());
+    std::array<acma::mat3<float>, 1> qm_short;
+    acma::to_matrix<3>(qba.view(), std::span{qm_short});
+    if(qm_short[0] != acma::to_matrix<3>(qba[0])) return 1;
+
+
+    //test the rect tree against a linear rect::contains scan
+    acma::rect_tree<float> rt;
+    std::array<acma::rect<float>, 64> tree_rects;
+    std::array<acma::rect_handle, 64> tree_handles;
+    for(std::size_t i = 0; i < tree_rects.size(); ++i) {
+        tree_rects[i] = {static_cast<float>((i * 37) % 100), static_cast<float>((i * 61) % 100), static_cast<float>(i % 7 + 1), static_cast<float>(i % 5 + 1)};
+        tree_handles[i] = rt.insert(tree_rects[i], i);
+    }
+    for(std::size_t i = 0; i < tree_rects.size(); i += 4) rt.remove(tree_handles[i]);
+    for(std::size_t i = 1; i < tree_rects.size(); i += 4) {
+        tree_rects[i].pos += acma::pt2f{3, 3};
+        rt.update(tree_handles[i], tree_rects[i]);
+    }
+    for(float x = 0; x < 110; x += 1.5f) {
+        for(float y = 0; y < 110; y += 1.5f) {
+            std::size_t hits = 0;
+            rt.query(acma::pt2d{x, y}, [&](acma::rect_handle h, std::size_t i) {
+                hits += tree_handles[i] == h && tree_rects[i].contains({x, y});
+            });
+            std::size_t expected = 0;
+            for(std::size_t i = 0; i < tree_rects.size(); ++i)
+                expected += i % 4 != 0 && tree_rects[i].contains({x, y});
+            if(hits != expected || (rt.find(std::optional<acma::pt2d>{acma::pt2d{x, y}}) == acma::null_rect_handle) != (expected == 0)) return 1;
+        }
+    }
+    if(rt.size() != 48 || rt.find(std::optional<acma::pt2d>{}) != acma::null_rect_handle) return 1;
+
+
+    //test packed gpu data types
+    static_assert(sizeof(acma::half4) == 8 && sizeof(acma::unorm8x4) == 4 && sizeof(acma::a2b10g10r10) == 4 && sizeof(acma::oct_normal16) == 4);
+    static_assert(acma::half2::format == VK_FORMAT_R16G16_SFLOAT && acma::snorm16x4::format == VK_FORMAT_R16G16B16A16_SNORM && acma::oct_normal8::format == VK_FORMAT_R8G8_SNORM);
+    static_assert(acma::half(1.f).value == 0x3c00 && acma::half(-2.f).value == 0xc000 && acma::half(65520.f).value == 0x7c00 && acma::half(std::numeric_limits<float>::denorm_min()).value == 0);
+    for(std::uint32_t h = 0; h < 0x7c00; ++h)
+        if(acma::half(static_cast<float>(acma::half::from_bits(static_cast<std::uint16_t>(h)))).value != h) return 1;
+    static_assert(acma::unorm8(1.f).value == 255 && acma::unorm8(.5f).value == 128 && acma::snorm8(-1.f).value == -127 && acma::snorm16(2.f).value == 32767);
+    static_assert(acma::a2b10g10r10({1.f, 0.f, 1.f, 1.f}).bits == 0xfff003ff);
+    std::array<acma::unorm16x4::unpacked_type, 64> unpacked_colors, repacked_colors;
+    std::array<acma::unorm16x4, 64> packed_colors;
+    for(std::size_t i = 0; i < unpacked_colors.size(); ++i)
+        unpacked_colors[i] = {i / 63.f, 1.f - i / 63.f, .5f, 1.f};
+    acma::pack<acma::unorm16x4>(unpacked_colors, packed_colors);
+    acma::unpack<acma::unorm16x4>(packed_colors, repacked_colors);
+    for(std::size_t i = 0; i < unpacked_colors.size(); ++i)
+        if(packed_colors[i] != acma::unorm16x4(unpacked_colors[i]) || std::abs(repacked_colors[i][0] - unpacked_colors[i][0]) > 1.f / 65535) return 1;
+    std::array<acma::oct_normal16::unpacked_type, 64> normals, repacked_normals;
+    std::array<acma::oct_normal16, 64> packed_normals;
+    for(std::size_t i = 0; i < normals.size(); ++i) {
+        const float theta = i * .7f, z = i / 31.5f - 1.f, r = std::sqrt(1.f - z * z);
+        normals[i] = {r * std::cos(theta), r * std::sin(theta), z};
+    }
+    acma::pack<acma::oct_normal16>(normals, packed_normals);
+    acma::unpack<acma::oct_normal16>(packed_normals, repacked_normals);
+    for(std::size_t i = 0; i < normals.size(); ++i)
+        if(packed_normals[i] != acma::oct_normal16(normals[i]) || normals[i][0] * repacked_normals[i][0] + normals[i][1] * repacked_normals[i][1] + normals[i][2] * repacked_normals[i][2] < .99999f) return 1;
+    //Mismatched spans only convert as many values as both hold
+    const acma::unorm16x4 packed_tail = packed_colors[2];
+    acma::pack<acma::unorm16x4>(std::span{unpacked_colors}.first(2), packed_colors);
+    repacked_normals[3] = {0, 0, 0};
+    acma::unpack<acma::oct_normal16>(std::span<acma::oct_normal16 const>{packed_normals}, std::span{repacked_normals}.first(3));
+    if(packed_colors[2] != packed_tail || repacked_normals[3] != acma::oct_normal16::unpacked_type{0, 0, 0}) return 1;
+
+    //test 2d affine transforms
+    constexpr auto sin_fn = [](float a) { return static_cast<float>(std::sin(a)); };
+    constexpr auto cos_fn = [](float a) { return static_cast<float>(std::cos(a)); };
+    static_assert(sizeof(acma::affine2<float>) == 6 * sizeof(float) && std::is_trivially_copyable_v<acma::affine2<float>>);
+    static_assert(acma::affine2<float>::translating({1, 2}) * acma::pt2f{3, 4} == acma::pt2f{4, 6});
+    static_assert(static_cast<acma::mat3<float>>(acma::affine2<float>::translating({1, 2})) == acma::mat3<float>::translating({1, 2}));
+    static_assert(acma::affine2<float>::from_matrix(acma::mat3<float>::scaling({2, 3})) == acma::affine2<float>::scaling({2, 3}));
+    const acma::affine2<float> a2 = acma::affine2<float>::translating({5, -3}) * acma::affine2<float>::rotating(.6f, sin_fn, cos_fn) * acma::affine2<float>::scaling({2, .5f});
+    const acma::mat3<float> m3 = acma::mat3<float>::translating({5, -3}) * acma::mat3<float>{{{{{cos_fn(.6f), -sin_fn(.6f), 0}}, {{sin_fn(.6f), cos_fn(.6f), 0}}, {{0, 0, 1}}}}} * acma::mat3<float>::scaling({2, .5f});
+    const acma::affine2<float> a2_inv = a2.inverse();
+    std::array<acma::pt2f, 16> affine_src, affine_dst;
+    acma::point_batch<2, float> affine_batch(affine_src.size());
+    for(std::size_t i = 0; i < affine_src.size(); ++i) {
+        affine_src[i] = {i * 1.5f - 4.f, 7.f - i * .75f};
+        affine_batch.set(i, affine_src[i]);
+    }
+    acma::transform(a2, std::span<acma::pt2f const>{affine_src}, std::span<acma::pt2f>{affine_dst});
+    affine_batch.transform(a2);
+    for(std::size_t i = 0; i < affine_src.size(); ++i) {
+        const std::array<float, 3> expected = m3 * std::array<float, 3>{affine_src[i][0], affine_src[i][1], 1.f};
+        const acma::pt2f round_trip = a2_inv * affine_dst[i];
+        if(std::abs(affine_dst[i][0] - expected[0]) > 1e-4f || std::abs(affine_dst[i][1] - expected[1]) > 1e-4f) return 1;
+        if(std::abs(affine_batch[i][0] - affine_dst[i][0]) > 1e-4f || std::abs(affine_batch[i][1] - affine_dst[i][1]) > 1e-4f) return 1;
+        if(std::abs(round_trip[0] - affine_src[i][0]) > 1e-4f || std::abs(round_trip[1] - affine_src[i][1]) > 1e-4f) return 1;
+    }
+    //Empty and mismatched spans stop at the shorter one
+    const std::array<acma::pt2f, 16> affine_untouched = affine_dst;
+    acma::transform(a2, std::span<acma::pt2f const>{}, std::span<acma::pt2f>{affine_dst});
+    acma::transform(a2, std::span<acma::pt2f const>{affine_src}, std::span<acma::pt2f>{});
+    acma::transform(a2, std::span<acma::pt2f const>{affine_dst}, std::span<acma::pt2f>{affine_dst}.first(1));
+    const acma::pt2f affine_expected = a2 * affine_untouched[0];
+    if(std::abs(affine_dst[0][0] - affine_expected[0]) > 1e-4f || std::abs(affine_dst[0][1] - affine_expected[1]) > 1e-4f) return 1;
+    if(!std::equal(affine_dst.begin() + 1, affine_dst.end(), affine_untouched.begin() + 1)) return 1;
+    acma::transform_bounds(a2, std::span<acma::rect<float> const>{}, std::span<acma::rect<float>>{});
+    std::array<acma::rect<float>, 8> affine_rects, affine_bounds;
+    for(std::size_t i = 0; i < affine_rects.size(); ++i)
+        affine_rects[i] = {i * 3.f, 10.f - i, 1.f + i, 2.f};
+    acma::transform_bounds(a2, std::span<acma::rect<float> const>{affine_rects}, std::span<acma::rect<float>>{affine_bounds});
+    acma::rect_batch<float> affine_rect_batch{std::span<acma::rect<float> const>{affine_rects}};
+    affine_rect_batch.transform_bounds(a2);
+    for(std::size_t i = 0; i < affine_rects.size(); ++i) {
+        acma::pt2f lo = a2 * affine_rects[i].top_left(), hi = lo;
+        for(acma::pt2f p : affine_rects[i].points()) {
+            const acma::pt2f q = a2 * p;
+            lo = {std::min(lo[0], q[0]), std::min(lo[1], q[1])};
+            hi = {std::max(hi[0], q[0]), std::max(hi[1], q[1])};
+        }
+        if(std::abs(affine_bounds[i].x() - lo[0]) > 1e-4f || std::abs(affine_bounds[i].y() - lo[1]) > 1e-4f) return 1;
+        if(std::abs(affine_bounds[i].width() - (hi[0] - lo[0])) > 1e-4f || std::abs(affine_bounds[i].height() - (hi[1] - lo[1])) > 1e-4f) return 1;
+        if(std::abs(affine_rect_batch[i].x() - affine_bounds[i].x()) > 1e-4f || std::abs(affine_rect_batch[i].width() - affine_bounds[i].width()) > 1e-4f) return 1;
+    }
+
+
+    //test constexpr and fast math functions
+    constexpr acma::mat2<float> rot_90 = acma::mat2<float>::rotating(std::numbers::pi_v<float> / 2, acma::math::sin, acma::math::cos);
+    static_assert(rot_90[0][0] < 1e-7f && rot_90[0][0] > -1e-7f && rot_90[1][0] == 1.f && rot_90[0][1] == -1.f);
+    static_assert(acma::math::sqrt(2.0) - std::numbers::sqrt2 < 3e-16 && std::numbers::sqrt2 - acma::math::sqrt(2.0) < 3e-16 && acma::math::sqrt(16.f) == 4.f && acma::math::rsqrt(4) == .5);
+    static_assert(acma::math::atan2(1.0, 1.0) == std::numbers::pi / 4 && acma::math::atan2(-0.f, -1.f) == -std::numbers::pi_v<float>);
+    static_assert(acma::math::sin(std::numbers::pi / 6) > .5 - 1e-16 && acma::math::sin(std::numbers::pi / 6) < .5 + 1e-16);
+    static_assert(acma::math::cos(1e5) > -0.9993608074382124 - 2e-16 && acma::math::cos(1e5) < -0.9993608074382124 + 2e-16);
+    static_assert(acma::math::atan2(-3.0, -4.0) > -2.4980915447965089 - 5e-16 && acma::math::atan2(-3.0, -4.0) < -2.4980915447965089 + 5e-16);
+    constexpr acma::vec3<float> v1n_constexpr = acma::normalized(v1, acma::math::sqrt);
+    static_assert(v1n_constexpr == v1n);
+    for(int i = -20000; i <= 20000; ++i) {
+        const float x = i * .4095f;
+        if(std::abs(acma::math::fast::sin(x) - std::sin(static_cast<double>(x))) > 1e-7) return 1;
+        if(std::abs(acma::math::fast::cos(x) - std::cos(static_cast<double>(x))) > 1e-7) return 1;
+
+        const float y = (i % 200) * .37f, z = i * 1e-3f;
+        if(std::abs(acma::math::fast::atan2(y, z) - std::atan2(static_cast<double>(y), static_cast<double>(z))) > 3e-7) return 1;
+
+        const float w = std::ldexp(1.f + (i & 1023) / 1024.f, i / 1000);
+        if(std::abs(acma::math::fast::rsqrt(w) * std::sqrt(static_cast<double>(w)) - 1) > 2e-7) return 1;
+        if(std::abs(acma::math::fast::sqrt(w) / std::sqrt(static_cast<double>(w)) - 1) > 2e-7) return 1;
+    }
+    if(acma::math::fast::sqrt(0.f) != 0.f || acma::math::fast::atan2(0.f, 0.f) != 0.f) return 1;
+
+
+
 
     return 0;
 }
\ No newline at end of file
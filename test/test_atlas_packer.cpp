@@ -0,0 +1,79 @@
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <sirius/graphics/core/atlas_packer.hpp>
+
+
+namespace {
+    struct packed_rect {
+        acma::pt2u32 pos;
+        acma::sz2u32 size;
+    };
+
+    bool overlaps(packed_rect const& a, packed_rect const& b) {
+        return a.pos.x() < b.pos.x() + b.size.width() && b.pos.x() < a.pos.x() + a.size.width() &&
+               a.pos.y() < b.pos.y() + b.size.height() && b.pos.y() < a.pos.y() + a.size.height();
+    }
+
+    //Inserts a rect, checking that it lands inside the atlas without covering anything packed before it
+    std::optional<acma::pt2u32> insert_checked(acma::atlas_packer& packer, std::vector<packed_rect>& packed, acma::sz2u32 size, bool& valid) {
+        const std::optional<acma::pt2u32> pos = packer.insert(size);
+        if(!pos) return pos;
+        const packed_rect r{*pos, size};
+        if(r.pos.x() + r.size.width() > packer.extent().width() || r.pos.y() + r.size.height() > packer.extent().height()) valid = false;
+        for(packed_rect const& other : packed)
+            if(overlaps(r, other)) valid = false;
+        packed.push_back(r);
+        return pos;
+    }
+}
+
+
+//Equal rects that tile the atlas exactly fill all of it, and nothing fits after that
+bool exact_fill() {
+    acma::atlas_packer packer(acma::sz2u32{64, 64});
+    std::vector<packed_rect> packed;
+    bool valid = true;
+    for(std::size_t i = 0; i < 16; ++i)
+        if(!insert_checked(packer, packed, acma::sz2u32{16, 16}, valid)) return false;
+    if(!valid || packer.used_area() != 64 * 64) return false;
+    if(packer.insert(acma::sz2u32{1, 1})) return false;
+
+    //Empty rects take no space, so they still fit
+    const std::optional<acma::pt2u32> empty = packer.insert(acma::sz2u32{0, 5});
+    if(!empty || *empty != acma::pt2u32{} || packer.used_area() != 64 * 64) return false;
+
+    packer.clear();
+    const std::optional<acma::pt2u32> first = packer.insert(acma::sz2u32{64, 64});
+    return first && *first == acma::pt2u32{} && packer.used_area() == 64 * 64;
+}
+
+//Rects of glyph-like sizes never overlap or leave the atlas, and once one doesn't fit, neither does anything at least as large
+bool fill_until_full() {
+    acma::atlas_packer packer(acma::sz2u32{128, 96});
+    std::vector<packed_rect> packed;
+    bool valid = true;
+    std::uint64_t area = 0;
+    std::uint32_t state = 12345;
+    std::optional<acma::sz2u32> rejected;
+    for(std::size_t i = 0; i < 1000 && !rejected; ++i) {
+        state = state * 1664525u + 1013904223u;
+        const acma::sz2u32 size{3 + (state >> 8) % 30, 3 + (state >> 20) % 30};
+        if(insert_checked(packer, packed, size, valid)) area += std::uint64_t{size.width()} * size.height();
+        else rejected = size;
+    }
+    if(!valid || !rejected || packer.used_area() != area || area > std::uint64_t{128} * 96) return false;
+    if(packer.insert(*rejected) || packer.insert(acma::sz2u32{rejected->width() + 1, rejected->height() + 1})) return false;
+
+    //Wider or taller than the atlas never fits
+    return !packer.insert(acma::sz2u32{129, 1}) && !packer.insert(acma::sz2u32{1, 97});
+}
+
+
+int main() {
+    if(!exact_fill()) return 1;
+    if(!fill_until_full()) return 1;
+    return 0;
+}
@@ -0,0 +1,554 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <harfbuzz/hb.h>
+#include <msdfgen.h>
+#include <streamline/functional/functor/generic_stateless.hpp>
+#include <streamline/memory/unique_ptr.hpp>
+
+#include <sirius/core/decoder.hpp>
+#include <sirius/core/font.hpp>
+#include <sirius/core/glyph_cache.hpp>
+#include <sirius/core/hash.hpp>
+#include <sirius/core/initialize.hpp>
+#include <sirius/core/make.hpp>
+#include <sirius/core/render_instance.hpp>
+#include <sirius/core/thread_pool.hpp>
+#include <sirius/graphics/core/glyph_distance_field.hpp>
+
+#include "./asset_heap_config_table.hpp"
+#include "./buffer_config_table.hpp"
+#include "./timeline.hpp"
+
+
+#if __has_feature(address_sanitizer) || defined(__SANITIZE_ADDRESS__)
+extern "C" const char* __asan_default_options() { return "detect_leaks=0"; }
+#endif
+
+
+namespace {
+    using glyph_texture = std::array<std::byte, acma::decoder::font_texture::size_bytes>;
+
+    struct generated_glyphs {
+        std::vector<glyph_texture> glyphs;
+        std::vector<acma::decoder::glyph_extent> extents;
+
+    public:
+        explicit generated_glyphs(std::size_t count) : glyphs(count), extents(count) {}
+    };
+
+    //The same immutable font that decoder::decode_font generates from
+    struct test_font {
+        sl::unique_ptr<hb_blob_t, sl::functor::generic_stateless<hb_blob_destroy>> blob;
+        sl::unique_ptr<hb_face_t, sl::functor::generic_stateless<hb_face_destroy>> face;
+        sl::unique_ptr<hb_font_t, sl::functor::generic_stateless<hb_font_destroy>> font;
+
+    public:
+        explicit test_font(llfio::mapped_file_handle const& handle) :
+            blob(hb_blob_create(reinterpret_cast<char const*>(handle.address()), handle.maximum_extent().assume_value(), HB_MEMORY_MODE_DUPLICATE, nullptr, nullptr)),
+            face(hb_face_create(blob.get(), 0)),
+            font(hb_font_create(face.get())) {
+            hb_font_make_immutable(font.get());
+        }
+    };
+
+    bool same_glyphs(generated_glyphs const& lhs, std::size_t lhs_index, generated_glyphs const& rhs, std::size_t rhs_index) {
+        acma::decoder::glyph_extent const& a = lhs.extents[lhs_index];
+        acma::decoder::glyph_extent const& b = rhs.extents[rhs_index];
+        return a.size == b.size && a.origin == b.origin && lhs.glyphs[lhs_index] == rhs.glyphs[rhs_index];
+    }
+}
+
+namespace {
+    namespace font_texture = acma::decoder::font_texture;
+    using distance_texture = std::array<float, font_texture::size_bytes>;
+
+    //Draws a glyph into a msdfgen::Shape in em units, skipping zero-length edges the way decode_font's draw functions do
+    struct shape_context {
+        msdfgen::Shape shape;
+        double scale;
+    };
+
+    msdfgen::Point2 to_point(shape_context const& ctx, float x, float y) {
+        return msdfgen::Point2(x * ctx.scale, y * ctx.scale);
+    }
+
+    void move_to(hb_draw_funcs_t*, void* shape_ctx, hb_draw_state_t*, float, float, void*) {
+        msdfgen::Shape& shape = static_cast<shape_context*>(shape_ctx)->shape;
+        if(shape.contours.empty() || !shape.contours.back().edges.empty()) shape.addContour();
+    }
+
+    void line_to(hb_draw_funcs_t*, void* shape_ctx, hb_draw_state_t* st, float target_x, float target_y, void*) {
+        shape_context& ctx = *static_cast<shape_context*>(shape_ctx);
+        if(st->current_x != target_x || st->current_y != target_y)
+            ctx.shape.contours.back().addEdge(msdfgen::EdgeHolder(to_point(ctx, st->current_x, st->current_y), to_point(ctx, target_x, target_y)));
+    }
+
+    void quad_to(hb_draw_funcs_t*, void* shape_ctx, hb_draw_state_t* st, float control_x, float control_y, float target_x, float target_y, void*) {
+        shape_context& ctx = *static_cast<shape_context*>(shape_ctx);
+        if(st->current_x != target_x || st->current_y != target_y)
+            ctx.shape.contours.back().addEdge(msdfgen::EdgeHolder(to_point(ctx, st->current_x, st->current_y), to_point(ctx, control_x, control_y), to_point(ctx, target_x, target_y)));
+    }
+
+    void cubic_to(hb_draw_funcs_t*, void* shape_ctx, hb_draw_state_t* st, float first_control_x, float first_control_y, float second_control_x, float second_control_y, float target_x, float target_y, void*) {
+        shape_context& ctx = *static_cast<shape_context*>(shape_ctx);
+        const msdfgen::Point2 first_control = to_point(ctx, first_control_x, first_control_y);
+        const msdfgen::Point2 second_control = to_point(ctx, second_control_x, second_control_y);
+        if(st->current_x != target_x || st->current_y != target_y || msdfgen::crossProduct(first_control, second_control) != 0)
+            ctx.shape.contours.back().addEdge(msdfgen::EdgeHolder(
+                to_point(ctx, st->current_x, st->current_y), first_control, second_control, to_point(ctx, target_x, target_y)
+            ));
+    }
+
+    void set_draw_funcs(hb_draw_funcs_t* draw_funcs) {
+        hb_draw_funcs_set_move_to_func     (draw_funcs, move_to,  nullptr, nullptr);
+        hb_draw_funcs_set_line_to_func     (draw_funcs, line_to,  nullptr, nullptr);
+        hb_draw_funcs_set_quadratic_to_func(draw_funcs, quad_to,  nullptr, nullptr);
+        hb_draw_funcs_set_cubic_to_func    (draw_funcs, cubic_to, nullptr, nullptr);
+    }
+
+    //Prepares the shape like decode_font does (normalized and edge-colored), and copies its edges into outline
+    void outline_shape(msdfgen::Shape& shape, acma::glyph_outline& outline) {
+        if(!shape.contours.empty() && shape.contours.back().edges.empty()) shape.contours.pop_back();
+        shape.inverseYAxis = true;
+        shape.normalize();
+        msdfgen::edgeColoringSimple(shape, 3.0);
+
+        outline.clear();
+        for(msdfgen::Contour const& contour : shape.contours) {
+            outline.add_contour();
+            for(msdfgen::EdgeHolder const& edge : contour.edges) {
+                acma::glyph_edge e{.points = {}, .degree = static_cast<std::uint8_t>(edge->type()), .color = static_cast<std::uint8_t>(edge->color)};
+                for(std::size_t i = 0; i <= e.degree; ++i)
+                    e.points[i] = acma::pt2d{edge->controlPoints()[i].x, edge->controlPoints()[i].y};
+                outline.add_edge(e);
+            }
+        }
+    }
+
+    //How many distances differ by more than tolerance (in ems)
+    std::size_t count_mismatches(distance_texture const& lhs, distance_texture const& rhs, double tolerance) {
+        std::size_t ret = 0;
+        for(std::size_t i = 0; i < lhs.size(); ++i)
+            ret += !(std::fabs(static_cast<double>(lhs[i]) - rhs[i]) <= tolerance);
+        return ret;
+    }
+}
+
+
+//generate_glyphs across the thread pool matches generating serially (which it does when called from one of the pool's threads)
+//byte for byte, and a glyph comes out the same wherever it is in glyph_ids, since each one only writes its own slot
+bool parallel_glyphs_match_serial(hb_font_t* font) {
+    std::vector<unsigned int> glyph_ids(hb_face_get_glyph_count(hb_font_get_face(font)));
+    std::iota(glyph_ids.begin(), glyph_ids.end(), 0u);
+    if(glyph_ids.empty()) return false;
+
+    generated_glyphs parallel(glyph_ids.size());
+    if(!acma::decoder::generate_glyphs(font, glyph_ids, parallel.glyphs, parallel.extents).has_value()) return false;
+
+    generated_glyphs serial(glyph_ids.size());
+    const bool serial_generated = acma::thread_pool().submit_task([&]() noexcept {
+        return acma::decoder::generate_glyphs(font, glyph_ids, serial.glyphs, serial.extents).has_value();
+    }).get();
+    if(!serial_generated) return false;
+    for(std::size_t i = 0; i < glyph_ids.size(); ++i)
+        if(!same_glyphs(parallel, i, serial, i)) return false;
+
+    std::vector<unsigned int> reversed_ids(glyph_ids.rbegin(), glyph_ids.rend());
+    generated_glyphs reversed(reversed_ids.size());
+    if(!acma::decoder::generate_glyphs(font, reversed_ids, reversed.glyphs, reversed.extents).has_value()) return false;
+    for(std::size_t i = 0; i < reversed_ids.size(); ++i)
+        if(!same_glyphs(reversed, i, parallel, reversed_ids[i])) return false;
+
+    //Outputs shorter than glyph_ids are rejected before anything is written
+    if(acma::decoder::generate_glyphs(font, glyph_ids, std::span{parallel.glyphs}.first(glyph_ids.size() - 1), parallel.extents).has_value()) return false;
+    if(acma::decoder::generate_glyphs(font, glyph_ids, parallel.glyphs, std::span{parallel.extents}.first(glyph_ids.size() - 1)).has_value()) return false;
+
+    //Fewer glyphs than blocks
+    generated_glyphs single(1);
+    const unsigned int last_id = glyph_ids.back();
+    return acma::decoder::generate_glyphs(font, std::span{&last_id, 1}, single.glyphs, single.extents).has_value() && same_glyphs(single, 0, parallel, last_id);
+}
+
+
+//A glyph is queued once however often it's asked for, and is found after generate_pending, packed inside the atlas. In an atlas too small
+//for every glyph, generate_pending returns errc::atlas_full, and asking for the glyphs that didn't fit doesn't queue them again
+bool font_packs_requested_glyphs(llfio::mapped_file_handle const& font_file) {
+    //Room for four font_textures at most
+    constexpr std::uint32_t atlas_length = 2 * font_texture::length_pixels;
+    acma::result<acma::font> font_result = acma::font::create(font_file, atlas_length);
+    if(!font_result.has_value()) return false;
+    acma::font font = *std::move(font_result);
+    const std::uint32_t glyph_count = static_cast<std::uint32_t>(font.glyph_count());
+    if(glyph_count < 2) return false;
+
+    if(font.find(glyph_count) != nullptr || font.has_pending()) return false;
+    if(font.find(1) != nullptr || font.find(1) != nullptr || !font.has_pending()) return false;
+    if(!font.generate_pending().has_value() || font.has_pending()) return false;
+    if(font.find(1) == nullptr || font.has_pending()) return false;
+
+    for(std::uint32_t id = 0; id < glyph_count; ++id) font.find(id);
+    const acma::result<void> full = font.generate_pending();
+    if(full.has_value() || full.error() != acma::errc::atlas_full) return false;
+
+    std::size_t dropped = 0;
+    for(std::uint32_t id = 0; id < glyph_count; ++id) {
+        acma::font_glyph const* const glyph = font.find(id);
+        if(glyph == nullptr) {
+            ++dropped;
+            continue;
+        }
+        acma::rect<std::uint32_t> const& r = glyph->atlas_rect;
+        if(r.x() + r.width() > atlas_length || r.y() + r.height() > atlas_length) return false;
+    }
+    //Nothing left to generate next frame
+    return dropped != 0 && !font.has_pending() && font.generate_pending().has_value();
+}
+
+
+//A zero-length line (which decode_font never draws, but an outline may still hold) measures from its point instead of making
+//every distance NaN
+bool zero_length_line_is_finite() {
+    constexpr std::array<acma::pt2d, 4> corners{{{.25, .25}, {.75, .25}, {.75, .75}, {.25, .75}}};
+    acma::glyph_outline outline;
+    outline.add_contour();
+    for(std::size_t i = 0; i < corners.size(); ++i) {
+        outline.add_edge(acma::glyph_edge{.points = {corners[i], corners[(i + 1) % corners.size()], acma::pt2d{}, acma::pt2d{}}, .degree = 1, .color = acma::edge_color::white});
+        if(i == 1) outline.add_edge(acma::glyph_edge{.points = {corners[2], corners[2], acma::pt2d{}, acma::pt2d{}}, .degree = 1, .color = acma::edge_color::white});
+    }
+
+    acma::glyph_distance_field<font_texture::length_pixels> culled;
+    acma::glyph_distance_field<font_texture::length_pixels, 4, false> unculled;
+    distance_texture culled_distances, unculled_distances;
+    culled.evaluate(outline, font_texture::glyph_scale, acma::pt2d{}, culled_distances);
+    unculled.evaluate(outline, font_texture::glyph_scale, acma::pt2d{}, unculled_distances);
+    for(std::size_t i = 0; i < culled_distances.size(); ++i)
+        if(!std::isfinite(culled_distances[i]) || !std::isfinite(unculled_distances[i])) return false;
+    return count_mismatches(culled_distances, unculled_distances, 0) == 0;
+}
+
+//On every glyph of the font, culling edges per tile (for any tile size) gives the same distances as testing every edge, and both
+//give msdfgen's (generateMTSDF before error correction, which decode_font still leaves to msdfgen). msdfgen solves cubics
+//iteratively, so it only has to agree to within a fraction of a texel, and ties between equally near edges may pick different channels
+bool distance_fields_match_msdfgen(hb_font_t* font) {
+    constexpr double texel_em = 1. / font_texture::glyph_scale;
+    const unsigned int glyph_count = hb_face_get_glyph_count(hb_font_get_face(font));
+    if(glyph_count == 0) return false;
+
+    sl::unique_ptr<hb_draw_funcs_t, sl::functor::generic_stateless<hb_draw_funcs_destroy>> draw_funcs(hb_draw_funcs_create());
+    set_draw_funcs(draw_funcs.get());
+
+    acma::glyph_distance_field<font_texture::length_pixels> culled;
+    acma::glyph_distance_field<font_texture::length_pixels, 8> culled_wide;
+    acma::glyph_distance_field<font_texture::length_pixels, 4, false> unculled;
+    const msdfgen::MSDFGeneratorConfig config(true, msdfgen::ErrorCorrectionConfig(msdfgen::ErrorCorrectionConfig::DISABLED));
+    msdfgen::Bitmap<float, 4> bitmap(font_texture::length_pixels, font_texture::length_pixels);
+    acma::glyph_outline outline;
+    distance_texture culled_distances, culled_wide_distances, unculled_distances, msdfgen_distances;
+    std::size_t msdfgen_mismatches = 0;
+    for(unsigned int id = 0; id < glyph_count; ++id) {
+        shape_context ctx{.shape = {}, .scale = 1. / hb_face_get_upem(hb_font_get_face(font))};
+        if(!hb_font_draw_glyph_or_fail(font, id, draw_funcs.get(), &ctx)) return false;
+        outline_shape(ctx.shape, outline);
+
+        //The glyph's bottom left corner, padded, at the texture's origin like in decode_font
+        const msdfgen::Shape::Bounds b = ctx.shape.getBounds();
+        const acma::pt2d translate{b.l - font_texture::padding_em, b.b - font_texture::padding_em};
+
+        culled.evaluate(outline, font_texture::glyph_scale, translate, culled_distances);
+        culled_wide.evaluate(outline, font_texture::glyph_scale, translate, culled_wide_distances);
+        unculled.evaluate(outline, font_texture::glyph_scale, translate, unculled_distances);
+        if(count_mismatches(culled_distances, unculled_distances, 1e-9) != 0) return false;
+        if(count_mismatches(culled_wide_distances, unculled_distances, 1e-9) != 0) return false;
+
+        //With a range of one em, msdfgen stores the distance plus .5
+        msdfgen::generateMTSDF(bitmap, ctx.shape, msdfgen::Projection(font_texture::glyph_scale, msdfgen::Vector2(-translate.x(), -translate.y())), msdfgen::Range(1), config);
+        for(std::size_t i = 0; i < msdfgen_distances.size(); ++i)
+            msdfgen_distances[i] = static_cast<float*>(bitmap)[i] - .5f;
+        msdfgen_mismatches += count_mismatches(unculled_distances, msdfgen_distances, texel_em / 64);
+    }
+    return msdfgen_mismatches * 1000 <= std::size_t{glyph_count} * font_texture::size_bytes;
+}
+
+
+namespace {
+    using glyph_render_instance = acma::render_instance<acma::test::glyph_timeline, buffer_configs, asset_heap_configs>;
+}
+
+//The glyphs a font leaves for shaders/generate_glyphs.comp come out of its atlas with the distances glyph_distance_field gives (before error
+//correction, which the shader skips), to within a level of the RGBA8 atlas. The shader works in single precision, so ties between equally
+//near edges may still pick different channels. Skipped without a device that can write to storage images (lavapipe can)
+bool gpu_glyphs_match_cpu(llfio::mapped_file_handle const& font_file, hb_font_t* hb_font) {
+    if(!acma::intitialize_lib("Sirius Font Test", acma::version{1, 0, 0}).has_value()) return true;
+    const auto device = std::ranges::find_if(acma::devices(), [](acma::vk::physical_device const& d) { return d.supports_storage_image(VK_FORMAT_R8G8B8A8_UNORM); });
+    if(device == acma::devices().end()) return true;
+
+    acma::result<glyph_render_instance> inst_result = acma::make<glyph_render_instance>(*device, true);
+    if(!inst_result.has_value()) return false;
+    glyph_render_instance inst = *std::move(inst_result);
+    auto& heap = sl::universal::get<asset_heap_id::compute>(inst);
+
+    acma::result<acma::font> font_result = acma::font::create(font_file);
+    if(!font_result.has_value()) return false;
+    acma::font font = *std::move(font_result);
+    if(!font.use_gpu(*device)) return false;
+    if(!font.upload(heap, sl::universal::get<buffer_id::texture_staging>(inst)).has_value()) return false;
+
+    //Few enough to fit in the atlas whatever their size
+    const std::uint32_t glyph_count = std::min<std::uint32_t>(font.glyph_count(), 128);
+    for(std::uint32_t id = 0; id < glyph_count; ++id) font.find(id);
+    if(!font.generate_pending().has_value() || font.gpu_glyphs().empty()) return false;
+
+    acma::glyph_edge_buffer const& batch = font.gpu_glyphs();
+    auto& edges = sl::universal::get<buffer_id::glyph_edges>(inst);
+    if(!edges.resize(batch.size_bytes()).has_value()) return false;
+    batch.write(edges.data());
+    const acma::glyph_generation_constants constants = batch.constants(edges.gpu_address());
+    std::memcpy(sl::universal::get<buffer_id::glyph_constants>(inst).data(), &constants, sizeof(constants));
+    auto& dispatch_commands = sl::universal::get<buffer_id::glyph_dispatch_commands>(inst);
+    dispatch_commands.clear();
+    if(!dispatch_commands.template try_emplace_back<acma::dispatch_command_t>(batch.dispatch_command()).has_value()) return false;
+
+    if(!inst.render().has_value() || !inst.join().has_value()) return false;
+    auto& readback = sl::universal::get<buffer_id::glyph_readback>(inst);
+    if(!heap.download(readback, font.image_index()).has_value()) return false;
+    std::byte const* const atlas = std::as_const(readback).data();
+
+    sl::unique_ptr<hb_draw_funcs_t, sl::functor::generic_stateless<hb_draw_funcs_destroy>> draw_funcs(hb_draw_funcs_create());
+    set_draw_funcs(draw_funcs.get());
+    acma::glyph_distance_field<font_texture::length_pixels> distance_field;
+    acma::glyph_outline outline;
+    distance_texture distances;
+    constexpr std::size_t channels = font_texture::channels;
+    std::size_t compared = 0, mismatches = 0;
+    for(std::uint32_t id = 0; id < glyph_count; ++id) {
+        acma::font_glyph const* const glyph = font.find(id);
+        if(glyph == nullptr) return false;
+        acma::rect<std::uint32_t> const& r = glyph->atlas_rect;
+        if(r.width() == 0 || r.height() == 0) continue;
+
+        //Drawn like the font's glyph was, and evaluated at the same texels: the extent covers the bottom-left corner of the font_texture
+        shape_context ctx{.shape = {}, .scale = 1. / hb_face_get_upem(hb_font_get_face(hb_font))};
+        if(!hb_font_draw_glyph_or_fail(hb_font, id, draw_funcs.get(), &ctx)) return false;
+        outline_shape(ctx.shape, outline);
+        distance_field.evaluate(outline, font_texture::glyph_scale, acma::pt2d{glyph->origin.x(), glyph->origin.y()}, distances);
+
+        const std::size_t first_row = font_texture::length_pixels - r.height();
+        for(std::uint32_t row = 0; row < r.height(); ++row)
+            for(std::size_t i = 0; i < r.width() * channels; ++i) {
+                const double expected = std::clamp(distances[(first_row + row) * font_texture::length_pixels * channels + i] / font_texture::distance_range + .5, 0., 1.);
+                const std::byte actual = atlas[((static_cast<std::size_t>(r.y()) + row) * acma::font::default_atlas_length_pixels + r.x()) * channels + i];
+                mismatches += !(std::fabs(std::to_integer<int>(actual) / 255. - expected) <= 1. / 255);
+                ++compared;
+            }
+    }
+    return compared != 0 && mismatches * 1000 <= compared;
+}
+
+
+namespace {
+    //The cache file's layout: a header page, then a 32 byte entry per glyph, then the bitmaps, each on its own pages
+    struct cache_layout {
+        std::uint64_t page_size = llfio::utils::page_size();
+        std::uint64_t entries_offset = page_size;
+        std::uint64_t glyphs_offset;
+        std::uint64_t glyph_stride = page_align(font_texture::size_bytes);
+        std::uint64_t file_size;
+
+    public:
+        explicit cache_layout(std::uint32_t glyph_count) :
+            glyphs_offset(entries_offset + page_align(std::uint64_t{glyph_count} * 32)),
+            file_size(glyphs_offset + glyph_count * glyph_stride) {}
+
+        std::uint64_t page_align(std::uint64_t n) const { return (n + page_size - 1) / page_size * page_size; }
+        std::uint64_t entry_offset(std::uint32_t glyph_id) const { return entries_offset + std::uint64_t{glyph_id} * 32; }
+        std::uint64_t glyph_offset(std::uint32_t glyph_id) const { return glyphs_offset + glyph_id * glyph_stride; }
+    };
+
+    constexpr std::uint32_t cache_glyph_count = 3;
+    constexpr std::array<std::byte, 37> cache_font_bytes = []{
+        std::array<std::byte, 37> ret;
+        for(std::size_t i = 0; i < ret.size(); ++i) ret[i] = static_cast<std::byte>(i * 13 + 1);
+        return ret;
+    }();
+
+    std::filesystem::path fresh_directory(char const* name) {
+        const std::filesystem::path ret = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(ret);
+        std::filesystem::create_directories(ret);
+        return ret;
+    }
+
+    //The directory's only cache file, or an empty path
+    std::filesystem::path cache_file(std::filesystem::path const& directory) {
+        std::filesystem::path ret;
+        for(std::filesystem::directory_entry const& entry : std::filesystem::directory_iterator(directory)) {
+            if(entry.path().extension() != ".msdf") continue;
+            if(!ret.empty()) return {};
+            ret = entry.path();
+        }
+        return ret;
+    }
+
+    std::vector<std::byte> read_file(std::filesystem::path const& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::vector<std::byte> ret(std::filesystem::file_size(path));
+        file.read(reinterpret_cast<char*>(ret.data()), static_cast<std::streamsize>(ret.size()));
+        return file ? ret : std::vector<std::byte>{};
+    }
+
+    //Writes straight to the file, as another process (or a crash) would
+    template<typename T>
+    bool overwrite(std::filesystem::path const& path, std::uint64_t offset, T const& value) {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.write(reinterpret_cast<char const*>(&value), sizeof(value));
+        return static_cast<bool>(file.flush());
+    }
+
+    template<typename T>
+    T read_at(std::vector<std::byte> const& file, std::uint64_t offset) {
+        T ret{};
+        if(offset + sizeof(T) <= file.size()) std::memcpy(&ret, file.data() + offset, sizeof(T));
+        return ret;
+    }
+
+    glyph_texture cache_glyph(unsigned int salt) {
+        glyph_texture ret;
+        for(std::size_t i = 0; i < ret.size(); ++i) ret[i] = static_cast<std::byte>(i * 7 + salt);
+        return ret;
+    }
+
+    constexpr acma::decoder::glyph_extent cache_extent{.size = {20, 24}, .origin = {-.25f, .5f}};
+
+    bool loads(acma::glyph_cache const& cache, std::uint32_t glyph_id, glyph_texture const& expected) {
+        glyph_texture glyph;
+        acma::decoder::glyph_extent extent;
+        return cache.load(glyph_id, glyph, extent) && glyph == expected && extent.size == cache_extent.size && extent.origin == cache_extent.origin;
+    }
+
+    bool misses(acma::glyph_cache const& cache, std::uint32_t glyph_id) {
+        glyph_texture glyph;
+        acma::decoder::glyph_extent extent;
+        return !cache.load(glyph_id, glyph, extent);
+    }
+}
+
+
+//A stored glyph loads back, and lands where the layout says: the header (named after the font's hash) up front, its entry in the
+//table, and its bitmap on its own pages. Glyphs never stored read as missing and stay zero
+bool glyph_cache_layout() {
+    const std::filesystem::path directory = fresh_directory("sirius_test_glyph_cache_layout");
+    acma::result<acma::glyph_cache> cache = acma::glyph_cache::create(directory, cache_font_bytes, cache_glyph_count);
+    if(!cache.has_value() || cache->glyph_count() != cache_glyph_count) return false;
+    if(!misses(*cache, 1)) return false;
+
+    const glyph_texture glyph = cache_glyph(1);
+    cache->store(1, glyph, cache_extent);
+    if(!loads(*cache, 1, glyph) || !misses(*cache, 0) || !misses(*cache, 2) || !misses(*cache, cache_glyph_count)) return false;
+
+    const std::filesystem::path path = cache_file(directory);
+    std::array<char, 17> font_hash;
+    std::snprintf(font_hash.data(), font_hash.size(), "%016llx", static_cast<unsigned long long>(acma::impl::hash_bytes(cache_font_bytes)));
+    if(path.empty() || !path.filename().string().starts_with(font_hash.data())) return false;
+
+    const cache_layout layout(cache_glyph_count);
+    const std::vector<std::byte> file = read_file(path);
+    if(file.size() != layout.file_size) return false;
+    if(read_at<std::uint64_t>(file, 0) != 0x0046'4453'4d52'4953ull || read_at<std::uint32_t>(file, 8) != acma::glyph_cache::format_version) return false;
+    if(read_at<std::uint32_t>(file, 12) != layout.page_size) return false;
+
+    //state (published, so even and non-zero), glyph ID, size
+    const std::uint32_t state = read_at<std::uint32_t>(file, layout.entry_offset(1));
+    if(state == 0 || state % 2 != 0) return false;
+    if(read_at<std::uint32_t>(file, layout.entry_offset(1) + 4) != 1) return false;
+    if(read_at<std::uint32_t>(file, layout.entry_offset(1) + 8) != 20 || read_at<std::uint32_t>(file, layout.entry_offset(1) + 12) != 24) return false;
+    if(!std::equal(glyph.begin(), glyph.end(), file.begin() + static_cast<std::ptrdiff_t>(layout.glyph_offset(1)))) return false;
+
+    for(std::uint32_t id : {0u, 2u}) {
+        if(read_at<std::array<std::byte, 32>>(file, layout.entry_offset(id)) != std::array<std::byte, 32>{}) return false;
+        const auto bitmap = file.begin() + static_cast<std::ptrdiff_t>(layout.glyph_offset(id));
+        if(std::any_of(bitmap, bitmap + font_texture::size_bytes, [](std::byte b) { return b != std::byte{0}; })) return false;
+    }
+    return true;
+}
+
+//A file with a mismatching header (here, another format version) is rebuilt empty and swapped in under the same name, while a cache
+//that still maps the old file keeps working
+bool stale_glyph_cache_is_rebuilt() {
+    const std::filesystem::path directory = fresh_directory("sirius_test_glyph_cache_stale");
+    acma::result<acma::glyph_cache> old_cache = acma::glyph_cache::create(directory, cache_font_bytes, cache_glyph_count);
+    if(!old_cache.has_value()) return false;
+    const glyph_texture glyph = cache_glyph(2);
+    old_cache->store(1, glyph, cache_extent);
+
+    //Reopening an intact file keeps its glyphs
+    acma::result<acma::glyph_cache> reopened = acma::glyph_cache::create(directory, cache_font_bytes, cache_glyph_count);
+    if(!reopened.has_value() || !loads(*reopened, 1, glyph)) return false;
+
+    const std::filesystem::path path = cache_file(directory);
+    if(path.empty() || !overwrite(path, 8, acma::glyph_cache::format_version + 1)) return false;
+
+    acma::result<acma::glyph_cache> rebuilt = acma::glyph_cache::create(directory, cache_font_bytes, cache_glyph_count);
+    if(!rebuilt.has_value() || !misses(*rebuilt, 1)) return false;
+    if(cache_file(directory) != path) return false;
+    const std::vector<std::byte> file = read_file(path);
+    if(file.size() != cache_layout(cache_glyph_count).file_size || read_at<std::uint32_t>(file, 8) != acma::glyph_cache::format_version) return false;
+
+    rebuilt->store(1, glyph, cache_extent);
+    return loads(*rebuilt, 1, glyph) && loads(*old_cache, 1, glyph);
+}
+
+//A corrupt bitmap or entry, or one left mid-store (odd state) by a crash, reads as missing until the glyph is stored again
+bool corrupt_glyph_cache_entry_misses() {
+    const std::filesystem::path directory = fresh_directory("sirius_test_glyph_cache_corrupt");
+    acma::result<acma::glyph_cache> cache = acma::glyph_cache::create(directory, cache_font_bytes, cache_glyph_count);
+    if(!cache.has_value()) return false;
+    const glyph_texture glyph = cache_glyph(3);
+    const std::filesystem::path path = cache_file(directory);
+    const cache_layout layout(cache_glyph_count);
+    if(path.empty()) return false;
+
+    cache->store(2, glyph, cache_extent);
+    if(!loads(*cache, 2, glyph)) return false;
+    if(!overwrite(path, layout.glyph_offset(2) + 100, ~glyph[100]) || !misses(*cache, 2)) return false;
+
+    cache->store(2, glyph, cache_extent);
+    if(!loads(*cache, 2, glyph)) return false;
+    //Another glyph's ID
+    if(!overwrite(path, layout.entry_offset(2) + 4, std::uint32_t{1}) || !misses(*cache, 2)) return false;
+
+    cache->store(2, glyph, cache_extent);
+    const std::uint32_t state = read_at<std::uint32_t>(read_file(path), layout.entry_offset(2));
+    if(!overwrite(path, layout.entry_offset(2), state | 1) || !misses(*cache, 2)) return false;
+
+    cache->store(2, glyph, cache_extent);
+    return loads(*cache, 2, glyph);
+}
+
+
+int main() {
+    if(!glyph_cache_layout()) return 1;
+    if(!stale_glyph_cache_is_rebuilt()) return 1;
+    if(!corrupt_glyph_cache_entry_misses()) return 1;
+
+    const std::filesystem::path assets_path = std::filesystem::canonical(std::filesystem::path("../../test/assets"));
+    acma::result<llfio::mapped_file_handle> font_file = acma::decoder::open_file(assets_path / "test_font.ttf");
+    if(!font_file.has_value()) return 1;
+    const test_font font(*font_file);
+
+    if(!font_packs_requested_glyphs(*font_file)) return 1;
+    if(!zero_length_line_is_finite()) return 1;
+    if(!distance_fields_match_msdfgen(font.font.get())) return 1;
+    if(!parallel_glyphs_match_serial(font.font.get())) return 1;
+    if(!gpu_glyphs_match_cpu(*font_file, font.font.get())) return 1;
+    return 0;
+}
@@ -0,0 +1,515 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <sirius/input/binding_map.hpp>
+#include <sirius/input/coalescing.hpp>
+#include <sirius/input/code.hpp>
+#include <sirius/input/combination.hpp>
+#include <sirius/input/combination_state.hpp>
+#include <sirius/input/event_fns_map.hpp>
+#include <sirius/input/event_queue.hpp>
+#include <sirius/input/event_set.hpp>
+#include <sirius/input/input_state.hpp>
+#include <sirius/input/late_latch.hpp>
+#include <sirius/input/recording.hpp>
+
+
+namespace {
+    //combination's operator<=> returns a bool, so std::map needs its own ordering
+    struct combination_less {
+        bool operator()(acma::input::combination const& lhs, acma::input::combination const& rhs) const noexcept {
+            return std::memcmp(lhs.data(), rhs.data(), acma::input::combination_size) < 0;
+        }
+    };
+    using reference_binding_map = std::map<acma::input::combination, acma::input::event_set, combination_less>;
+
+    bool same_events(acma::input::event_set const& lhs, acma::input::event_set const& rhs) {
+        return lhs.event_ids == rhs.event_ids && lhs.applicable_categories == rhs.applicable_categories;
+    }
+
+    bool same_bindings(acma::input::binding_map const& map, reference_binding_map const& reference, std::vector<acma::input::combination> const& keys) {
+        if(map.size() != reference.size() || map.empty() != reference.empty()) return false;
+        for(acma::input::combination const& key : keys) {
+            const auto it = map.find(key);
+            const auto ref = reference.find(key);
+            if((it == map.end()) != (ref == reference.end()) || map.contains(key) != (ref != reference.end())) return false;
+            if(it != map.end() && (!(it->first == key) || !same_events(it->second, ref->second))) return false;
+        }
+        //Every entry is reachable by iteration exactly once
+        std::size_t iterated = 0;
+        for(auto const& [key, events] : map) {
+            const auto ref = reference.find(key);
+            if(ref == reference.end() || !same_events(events, ref->second)) return false;
+            ++iterated;
+        }
+        return iterated == reference.size();
+    }
+}
+
+
+//binding_map against std::map: random inserts, assignments and erases (including ones that move the last entry, and keys that
+//were never inserted), before and after freezing
+bool binding_map_matches_std_map() {
+    std::mt19937 rng(1234);
+    std::vector<acma::input::combination> keys;
+    while(keys.size() < 300) {
+        acma::input::combination c{{}, static_cast<acma::input::code_t>(acma::input::key_code::kb_a + rng() % 60)};
+        for(std::size_t m = rng() % 4; m > 0; --m) c.set(static_cast<acma::input::code_t>(acma::input::key_code::kb_left_ctrl + rng() % 8));
+        if(std::find(keys.begin(), keys.end(), c) == keys.end()) keys.push_back(c);
+    }
+    const auto random_events = [&rng]() {
+        acma::input::event_set ret{};
+        for(auto& id : ret.event_ids) id = static_cast<acma::input::event_id_t>(rng() % 1000);
+        ret.applicable_categories = static_cast<acma::input::category_flags_t>(rng() % 16);
+        return ret;
+    };
+
+    acma::input::binding_map map;
+    reference_binding_map reference;
+    for(std::size_t round = 0; round < 3; ++round) {
+        for(std::size_t op = 0; op < 4000; ++op) {
+            acma::input::combination const& key = keys[rng() % keys.size()];
+            const acma::input::event_set events = random_events();
+            switch(rng() % 5) {
+            case 0: {
+                const bool inserted = map.try_emplace(key, events).second;
+                if(inserted != reference.try_emplace(key, events).second) return false;
+                break;
+            }
+            case 1: {
+                const bool inserted = map.insert_or_assign(key, events).second;
+                if(inserted != reference.insert_or_assign(key, events).second) return false;
+                break;
+            }
+            case 2:
+                map[key] = events;
+                reference[key] = events;
+                break;
+            case 3:
+            case 4:
+                if(map.erase(key) != reference.erase(key)) return false;
+                break;
+            }
+            if(op % 500 == 0 && !same_bindings(map, reference, keys)) return false;
+        }
+        if(!same_bindings(map, reference, keys)) return false;
+
+        //A frozen map finds the same bindings, keeps them through erases and unfreezes on a new insert
+        map.freeze();
+        if(!map.frozen() || !same_bindings(map, reference, keys)) return false;
+        for(std::size_t i = 0; i < keys.size(); i += 7)
+            if(map.erase(keys[i]) != reference.erase(keys[i])) return false;
+        if(!same_bindings(map, reference, keys)) return false;
+        for(acma::input::combination const& key : keys) {
+            if(reference.contains(key)) continue;
+            map[key] = reference[key] = random_events();
+            break;
+        }
+        if(!same_bindings(map, reference, keys)) return false;
+    }
+
+    map.clear();
+    reference.clear();
+    map.reserve(1000);
+    if(!same_bindings(map, reference, keys)) return false;
+    acma::input::binding_map listed{{keys[0], random_events()}, {keys[1], random_events()}, {keys[0], random_events()}};
+    return listed.size() == 2 && listed.contains(keys[0]) && listed.contains(keys[1]) && !listed.contains(keys[2]);
+}
+
+
+//event_queue: FIFO order, refusing pushes when full rather than overwriting, and only the first of a burst of pushes scheduling a drain
+bool event_queue_orders_and_bounds() {
+    const auto make_record = [](std::size_t i) {
+        return acma::input::event_record{{}, static_cast<std::uint32_t>(i), static_cast<acma::input::code_t>(i % 256), acma::input::input_action::press, false};
+    };
+
+    acma::input::event_queue queue;
+    std::size_t scheduled = 0;
+    for(std::size_t i = 0; i < acma::input::event_queue::capacity; ++i) {
+        if(!queue.push(make_record(i))) return false;
+        scheduled += queue.request_drain();
+    }
+    if(scheduled != 1 || queue.push(make_record(0))) return false;
+
+    std::vector<std::uint32_t> drained;
+    std::size_t idles = 0;
+    queue.drain([&drained](std::span<acma::input::event_record const> batch) noexcept {
+        for(acma::input::event_record const& record : batch) drained.push_back(record.time_us);
+    }, [&idles]() noexcept { ++idles; });
+    if(drained.size() != acma::input::event_queue::capacity || idles != 1) return false;
+    for(std::size_t i = 0; i < drained.size(); ++i)
+        if(drained[i] != i) return false;
+
+    //Drained, so the next push schedules a new drain, and the freed cells are reused
+    std::array<acma::input::event_record, 4> popped;
+    if(!queue.push(make_record(7)) || !queue.request_drain() || queue.pop(popped) != 1 || popped[0].time_us != 7) return false;
+    return queue.pop(popped) == 0;
+}
+
+//event_queue with several producers and a consumer draining as they push: nothing is lost or duplicated, and each producer's
+//records come out in the order it pushed them
+bool event_queue_multi_producer() {
+    constexpr std::size_t producers = 4;
+    constexpr std::size_t per_producer = 20000;
+
+    acma::input::event_queue queue;
+    std::atomic<std::size_t> drains_requested = 0;
+    std::vector<std::thread> threads;
+    for(std::size_t p = 0; p < producers; ++p)
+        threads.emplace_back([&queue, &drains_requested, p]() {
+            for(std::size_t i = 0; i < per_producer; ++i) {
+                const acma::input::event_record record{{}, static_cast<std::uint32_t>(i), static_cast<acma::input::code_t>(p), acma::input::input_action::press, false};
+                while(!queue.push(record)) std::this_thread::yield();
+                if(queue.request_drain()) drains_requested.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+
+    std::array<std::size_t, producers> next{};
+    bool in_order = true;
+    std::size_t drains_run = 0;
+    for(std::size_t total = 0; total < producers * per_producer;) {
+        if(drains_requested.load(std::memory_order_acquire) == drains_run) {
+            std::this_thread::yield();
+            continue;
+        }
+        ++drains_run;
+        queue.drain([&](std::span<acma::input::event_record const> batch) noexcept {
+            for(acma::input::event_record const& record : batch) {
+                in_order &= record.code < producers && record.time_us == next[record.code]++;
+                ++total;
+            }
+        });
+    }
+    for(std::thread& t : threads) t.join();
+    //A push can be popped before it's counted, and its count then schedules a drain that finds nothing left
+    for(; drains_run < drains_requested.load(); ++drains_run)
+        queue.drain([&in_order](std::span<acma::input::event_record const>) noexcept { in_order = false; });
+
+    std::array<acma::input::event_record, 1> left;
+    return in_order && queue.pop(left) == 0
+        && std::all_of(next.begin(), next.end(), [](std::size_t n) { return n == per_producer; });
+}
+
+
+//coalescer: when each mode splits a run of motion, and how moves (latest position, distance since the last flush) and scrolls
+//(summed deltas) are merged
+bool coalescer_merge_rules() {
+    using namespace std::chrono_literals;
+    const auto motion = [](double x, double y, std::uint32_t time_us) {
+        return acma::input::event_record{{x, y}, time_us, acma::input::mouse_code::move, acma::input::input_action::press_release, true};
+    };
+    if(acma::input::coalesce_policy{}.mode != acma::input::coalesce_mode::off) return false;
+
+    acma::input::impl::coalescer pending;
+    const acma::input::coalesce_policy off{acma::input::coalesce_mode::off, 1000us};
+    const acma::input::coalesce_policy per_frame{acma::input::coalesce_mode::per_frame, 1000us};
+    const acma::input::coalesce_policy per_interval{acma::input::coalesce_mode::per_interval, 1000us};
+    //Nothing to split from while empty
+    if(pending.pending() || pending.splits(motion(0, 0, 0), off) || pending.splits(motion(0, 0, 0), per_interval)) return false;
+
+    pending.add(motion(1, 2, 100));
+    if(!pending.pending() || !pending.splits(motion(0, 0, 101), off) || pending.splits(motion(0, 0, 1'000'000), per_frame)) return false;
+    //per_interval splits once a record is `interval` past the first merged one
+    if(pending.splits(motion(0, 0, 1099), per_interval) || !pending.splits(motion(0, 0, 1100), per_interval)) return false;
+
+    pending.add(motion(4, 6, 600));
+    pending.add(motion(5, 4, 900));
+    acma::input::pointer_motion merged = pending.merged(false);
+    //The first flush has no previous position to measure the distance from
+    if(merged.position != acma::pt2d{5, 4} || merged.delta != acma::vec2<double>{} || merged.raw_history.size() != 3 || merged.raw_history[1].aux != acma::pt2d{4, 6}) return false;
+    pending.clear();
+    if(pending.pending()) return false;
+
+    pending.add(motion(7, 9, 2000));
+    merged = pending.merged(false);
+    if(merged.position != acma::pt2d{7, 9} || merged.delta != acma::vec2<double>{2, 5} || merged.raw_history.size() != 1) return false;
+    pending.clear();
+
+    //Also across the time_us wrap-around
+    acma::input::impl::coalescer wrapped;
+    wrapped.add(motion(0, 0, 0xFFFF'FF00));
+    if(wrapped.splits(motion(0, 0, 0x100), per_interval) || !wrapped.splits(motion(0, 0, 0x300 + 1000), per_interval)) return false;
+
+    acma::input::impl::coalescer scroll;
+    for(double d : {1., -3., 0.5}) scroll.add(acma::input::event_record{{d, 2 * d}, 0, acma::input::mouse_code::scroll, acma::input::input_action::press_release, true});
+    merged = scroll.merged(true);
+    return merged.position == acma::pt2d{-1.5, -3} && merged.delta == acma::vec2<double>{-1.5, -3} && merged.raw_history.size() == 3;
+}
+
+
+//combination_state: readers racing the writer only ever see a combination it stored, never a mix of two (every word of each stored
+//combination holds the same value, so a torn read shows up as differing words)
+bool combination_state_is_never_torn() {
+    using words = std::array<std::uint64_t, acma::input::combination_state::word_count>;
+    const auto make = [](std::uint64_t i) {
+        words w;
+        w.fill(i * 0x9E37'79B9'7F4A'7C15ull);
+        return std::bit_cast<acma::input::combination>(w);
+    };
+
+    acma::input::combination_state state;
+    std::atomic<bool> done = false;
+    std::atomic<bool> torn = false;
+    std::vector<std::thread> readers;
+    for(std::size_t r = 0; r < 3; ++r)
+        readers.emplace_back([&]() {
+            while(!done.load(std::memory_order_relaxed)) {
+                const words w = std::bit_cast<words>(state.load());
+                if(std::any_of(w.begin(), w.end(), [&w](std::uint64_t x) { return x != w[0]; })) torn.store(true);
+            }
+        });
+    //Long enough for the readers to be scheduled in the middle of stores, even on a single core
+    const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    std::uint64_t i = 0;
+    while(std::chrono::steady_clock::now() < until)
+        for(std::uint64_t n = 0; n < 1000; ++n) state.store(make(++i));
+    done.store(true);
+    for(std::thread& t : readers) t.join();
+
+    return !torn.load() && state.load() == make(i) && state.last_stored() == make(i);
+}
+
+
+//Recordings: encode/decode round trips every field (including the time_us wrap-around, and aux bit patterns when there is one), the layout matches
+//recording_format, and truncated or corrupt recordings are rejected rather than read past the end
+bool recording_round_trips() {
+    std::mt19937 rng(99);
+    std::vector<acma::input::event_record> records;
+    std::uint32_t time_us = 0xFFFF'0000;
+    for(std::size_t i = 0; i < 2000; ++i) {
+        time_us += rng() % 3 == 0 ? rng() : rng() % 5000;
+        const bool has_aux = rng() % 2;
+        const acma::pt2d aux = has_aux ? acma::pt2d{std::bit_cast<double>(static_cast<std::uint64_t>(rng()) << 32 | rng()), -0.0} : acma::pt2d{};
+        records.push_back({aux, time_us, static_cast<acma::input::code_t>(rng() % 256), static_cast<std::uint8_t>(rng() % 4), has_aux});
+    }
+
+    const std::vector<std::byte> bytes = acma::input::encode_recording(records);
+    if(bytes.size() < acma::input::recording_format::header_size || std::memcmp(bytes.data(), acma::input::recording_format::magic.data(), 8) != 0) return false;
+    if(static_cast<std::uint8_t>(bytes[8]) != acma::input::recording_format::version || static_cast<std::uint8_t>(bytes[12]) != (records.size() & 0xff)) return false;
+
+    auto decoded = acma::input::decode_recording(bytes);
+    if(!decoded.has_value() || decoded->size() != records.size()) return false;
+    for(std::size_t i = 0; i < records.size(); ++i) {
+        acma::input::event_record const& a = records[i];
+        acma::input::event_record const& b = (*decoded)[i];
+        if(a.time_us != b.time_us || a.code != b.code || a.action != b.action || a.has_aux != b.has_aux) return false;
+        if(a.has_aux && (std::bit_cast<std::uint64_t>(a.aux.x()) != std::bit_cast<std::uint64_t>(b.aux.x()) || std::bit_cast<std::uint64_t>(a.aux.y()) != std::bit_cast<std::uint64_t>(b.aux.y()))) return false;
+    }
+
+    //A key press takes 3 bytes after the header when its delta fits in a byte
+    const acma::input::event_record press{{}, 5, acma::input::key_code::kb_a, acma::input::input_action::press, false};
+    if(acma::input::encode_recording(std::span{&press, 1}).size() != acma::input::recording_format::header_size + 3) return false;
+    if(!acma::input::decode_recording(acma::input::encode_recording({})).has_value()) return false;
+
+    //Every truncation fails cleanly
+    for(std::size_t size = 0; size < bytes.size(); size += 1 + size / 16)
+        if(acma::input::decode_recording(std::span{bytes.data(), size}).has_value()) return false;
+    std::vector<std::byte> corrupt = bytes;
+    corrupt[0] = std::byte{'X'};
+    if(acma::input::decode_recording(corrupt).has_value()) return false;
+    corrupt = bytes;
+    corrupt[8] = std::byte{0x7f};
+    if(acma::input::decode_recording(corrupt).has_value()) return false;
+    //A count far past what the bytes can hold
+    corrupt = bytes;
+    corrupt[15] = std::byte{0x7f};
+    if(acma::input::decode_recording(corrupt).has_value()) return false;
+    //An action past end_frame
+    corrupt = acma::input::encode_recording(std::span{&press, 1});
+    corrupt.back() = std::byte{acma::input::input_action::end_frame + 1};
+    return !acma::input::decode_recording(corrupt).has_value();
+}
+
+
+namespace {
+    int last_called = 0;
+    void set_last_called(void*, acma::input::combination, bool, acma::input::categorized_event_t event, acma::input::mouse_aux_t, void*) {
+        last_called = event.event_id;
+    }
+
+    //Calls the event's function (if any) and returns what it set last_called to, or -1
+    int dispatch(acma::input::event_fns_map const& map, acma::input::categorized_event_t event) {
+        last_called = -1;
+        if(acma::input::event_function_ref fn = map.find(event)) fn(nullptr, acma::input::combination{}, true, event, std::nullopt, nullptr);
+        return last_called;
+    }
+}
+
+//event_fns_map: function pointers, captureless lambdas and stateful functions, in the dense rows and the sparse map alike, with the
+//arguments passed through and owned functions destroyed once replaced, erased or cleared
+bool event_fns_map_dispatches() {
+    using namespace acma::input;
+    //The last 3 are outside of the dense rows
+    const std::array<categorized_event_t, 6> events = {{{0, 0}, {17, 3}, {static_cast<event_id_t>(dense_event_ids - 1), max_category_id},
+        {static_cast<event_id_t>(dense_event_ids), 1}, {-5, 2}, {1000, 0}}};
+    const std::shared_ptr<int> state = std::make_shared<int>(0);
+
+    event_fns_map map;
+    for(std::size_t i = 0; i < events.size(); ++i) {
+        switch(i % 3) {
+        case 0: map.insert_or_assign(events[i], set_last_called); break;
+        case 1: map.insert_or_assign(events[i], [](void*, combination, bool, categorized_event_t e, mouse_aux_t, void*) { last_called = e.event_id; }); break;
+        case 2: map.insert_or_assign(events[i], [state](void*, combination, bool pressed, categorized_event_t e, mouse_aux_t aux, void* user_ptr) {
+            last_called = e.event_id + *state + (pressed && !aux && !user_ptr ? 0 : 1000);
+        }); break;
+        }
+    }
+    if(map.size() != events.size() || state.use_count() != 3) return false;
+    for(categorized_event_t e : events)
+        if(dispatch(map, e) != e.event_id) return false;
+    if(map.contains({1, 0}) || map.contains({static_cast<event_id_t>(dense_event_ids) + 1, 1}) || dispatch(map, {3, 3}) != -1) return false;
+
+    //try_emplace keeps the existing function, insert_or_assign replaces (and destroys) it
+    if(map.try_emplace(events[2], set_last_called) || !map.try_emplace(categorized_event_t{2, 0}, set_last_called) || map.size() != events.size() + 1) return false;
+    *state = 1;
+    if(dispatch(map, events[2]) != events[2].event_id + 1) return false;
+    map.insert_or_assign(events[2], set_last_called);
+    if(state.use_count() != 2 || dispatch(map, events[2]) != events[2].event_id) return false;
+
+    //An empty std::function or null function pointer only erases
+    map.insert_or_assign(events[0], std::function<generic_event_function>{});
+    map.insert_or_assign(events[1], static_cast<generic_event_function*>(nullptr));
+    if(map.contains(events[0]) || map.contains(events[1]) || map.size() != events.size() - 1) return false;
+    map.insert_or_assign(events[1], std::function<generic_event_function>(set_last_called));
+    if(dispatch(map, events[1]) != events[1].event_id) return false;
+
+    //Moving the map keeps the references to its owned functions valid
+    event_fns_map moved = std::move(map);
+    if(dispatch(moved, events[5]) != events[5].event_id + 1 || moved.erase(events[5]) != 1 || moved.erase(events[5]) != 0 || state.use_count() != 1) return false;
+    moved.try_emplace(events[5], [state](void*, combination, bool, categorized_event_t, mouse_aux_t, void*) { last_called = *state; });
+    moved.clear();
+    return moved.empty() && state.use_count() == 1 && dispatch(moved, events[1]) == -1;
+}
+
+
+//input_state: what a frame's snapshot holds (taps shorter than a frame, held keys carried over, cursor and scroll deltas, text),
+//then a drain and a text writer racing the swaps without any input going missing between frames
+bool input_state_swaps() {
+    using namespace acma::input;
+    const auto key = [](code_t code, std::uint8_t action) { return event_record{{}, 0, code, action, false}; };
+    const auto pointer = [](code_t code, double x, double y) { return event_record{{x, y}, 0, code, input_action::press_release, true}; };
+
+    input_state state;
+    state.record(key(key_code::kb_a, input_action::press));
+    state.record(key(key_code::kb_b, input_action::press));
+    state.record(key(key_code::kb_b, input_action::release));
+    state.record(pointer(mouse_code::move, 10, 10));
+    state.record(pointer(mouse_code::move, 13, 14));
+    state.record(pointer(mouse_code::scroll, 0, 1));
+    state.record(pointer(mouse_code::scroll, 0, 2));
+    state.record_text('h');
+    state.record_text('i');
+    state.record(key(key_code::none, input_action::end_frame));
+    input_snapshot const& first = state.swap();
+    if(!first.is_held(key_code::kb_a) || !first.was_pressed(key_code::kb_a) || first.was_released(key_code::kb_a)) return false;
+    if(first.is_held(key_code::kb_b) || !first.was_pressed(key_code::kb_b) || !first.was_released(key_code::kb_b)) return false;
+    //The first move has nothing to measure from
+    if(first.cursor != acma::pt2d{13, 14} || first.cursor_delta != acma::vec2<double>{3, 4} || first.scroll != acma::vec2<double>{0, 3}) return false;
+    if(first.text != std::vector<unsigned int>{'h', 'i'} || &first != &state.snapshot()) return false;
+
+    //A frame without input keeps what's held and where the cursor is, and nothing else
+    input_snapshot const& idle = state.swap();
+    if(!idle.is_held(key_code::kb_a) || idle.was_pressed(key_code::kb_a) || idle.cursor != acma::pt2d{13, 14}) return false;
+    if(idle.cursor_delta != acma::vec2<double>{} || idle.scroll != acma::vec2<double>{} || !idle.text.empty()) return false;
+    state.record(key(key_code::kb_a, input_action::release));
+    state.record(pointer(mouse_code::button_1, 0, 0));
+    input_snapshot const& released = state.swap();
+    if(released.is_held(key_code::kb_a) || !released.was_released(key_code::kb_a)) return false;
+    if(!released.was_pressed(mouse_code::button_1) || !released.was_released(mouse_code::button_1) || released.is_held(mouse_code::button_1)) return false;
+
+    //Every move covers (1, 0), every scroll (0, 1) and every character is counted, so the frames have to add up to everything recorded
+    constexpr std::size_t events = 100000;
+    std::atomic<bool> done = false;
+    std::thread drain([&]() {
+        for(std::size_t i = 1; i <= events; ++i) {
+            state.record(pointer(mouse_code::move, 13 + static_cast<double>(i), 14));
+            state.record(pointer(mouse_code::scroll, 0, 1));
+            state.record(key(key_code::kb_c, i % 2 ? input_action::press : input_action::release));
+        }
+        done.store(true);
+    });
+    std::thread text([&]() {
+        for(std::size_t i = 0; i < events; ++i) state.record_text(static_cast<unsigned int>(i));
+    });
+    acma::vec2<double> moved{}, scrolled{};
+    std::size_t typed = 0;
+    bool in_order = true;
+    for(bool last = false; !last;) {
+        last = done.load();
+        if(last) text.join();
+        input_snapshot const& frame = state.swap();
+        moved += frame.cursor_delta;
+        scrolled += frame.scroll;
+        for(unsigned int c : frame.text) in_order &= c == typed++;
+    }
+    drain.join();
+    input_snapshot const& end = state.snapshot();
+    return in_order && typed == events && moved == acma::vec2<double>{events, 0} && scrolled == acma::vec2<double>{0, events}
+        && end.cursor == acma::pt2d{13 + events, 14} && !end.is_held(key_code::kb_c);
+}
+
+
+//late_latch_state: only cursor moves and the 8 mouse buttons are latched, and a reader racing the writer always sees both
+//coordinates of the same move
+bool late_latch_tracks_pointer() {
+    using namespace acma::input;
+    const auto button = [](code_t code, std::uint8_t action) { return event_record{{}, 0, code, action, false}; };
+    const auto move = [](double x, double y) { return event_record{{x, y}, 0, mouse_code::move, input_action::press_release, true}; };
+
+    late_latch_state latch;
+    if(latch.load().cursor != acma::pt2f{0, 0} || latch.load().buttons != 0) return false;
+    latch.record(move(12.5, -3));
+    latch.record(button(mouse_code::button_1, input_action::press));
+    latch.record(button(mouse_code::button_8, input_action::press));
+    latch.record(button(mouse_code::button_3, input_action::press_release));
+    latch.record(button(key_code::kb_a, input_action::press));
+    latch.record(event_record{{100, 100}, 0, mouse_code::scroll, input_action::press_release, true});
+    latch.record(button(key_code::none, input_action::end_frame));
+    late_latch_data data = latch.load();
+    if(data.cursor != acma::pt2f{12.5f, -3.f} || data.buttons != 0b1000'0001u) return false;
+    latch.record(button(mouse_code::button_1, input_action::release));
+    //Windows stay movable, so copies take a snapshot
+    const late_latch_state copy = latch;
+    if(copy.load().buttons != 0b1000'0000u || copy.load().cursor != acma::pt2f{12.5f, -3.f}) return false;
+
+    //The reader checks x == -y from its first load, so the latch has to satisfy it before the reader starts
+    latch.record(move(0, 0));
+    std::atomic<bool> done = false;
+    bool consistent = true;
+    std::thread reader([&]() {
+        while(!done.load(std::memory_order_relaxed)) {
+            data = latch.load();
+            consistent &= data.cursor.x() == -data.cursor.y();
+        }
+    });
+    for(int i = 0; i < 200000; ++i) latch.record(move(i, -i));
+    done.store(true);
+    reader.join();
+    return consistent && latch.load().cursor == acma::pt2f{199999.f, -199999.f};
+}
+
+
+int main() {
+    if(!binding_map_matches_std_map()) return 1;
+    if(!event_queue_orders_and_bounds()) return 1;
+    if(!event_queue_multi_producer()) return 1;
+    if(!coalescer_merge_rules()) return 1;
+    if(!combination_state_is_never_torn()) return 1;
+    if(!recording_round_trips()) return 1;
+    if(!event_fns_map_dispatches()) return 1;
+    if(!input_state_swaps()) return 1;
+    if(!late_latch_tracks_pointer()) return 1;
+    return 0;
+}
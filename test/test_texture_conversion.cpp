@@ -0,0 +1,56 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include <sirius/graphics/core/color_conversion.hpp>
+#include <sirius/graphics/core/texture_conversion.hpp>
+
+
+int main(){
+    //test color conversion kernels
+    std::array<acma::true_color, 256> colors;
+    for(std::size_t i = 0; i < colors.size(); ++i)
+        colors[i] = acma::true_color{std::array<std::uint8_t, 4>{static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(255 - i), static_cast<std::uint8_t>(i * 7), static_cast<std::uint8_t>(i)}};
+    std::array<float, 4 * colors.size()> linear_colors;
+    std::array<std::uint8_t, 4 * colors.size()> srgb_colors;
+    acma::srgb_to_linear<4>(std::span<std::uint8_t const>{colors[0].data(), srgb_colors.size()}, linear_colors);
+    acma::linear_to_srgb<4>(std::span<float const>{linear_colors}, srgb_colors);
+    if(std::memcmp(srgb_colors.data(), colors.data(), srgb_colors.size()) != 0) return 1;
+    std::array<float, 4 * colors.size()> normalized_colors;
+    acma::normalize(std::span<acma::true_color const>{colors}, normalized_colors);
+    for(std::size_t i = 0; i < colors.size(); ++i)
+        if(normalized_colors[4 * i + 1] != colors[i].normalize()[1]) return 1;
+    std::array<acma::true_color, 256> premultiplied = colors;
+    acma::premultiply_alpha(std::span<acma::true_color>{premultiplied});
+    for(std::size_t i = 0; i < colors.size(); ++i)
+        if(premultiplied[i][0] != (colors[i][0] * colors[i][3] + 127) / 255 || premultiplied[i][3] != colors[i][3]) return 1;
+
+    //Linear 8-bit values survive a round trip through sRGB to within one level (sRGB has less precision in the lights), both through a
+    //texture_view copy and in place
+    acma::texture linear_texture{};
+    linear_texture.format_id = VK_FORMAT_R8G8B8A8_UNORM;
+    linear_texture.bytes.resize(4 * colors.size());
+    std::memcpy(linear_texture.bytes.data(), colors.data(), linear_texture.bytes.size());
+    std::vector<sl::byte> converted_bytes(linear_texture.bytes.size());
+    const acma::result<acma::texture_view> srgb_view = acma::convert_to_srgb(linear_texture, converted_bytes);
+    if(!srgb_view.has_value() || srgb_view->format_id != VK_FORMAT_R8G8B8A8_SRGB || srgb_view->bytes.data() != converted_bytes.data()) return 1;
+    if(std::memcmp(linear_texture.bytes.data(), colors.data(), linear_texture.bytes.size()) != 0) return 1;
+    const acma::result<VkFormat> round_trip_format = acma::convert_to_linear(srgb_view->format_id, converted_bytes);
+    if(!round_trip_format.has_value() || *round_trip_format != VK_FORMAT_R8G8B8A8_UNORM) return 1;
+    for(std::size_t i = 0; i < converted_bytes.size(); ++i) {
+        const int diff = static_cast<int>(converted_bytes[i]) - static_cast<int>(linear_texture.bytes[i]);
+        if(diff < -1 || diff > 1 || (i % 4 == 3 && diff != 0)) return 1;
+    }
+    if(!acma::convert_to_srgb(linear_texture).has_value() || !acma::convert_to_linear(linear_texture).has_value()) return 1;
+    if(linear_texture.format_id != VK_FORMAT_R8G8B8A8_UNORM || linear_texture.bytes != converted_bytes) return 1;
+    //Only formats in the right color space can be converted, and the destination must fit the whole texture
+    if(acma::convert_to_linear(linear_texture).has_value() || acma::convert_to_srgb(VK_FORMAT_R32G32B32A32_SFLOAT, converted_bytes).has_value()) return 1;
+    if(acma::premultiply_alpha(linear_texture, std::span{converted_bytes}.first(4)).has_value()) return 1;
+
+
+
+    return 0;
+}
\ No newline at end of file
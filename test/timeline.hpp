@@ -11,6 +11,7 @@
 #include "sirius/timeline/draw.hpp"
 #include "sirius/timeline/buffer_dependency.hpp"
 
+#include "./generate_glyphs.hpp"
 #include "./generate_rects.hpp"
 #include "./styled_rect.hpp"
 #include "./texture_rect.hpp"
@@ -80,6 +81,15 @@ namespace acma::test {
 
 }
 
+namespace acma::test {
+	//Headless, for tests that only generate glyphs
+	using glyph_timeline = sl::tuple<
+		acma::initialize<acma::command_family::compute>,
+		acma::dispatch<acma::test::generate_glyphs>,
+		acma::submit<acma::command_family::compute>
+	>;
+}
+
 /*
 namespace acma::test {
 	using intermediate_timeline = sl::tuple<